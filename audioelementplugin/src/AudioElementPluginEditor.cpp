@@ -77,6 +77,7 @@ AudioElementPluginEditor::AudioElementPluginEditor(
           &p.getRepositories().audioElementSpatialLayoutRepository_),
       syncClient_(&p.getSyncClient()),
       spkrData_(&p.getRepositories().monitorData_),
+      spkrDataConsumer_(spkrData_->consumers),
       trackNameTextBox_("Track Name"),
       outputModeTypeLabel_("Output Mode"),
       audioElementSelectionBox_("Audio Element"),
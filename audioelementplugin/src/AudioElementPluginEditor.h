@@ -97,6 +97,8 @@ class AudioElementPluginEditor final : public juce::AudioProcessorEditor,
   AudioElementSpatialLayoutRepository* audioElementSpatialLayoutRepository_;
   AudioElementPluginSyncClient* syncClient_;
   SpeakerMonitorData* spkrData_;
+  // Keeps the track meters measuring while the editor is open.
+  MeteringConsumers::Registration spkrDataConsumer_;
 
   PositionSelectionScreen positionSelectionScreen_;
   RoomViewScreen roomViewScreen_;
@@ -63,10 +63,17 @@ AudioElementPluginProcessor::AudioElementPluginProcessor()
       this, &audioElementSpatialLayoutRepository_,
       &automationParametersTreeState));
   audioProcessors_.push_back(std::make_unique<MSProcessor>(msRespository_));
+  auto meteringProcessor = std::make_unique<MeteringProcessor>(
+      trackMeter_, audioElementSpatialLayoutRepository_.get()
+                       .getChannelLayout()
+                       .getNumChannels());
+  meteringProcessor_ = meteringProcessor.get();
+  audioProcessors_.push_back(std::move(meteringProcessor));
   audioProcessors_.push_back(std::make_unique<TrackMonitorProcessor>(
-      monitorData_, &audioElementSpatialLayoutRepository_));
+      monitorData_, &audioElementSpatialLayoutRepository_, &trackMeter_));
   audioProcessors_.push_back(std::make_unique<AudioElementPluginDataPublisher>(
-      &audioElementSpatialLayoutRepository_, &automationParametersTreeState));
+      &audioElementSpatialLayoutRepository_, &automationParametersTreeState,
+      &trackMeter_));
   audioProcessors_.push_back(std::make_unique<SoundFieldProcessor>(
       &audioElementSpatialLayoutRepository_, &syncClient_, &ambisonicsData_));
   audioProcessors_.push_back(std::make_unique<RoutingProcessor>(
@@ -216,6 +223,8 @@ void AudioElementPluginProcessor::setOutputChannels(int firstChannel,
   // Reconfigure the output channels for the panner
   firstOutputChannel = firstChannel;
   outputChannelCount = totalChannels;
+  // Only the audio element's own channels need metering
+  meteringProcessor_->setNumChannels(totalChannels);
 }
 
 void AudioElementPluginProcessor::processBlock(juce::AudioBuffer<float>& buffer,
@@ -104,6 +104,9 @@ class AudioElementPluginProcessor final : public ProcessorBase,
  private:
   juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
   std::vector<std::unique_ptr<ProcessorBase>> audioProcessors_;
+  // Levels measured once per block and shared by the metering consumers.
+  ChannelMeter trackMeter_;
+  MeteringProcessor* meteringProcessor_;
   ElevationListener elevationListener_;
 
   /*
@@ -26,6 +26,7 @@
 #include "src/TextEditorControlledDial.cpp"
 #include "src/ambisonics_visualizers/AmbisonicsVisualizer.cpp"
 #include "src/ambisonics_visualizers/ColourLegend.cpp"
+#include "src/loudness_meter/LoudnessHistoryGraph.cpp"
 #include "src/loudness_meter/LoudnessLevelBar.cpp"
 #include "src/loudness_meter/LoudnessMeter.cpp"
 #include "src/loudness_meter/LoudnessScale.cpp"
@@ -48,6 +48,7 @@ END_JUCE_MODULE_DECLARATION
 #include "src/SliderLabelAttachment.h"
 #include "src/TimeFormatSegmentSelector.h"
 #include "src/ambisonics_visualizers/VisualizerPair.h"
+#include "src/loudness_meter/LoudnessHistoryGraph.h"
 #include "src/loudness_meter/LoudnessMeter.h"
 #include "src/loudness_meter/LoudnessScale.h"
 #include "src/loudness_meter/LoudnessStats.h"
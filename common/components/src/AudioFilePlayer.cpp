@@ -276,7 +276,23 @@ void AudioFilePlayer::valueTreePropertyChanged(
       juce::MessageManager::callAsync(
           [safeThis]() { safeThis->attemptCreatePlaybackEngine(); });
     } else {
-      cancelCreatePlaybackEngine();
+      // Exports start on the host's thread, but the engine's audio device
+      // must be torn down on the message thread. The engine streams the file,
+      // so the export may begin writing before it is released.
+      auto safeThis = juce::Component::SafePointer<AudioFilePlayer>(this);
+      juce::MessageManager::callAsync([safeThis]() {
+        if (safeThis == nullptr) {
+          return;
+        }
+        safeThis->cancelCreatePlaybackEngine();
+        {
+          std::lock_guard<std::mutex> lock(safeThis->pbeMutex_);
+          safeThis->playbackEngine_ = nullptr;
+        }
+        auto fpb = safeThis->fpbr_.get();
+        fpb.setPlayState(FilePlayback::kStop);
+        safeThis->fpbr_.update(fpb);
+      });
     }
   }
 }
@@ -37,7 +37,7 @@ AmbisonicsVisualizer::AmbisonicsVisualizer(AmbisonicsData* ambisonicsData,
 
 AmbisonicsVisualizer::~AmbisonicsVisualizer() { setLookAndFeel(nullptr); }
 
-void AmbisonicsVisualizer::paint(juce::Graphics& g) {
+void AmbisonicsVisualizer::resized() {
   auto bounds = getLocalBounds();
 
   // create a copy for reference later
@@ -46,10 +46,8 @@ void AmbisonicsVisualizer::paint(juce::Graphics& g) {
   // alocate the bottom 10% for the label
   auto labelBounds =
       bounds.removeFromBottom(visualizerBounds.proportionOfHeight(0.1f));
-  // labelBounds.reduce(visualizerBounds.proportionOfWidth(0.1f), 0);
   label_.setBounds(labelBounds);
 
-  const auto topComponentsBounds = bounds;
   // create some space for the carat image
   bounds.reduce(10, 10);
   // ensure there is an aspect ratio 1:1
@@ -58,14 +56,20 @@ void AmbisonicsVisualizer::paint(juce::Graphics& g) {
   bounds.translate(label_.getBounds().getCentreX() - bounds.getCentreX(), 0);
   circleBounds_ = bounds;
 
+  // the carat transform and tesselation depend on the circle bounds
+  caratTransform_ = juce::AffineTransform();
+  tesselateCircle(circleBounds_);
+  updateColours(true);
+}
+
+void AmbisonicsVisualizer::paint(juce::Graphics& g) {
+  auto bounds = circleBounds_;
+
   g.setColour(EclipsaColours::ambisonicsFillGrey);
   g.fillEllipse(bounds.toFloat());
 
-  if (visualizerElements_.isEmpty()) {
-    tesselateCircle(g, bounds);
-  } else {
-    repaintTesselatedCircle(g);
-  }
+  // the coloured field is pre-rendered whenever the loudnesses change
+  g.drawImageAt(fieldImage_, bounds.getX(), bounds.getY());
 
   if (view_ != VisualizerView::kFront && view_ != VisualizerView::kRear) {
     if (caratTransform_.isIdentity()) {
@@ -204,178 +208,144 @@ AmbisonicsVisualizer::getSpeakerPositions(AmbisonicsData* ambisonicsData) {
   return speakerPositions;
 }
 
-void AmbisonicsVisualizer::tesselateCircle(juce::Graphics& g,
-                                           const juce::Rectangle<int>& bounds) {
-  std::vector<float> loudnessValues(ambisonicsData_->speakerElevations.size());
-  const bool valuesReturned =
-      ambisonicsData_->speakerLoudnesses.read(loudnessValues);
-  int colorIndex = 0;
-  const int radius = bounds.getWidth() / 2;
-  const int centreX = bounds.getCentreX();
-  const int centreY = bounds.getCentreY();
+void AmbisonicsVisualizer::tesselateCircle(const juce::Rectangle<int>& bounds) {
+  visualizerElements_.clear();
+  rings_.clear();
+  const int diameter = bounds.getWidth();
+  if (diameter <= 0) {
+    fieldImage_ = juce::Image();
+    elementPerPixel_.clear();
+    return;
+  }
+
+  const float radius = diameter / 2;
   const int numPoints = 20;
-  Eigen::VectorXf thetas = Eigen::VectorXf::LinSpaced(
-      numPoints, 0, 2 * juce::MathConstants<float>::pi);
-  const Eigen::VectorXf radii =
-      Eigen::VectorXf::LinSpaced(numPoints, 0, radius);
-
-  // create pie segments for the first two radii
-  const float pieSegmentRadius = radii[1];
-  const float avg_radius =
-      (pieSegmentRadius / 2) / radius;  // ensure the value is normalized
-  // keep an element index to access memoized elements
-  int elementIndex = 0;
+  const float ringWidth = radius / (numPoints - 1);
+
+  // the centre of the circle is split into pie segments
+  int thetaCount = numPoints;
+  rings_.push_back({numPoints - 1, 0});
   for (int j = 1; j < numPoints; j++) {  // iterate through the thetas
-    juce::Path tesselatedPatch;
-    const float theta = thetas[j];
-    const float thetaPrev = thetas[j - 1];
-    juce::Point<float> arcStart{
-        centreX + pieSegmentRadius * std::sin(thetaPrev),
-        centreY - pieSegmentRadius * std::cos(thetaPrev)};
-    tesselatedPatch.startNewSubPath(centreX, centreY);
-    juce::Point<int> pointA = tesselatedPatch.getCurrentPosition().toInt();
-    tesselatedPatch.lineTo(arcStart);
-    juce::Point<int> pointB = tesselatedPatch.getCurrentPosition().toInt();
-    tesselatedPatch.addCentredArc(centreX, centreY, pieSegmentRadius,
-                                  pieSegmentRadius, 0, thetaPrev, theta);
-    juce::Point<int> pointC = tesselatedPatch.getCurrentPosition().toInt();
-    tesselatedPatch.lineTo(centreX, centreY);
-    juce::Point<int> pointD = tesselatedPatch.getCurrentPosition().toInt();
-    tesselatedPatch.closeSubPath();
-
-    // add r & theta to the 3D points
-    const float avg_theta = (theta + thetaPrev) / 2;
-    // write to the Visualizer Elements
-    writeVisualizerElements(tesselatedPatch,
-                            CartesianPoint3D(avg_radius, avg_theta, view_));
-    if (valuesReturned) {
-      float loudness =
-          gaussianFilter(*visualizerElements_.getLast(), loudnessValues);
-      juce::Colour colour = ColourLegend::assignColour(loudness);
-
-      visualizerElements_.getLast()->prevColour_ = colour;
-    }
-    g.setColour(visualizerElements_.getLast()->prevColour_);
-    g.fillPath(tesselatedPatch);
-    g.strokePath(tesselatedPatch, juce::PathStrokeType(1.f));
+    const float avg_theta = (j - 0.5f) * juce::MathConstants<float>::twoPi /
+                            (numPoints - 1);
+    // ensure the radius is normalized
+    const float avg_radius = (ringWidth / 2) / radius;
+    writeVisualizerElements(CartesianPoint3D(avg_radius, avg_theta, view_));
   }
 
   // create the rest of the circle
-  int thetaCount = numPoints;            // store the previous theta count
   for (int i = 2; i < numPoints; i++) {  // iterate through the radii
-    const float outerRadius = radii[i];
-    const float innerRadius = radii[i - 1];
-    const float avg_radius = ((outerRadius + innerRadius) / 2) /
-                             radius;  // ensure radius is normalized
+    const float avg_radius =
+        (i - 0.5f) * ringWidth / radius;  // ensure radius is normalized
     // try to preserve radial resolution
     // scale the number of thetas based on the ratio of the radii
-    const int newThetaCount =
-        std::ceil(thetaCount * outerRadius /
-                  innerRadius);  // round up to the next integer
-    thetaCount = newThetaCount;  // store the previous theta count
-    thetas = Eigen::VectorXf::LinSpaced(newThetaCount, 0,
-                                        2 * juce::MathConstants<float>::pi);
-    for (int j = 1; j < newThetaCount; j++) {  // iterate through the thetas
-      juce::Path tesselatedPatch;
-      // get the equivalent x and y coordinates of the starting point
-      // theta is 0 from the circles top centre
-      juce::Point<float> innerArcStart = {
-          centreX + innerRadius * std::sin(thetas[j - 1]),
-          centreY - innerRadius * std::cos(thetas[j - 1])};
-
-      tesselatedPatch.startNewSubPath(innerArcStart);
-
-      // inner arc is drawn clockwise
-      tesselatedPatch.addCentredArc(centreX, centreY, innerRadius, innerRadius,
-                                    0, thetas[j - 1], thetas[j], true);
-
-      juce::Point<float> innerArcEnd = tesselatedPatch.getCurrentPosition();
-      // theta is 0 from the circles top centre
-      juce::Point<float> outterArcStart = {
-          centreX + outerRadius * std::sin(thetas[j]),
-          centreY - outerRadius * std::cos(thetas[j])};
-
-      tesselatedPatch.lineTo(outterArcStart);
-      //  outer arc is drawn counter clockwise
-      tesselatedPatch.addCentredArc(centreX, centreY, outerRadius, outerRadius,
-                                    0, thetas[j], thetas[j - 1]);
-
-      juce::Point<float> outerArcEnd = tesselatedPatch.getCurrentPosition();
-
-      tesselatedPatch.lineTo(innerArcStart);
-      tesselatedPatch.closeSubPath();
-
-      const float avg_theta = (thetas[j] + thetas[j - 1]) / 2;
-      // write to the Visualizer Elements
-      writeVisualizerElements(tesselatedPatch,
-                              CartesianPoint3D(avg_radius, avg_theta, view_));
-      if (valuesReturned) {
-        float loudness =
-            gaussianFilter(*visualizerElements_.getLast(), loudnessValues);
-        juce::Colour colour = ColourLegend::assignColour(loudness);
-
-        visualizerElements_.getLast()->prevColour_ = colour;
+    thetaCount = std::ceil((double)thetaCount * i /
+                           (i - 1));  // round up to the next integer
+    rings_.push_back({thetaCount - 1, visualizerElements_.size()});
+    for (int j = 1; j < thetaCount; j++) {  // iterate through the thetas
+      const float avg_theta = (j - 0.5f) * juce::MathConstants<float>::twoPi /
+                              (thetaCount - 1);
+      writeVisualizerElements(CartesianPoint3D(avg_radius, avg_theta, view_));
+    }
+  }
+
+  // map every pixel of the circle to the patch covering it, so a frame is a
+  // single pass over the image
+  elementPerPixel_.assign(diameter * diameter, kNoElement);
+  for (int y = 0; y < diameter; y++) {
+    for (int x = 0; x < diameter; x++) {
+      const float dx = x + 0.5f - radius;
+      const float dy = y + 0.5f - radius;
+      const float r = std::sqrt(dx * dx + dy * dy);
+      if (r >= radius) {
+        continue;
+      }
+      // theta is 0 from the circles top centre, increasing clockwise
+      float theta = std::atan2(dx, -dy);
+      if (theta < 0.f) {
+        theta += juce::MathConstants<float>::twoPi;
       }
-      g.setColour(visualizerElements_.getLast()->prevColour_);
-      g.fillPath(tesselatedPatch);
-      g.strokePath(tesselatedPatch, juce::PathStrokeType(1.f));
+      const Ring& ring =
+          rings_[std::min((int)(r / ringWidth), (int)rings_.size() - 1)];
+      const int segment =
+          std::min((int)(theta * ring.numSegments /
+                         juce::MathConstants<float>::twoPi),
+                   ring.numSegments - 1);
+      elementPerPixel_[y * diameter + x] =
+          (uint16_t)(ring.firstElement + segment);
     }
   }
+  fieldImage_ = juce::Image(juce::Image::ARGB, diameter, diameter, true);
 }
 
-void AmbisonicsVisualizer::timerCallback() { repaint(); }
+void AmbisonicsVisualizer::timerCallback() {
+  if (updateColours(false)) {
+    repaint(circleBounds_);
+  }
+}
 
-void AmbisonicsVisualizer::repaintTesselatedCircle(juce::Graphics& g) {
-  std::vector<float> loudnessValues(ambisonicsData_->speakerElevations.size());
+bool AmbisonicsVisualizer::updateColours(const bool force) {
+  if (!fieldImage_.isValid()) {
+    return false;
+  }
+
+  loudnessValues_.resize(ambisonicsData_->speakerElevations.size());
   const bool readValues =
-      ambisonicsData_->speakerLoudnesses.read(loudnessValues);
-  // couldn't read the values
-  // repaint the previous colours
-  if (!readValues) {
-    for (auto& element : visualizerElements_) {
-      g.setColour(element->prevColour_);
-      g.fillPath(element->tesselationPatch_);
-      g.strokePath(element->tesselationPatch_, juce::PathStrokeType(1.f));
+      ambisonicsData_->speakerLoudnesses.read(loudnessValues_);
+  // nothing new to show
+  if (!force && (!readValues || loudnessValues_ == prevLoudnessValues_)) {
+    return false;
+  }
+  prevLoudnessValues_ = loudnessValues_;
+
+  bool changed = force;
+  elementPixels_.resize(visualizerElements_.size());
+  for (int i = 0; i < visualizerElements_.size(); i++) {
+    VisualizerElement& element = *visualizerElements_[i];
+    if (readValues) {
+      const juce::Colour colour = ColourLegend::assignColour(
+          gaussianFilter(element, loudnessValues_));
+      changed |= colour != element.prevColour_;
+      element.prevColour_ = colour;
     }
-  } else {      // able to update the loudness values, paint the new colours
-    int i = 0;  // track element index for debugging
-    for (auto& element : visualizerElements_) {
-      float loudness = gaussianFilter(*element, loudnessValues);
-      juce::Colour colour = ColourLegend::assignColour(loudness);
-      g.setColour(colour);
-      g.fillPath(element->tesselationPatch_);
-      g.strokePath(element->tesselationPatch_, juce::PathStrokeType(1.f));
-      element->prevColour_ = colour;
-      i++;
+    elementPixels_[i] = element.prevColour_.getPixelARGB();
+  }
+  if (!changed) {
+    return false;
+  }
+
+  juce::Image::BitmapData pixels(fieldImage_,
+                                 juce::Image::BitmapData::writeOnly);
+  const int diameter = fieldImage_.getWidth();
+  for (int y = 0; y < diameter; y++) {
+    const uint16_t* elements = elementPerPixel_.data() + y * diameter;
+    for (int x = 0; x < diameter; x++) {
+      if (elements[x] != kNoElement) {
+        *reinterpret_cast<juce::PixelARGB*>(pixels.getPixelPointer(x, y)) =
+            elementPixels_[elements[x]];
+      }
     }
   }
+  return true;
 }
 
 float AmbisonicsVisualizer::gaussianFilter(
     const VisualizerElement& element,
     const std::vector<float>& loudnessValues) {
   float numerator = 0.f;
-  float denominator = 0.f;
-  // create a local copy to iterate over
-  std::priority_queue<std::pair<float, int>> closestSpeakers =
-      element.closestSpeakers_;
-  int index = 0;
-  // closestSpeakers will always have a max size of kNearestSpeakers_
-  // element.gaussianFilterWeights_ will always have a size of kNearestSpeakers_
-  while (!closestSpeakers.empty() && index < kNearestSpeakers_) {
-    const auto speaker = closestSpeakers.top();
-    const float distance = speaker.first;
-    const float loudness = loudnessValues[speaker.second];
-    const float weight = element.gaussianFilterWeights_[index];
-    numerator += loudness * weight;
-    index++;
-    closestSpeakers.pop();
+  // speakerIndices_ and gaussianFilterWeights_ hold at most kNearestSpeakers_
+  // entries in the same order
+  for (int i = 0; i < element.speakerIndices_.size(); i++) {
+    const int speaker = element.speakerIndices_[i];
+    if (speaker < loudnessValues.size()) {
+      numerator += loudnessValues[speaker] * element.gaussianFilterWeights_[i];
+    }
   }
   return {numerator / element.denominator_};
 }
 
 void AmbisonicsVisualizer::writeVisualizerElements(
-    const juce::Path& path, const CartesianPoint3D& point) {
+    const CartesianPoint3D& point) {
   // calculate the distance from point i to point j, keeping the k nearest
   // speakers
   std::priority_queue<std::pair<float, int>> closestSpeakers;
@@ -390,7 +360,7 @@ void AmbisonicsVisualizer::writeVisualizerElements(
     }
   }
   visualizerElements_.add(
-      std::make_unique<VisualizerElement>(path, point, closestSpeakers));
+      std::make_unique<VisualizerElement>(point, closestSpeakers));
 }
 
 AmbisonicsVisualizer::CartesianPoint3D::CartesianPoint3D(const float& azimuth,
@@ -470,34 +440,18 @@ float AmbisonicsVisualizer::CartesianPoint3D::dotProduct(
 }
 
 AmbisonicsVisualizer::VisualizerElement::VisualizerElement(
-    const juce::Path& tesselatedPatch, const CartesianPoint3D& position,
-    const std::priority_queue<std::pair<float, int>>& closestSpeakers)
-    : tesselationPatch_(tesselatedPatch),
-      position_(position),
-      closestSpeakers_(closestSpeakers),
-      gaussianFilterWeights_(calculateWeights()),
-      denominator_(calculateDenominator()) {}
-
-std::vector<float> AmbisonicsVisualizer::VisualizerElement::calculateWeights() {
-  std::vector<float> weights;
-  std::priority_queue<std::pair<float, int>> speakerCopy =
-      closestSpeakers_;  // create a local copy to iterate over
-  // calculate the weights for the k nearest speakers
-  while (!speakerCopy.empty()) {
-    const auto speaker = speakerCopy.top();
+    const CartesianPoint3D& position,
+    std::priority_queue<std::pair<float, int>> closestSpeakers)
+    : position_(position) {
+  // unpack the k nearest speakers and their gaussian weights
+  while (!closestSpeakers.empty()) {
+    const auto speaker = closestSpeakers.top();
     const float distance = speaker.first;
     const float weight =
         std::exp(-1.f * std::pow(distance, 2) / twoSigmaSquared_);
-    weights.push_back(weight);
-    speakerCopy.pop();
-  }
-  return weights;
-}
-
-float AmbisonicsVisualizer::VisualizerElement::calculateDenominator() {
-  float denominator = 0.f;
-  for (auto& weight : gaussianFilterWeights_) {
-    denominator += weight;
+    speakerIndices_.push_back(speaker.second);
+    gaussianFilterWeights_.push_back(weight);
+    denominator_ += weight;
+    closestSpeakers.pop();
   }
-  return denominator;
 }
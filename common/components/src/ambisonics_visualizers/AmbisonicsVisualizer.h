@@ -72,22 +72,19 @@ class AmbisonicsVisualizer : public juce::Component, public juce::Timer {
                             const CartesianPoint3D& vec2);
   };
 
+  // one tesselated patch of the circle and the speakers that colour it
   struct VisualizerElement {
     VisualizerElement(
-        const juce::Path& tesselatedPatch, const CartesianPoint3D& position,
-        const std::priority_queue<std::pair<float, int>>& closestSpeakers);
+        const CartesianPoint3D& position,
+        std::priority_queue<std::pair<float, int>> closestSpeakers);
 
-    const juce::Path tesselationPatch_;
     const CartesianPoint3D position_;
-    const std::priority_queue<std::pair<float, int>> closestSpeakers_;
     const float twoSigmaSquared_ = 2.f * 0.25f * 0.25f;  // sigma = 0.25
-    const std::vector<float> gaussianFilterWeights_;
-    const float denominator_;
+    // nearest speakers first, with their gaussian weights
+    std::vector<int> speakerIndices_;
+    std::vector<float> gaussianFilterWeights_;
+    float denominator_ = 0.f;
     juce::Colour prevColour_ = EclipsaColours::inactiveGrey;
-
-   private:
-    std::vector<float> calculateWeights();
-    float calculateDenominator();
   };
 
   AmbisonicsVisualizer(AmbisonicsData* ambisonicsData,
@@ -97,6 +94,8 @@ class AmbisonicsVisualizer : public juce::Component, public juce::Timer {
 
   void paint(juce::Graphics& g) override;
 
+  void resized() override;
+
   juce::Point<int> upperCirclePoint() const {
     return juce::Point<int>(circleBounds_.getCentreX(), circleBounds_.getY());
   }
@@ -122,10 +121,12 @@ class AmbisonicsVisualizer : public juce::Component, public juce::Timer {
   float getCaratRotation(const VisualizerView& view);
   juce::String getViewText(const VisualizerView& view);
 
-  void writeVisualizerElements(const juce::Path& path,
-                               const CartesianPoint3D& point);
-  void tesselateCircle(juce::Graphics& g, const juce::Rectangle<int>& bounds);
-  void repaintTesselatedCircle(juce::Graphics& g);
+  void writeVisualizerElements(const CartesianPoint3D& point);
+  // build the patches and the pixel to patch map for the circle bounds
+  void tesselateCircle(const juce::Rectangle<int>& bounds);
+  // recolour the cached field image from the latest loudnesses
+  // returns true if the image changed
+  bool updateColours(const bool force);
 
   // returns loudness, using a gaussian filter to smooth the values across the
   // kNearestSpeakers_
@@ -148,4 +149,18 @@ class AmbisonicsVisualizer : public juce::Component, public juce::Timer {
   juce::Image image_;                  // image holds the carat image
   juce::Point<int> caratPointOffset_;  // carat point
   juce::Rectangle<int> circleBounds_;  // circle bounds
+
+  // a ring of equally sized patches, stored consecutively in
+  // visualizerElements_
+  struct Ring {
+    int numSegments;
+    int firstElement;
+  };
+  static constexpr uint16_t kNoElement = 0xFFFF;
+  std::vector<Ring> rings_;
+  std::vector<uint16_t> elementPerPixel_;  // patch index per image pixel
+  std::vector<juce::PixelARGB> elementPixels_;  // current patch colours
+  juce::Image fieldImage_;  // coloured patches, redrawn on change only
+  std::vector<float> loudnessValues_;
+  std::vector<float> prevLoudnessValues_;
 };
\ No newline at end of file
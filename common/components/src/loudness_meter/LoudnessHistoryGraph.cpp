@@ -0,0 +1,135 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LoudnessHistoryGraph.h"
+
+#include <cmath>
+
+#include "components/src/EclipsaColours.h"
+
+LoudnessHistoryGraph::LoudnessHistoryGraph(const LoudnessTimeline& timeline)
+    : timeline_(timeline) {
+  // The timeline gains a point every 100 ms.
+  startTimerHz(4);
+}
+
+float LoudnessHistoryGraph::toY(const float loudness,
+                                const juce::Rectangle<float>& bounds) const {
+  return juce::jmap(juce::jlimit(kMinLoudness_, kMaxLoudness_, loudness),
+                    kMinLoudness_, kMaxLoudness_, bounds.getBottom(),
+                    bounds.getY());
+}
+
+void LoudnessHistoryGraph::paint(juce::Graphics& g) {
+  const juce::Rectangle<float> bounds = getLocalBounds().toFloat();
+  g.setColour(EclipsaColours::backgroundOffBlack);
+  g.fillRect(bounds);
+
+  g.setColour(EclipsaColours::gridLine);
+  for (float level = kMinLoudness_ + kGridStep_; level < kMaxLoudness_;
+       level += kGridStep_) {
+    g.drawHorizontalLine((int)toY(level, bounds), bounds.getX(),
+                         bounds.getRight());
+  }
+
+  if (timeline_.isEmpty() || getWidth() <= 0) {
+    return;
+  }
+  const juce::Range<double> kView = getViewRange();
+  const std::vector<LoudnessTimeline::Summary> kSummaries =
+      timeline_.getSummaries(kView.getStart(), kView.getEnd(), getWidth());
+
+  juce::Path shortTerm, truePeak;
+  g.setColour(EclipsaColours::onButtonGrey);
+  for (int x = 0; x < (int)kSummaries.size(); ++x) {
+    const LoudnessTimeline::Summary& summary = kSummaries[x];
+    g.drawVerticalLine(x, toY(summary.momentary.max, bounds),
+                       toY(summary.momentary.min, bounds));
+    const float kShortTermY = toY(summary.shortTerm.mean, bounds);
+    const float kTruePeakY = toY(summary.truePeak.max, bounds);
+    if (x == 0) {
+      shortTerm.startNewSubPath((float)x, kShortTermY);
+      truePeak.startNewSubPath((float)x, kTruePeakY);
+    } else {
+      shortTerm.lineTo((float)x, kShortTermY);
+      truePeak.lineTo((float)x, kTruePeakY);
+    }
+  }
+  g.setColour(EclipsaColours::orange);
+  g.strokePath(truePeak, juce::PathStrokeType(1.f));
+  g.setColour(EclipsaColours::selectCyan);
+  g.strokePath(shortTerm, juce::PathStrokeType(1.5f));
+
+  // Readout of the shown range
+  const LoudnessTimeline::Summary kRange =
+      timeline_.getSummary(kView.getStart(), kView.getEnd());
+  g.setColour(EclipsaColours::tabTextGrey);
+  g.setFont(12.f);
+  g.drawText(juce::String(kRange.startSeconds, 1) + " - " +
+                 juce::String(kRange.endSeconds, 1) + " s   Max true peak " +
+                 juce::String(kRange.truePeak.max, 1) + " dBTP",
+             getLocalBounds().reduced(4), juce::Justification::topRight);
+}
+
+juce::Range<double> LoudnessHistoryGraph::getViewRange() const {
+  const double kDuration = timeline_.getDurationSeconds();
+  if (viewLength_ <= 0.0 || viewLength_ >= kDuration) {
+    return {0.0, kDuration};
+  }
+  const double kStart = juce::jlimit(0.0, kDuration - viewLength_, viewStart_);
+  return {kStart, kStart + viewLength_};
+}
+
+void LoudnessHistoryGraph::mouseWheelMove(
+    const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel) {
+  if (timeline_.isEmpty() || getWidth() <= 0 || wheel.deltaY == 0.f) {
+    return;
+  }
+  // Keep the time under the cursor where it is
+  const juce::Range<double> kView = getViewRange();
+  const double kProportion =
+      juce::jlimit(0.0, 1.0, event.x / (double)getWidth());
+  const double kAnchor = kView.getStart() + kProportion * kView.getLength();
+  const double kLength =
+      juce::jmax(kMinViewSeconds_,
+                 kView.getLength() * std::pow(0.5, wheel.deltaY * 4.0));
+  if (kLength >= timeline_.getDurationSeconds()) {
+    viewLength_ = 0.0;
+  } else {
+    viewLength_ = kLength;
+    viewStart_ = kAnchor - kProportion * kLength;
+  }
+  repaint();
+}
+
+void LoudnessHistoryGraph::mouseDown(const juce::MouseEvent& event) {
+  dragStart_ = getViewRange().getStart();
+}
+
+void LoudnessHistoryGraph::mouseDrag(const juce::MouseEvent& event) {
+  if (viewLength_ <= 0.0 || viewLength_ >= timeline_.getDurationSeconds() ||
+      getWidth() <= 0) {
+    return;
+  }
+  const double kSecondsPerPixel = viewLength_ / getWidth();
+  viewStart_ = juce::jlimit(
+      0.0, timeline_.getDurationSeconds() - viewLength_,
+      dragStart_ - event.getDistanceFromDragStartX() * kSecondsPerPixel);
+  repaint();
+}
+
+void LoudnessHistoryGraph::mouseDoubleClick(const juce::MouseEvent& event) {
+  viewLength_ = 0.0;
+  repaint();
+}
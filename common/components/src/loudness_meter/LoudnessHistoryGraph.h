@@ -0,0 +1,60 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <data_structures/src/LoudnessTimeline.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+// Loudness of the playback mix since the stats were last reset: the
+// short-term loudness and the true peak as lines over the range of the
+// momentary loudness. Each pixel column draws one summary of the timeline.
+//
+// The whole program is shown until the wheel zooms in around the cursor.
+// Dragging pans the zoomed range and a double click shows the whole program
+// again.
+class LoudnessHistoryGraph : public juce::Component, juce::Timer {
+ public:
+  explicit LoudnessHistoryGraph(const LoudnessTimeline& timeline);
+
+  void paint(juce::Graphics& g) override;
+
+  void mouseWheelMove(const juce::MouseEvent& event,
+                      const juce::MouseWheelDetails& wheel) override;
+  void mouseDown(const juce::MouseEvent& event) override;
+  void mouseDrag(const juce::MouseEvent& event) override;
+  void mouseDoubleClick(const juce::MouseEvent& event) override;
+
+  void timerCallback() override { repaint(); }
+
+ private:
+  float toY(const float loudness, const juce::Rectangle<float>& bounds) const;
+  // The shown range of the timeline, in seconds.
+  juce::Range<double> getViewRange() const;
+
+  const float kMinLoudness_ = -60.f;
+  const float kMaxLoudness_ = 0.f;
+  const float kGridStep_ = 10.f;
+  // Narrowest range zoomed to, 100 measurements.
+  const double kMinViewSeconds_ = 10.0;
+
+  // Zero while the whole program is shown.
+  double viewStart_ = 0.0;
+  double viewLength_ = 0.0;
+  double dragStart_ = 0.0;
+
+  // Drained on the message thread, which is also where it is drawn.
+  const LoudnessTimeline& timeline_;
+};
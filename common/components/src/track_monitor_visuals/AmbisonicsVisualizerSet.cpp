@@ -23,6 +23,7 @@ AmbisonicsVisualizerSet::AmbisonicsVisualizerSet(
       audioElementSpatialLayoutRepository_(
           &audioElementPluginRepo.audioElementSpatialLayoutRepository_),
       ambisonicsData_(audioElementPluginRepo.ambisonicsData_),
+      ambisonicsDataConsumer_(ambisonicsData_.consumers),
       pbLayout_(pbLayout) {
   ambisonicsLabel_.setText("Position", juce::dontSendNotification);
   ambisonicsLabel_.setFont(juce::Font(18.0f));
@@ -53,6 +53,7 @@ class AmbisonicsVisualizerSet : public juce::Component {
 
   AudioElementPluginRepositoryCollection& repos_;
   AmbisonicsData& ambisonicsData_;
+  MeteringConsumers::Registration ambisonicsDataConsumer_;
   AudioElementPluginSyncClient* syncClient_;
   AudioElementSpatialLayoutRepository* audioElementSpatialLayoutRepository_;
   ColourLegend colourLegend_;
@@ -16,14 +16,20 @@
 
 #include "src/ActiveMixPresentation.cpp"
 #include "src/AudioElement.cpp"
+#include "src/AudioElementPluginHub.cpp"
+#include "src/AudioElementSharedMemory.cpp"
 #include "src/AudioElementSpatialLayout.cpp"
+#include "src/AudioElementTelemetryTable.cpp"
+#include "src/AudioElementUpdateSlot.cpp"
 #include "src/ChannelGains.cpp"
 #include "src/FileExport.cpp"
 #include "src/FilePlayback.cpp"
 #include "src/LanguageCodeMetaData.cpp"
+#include "src/LoudnessTimeline.cpp"
 #include "src/MixPresentation.cpp"
 #include "src/MixPresentationLoudness.cpp"
 #include "src/MixPresentationSoloMute.cpp"
 #include "src/PlaybackMS.cpp"
+#include "src/RepositorySync.cpp"
 #include "src/RoomSetup.cpp"
 #include "src/TimeFormatConverter.cpp"
\ No newline at end of file
@@ -36,18 +36,25 @@ END_JUCE_MODULE_DECLARATION
 #include "src/AmbisonicsData.h"
 #include "src/AudioElement.h"
 #include "src/AudioElementCommunication.h"
+#include "src/AudioElementPluginHub.h"
+#include "src/AudioElementSharedMemory.h"
 #include "src/AudioElementSpatialLayout.h"
+#include "src/AudioElementTelemetryTable.h"
+#include "src/AudioElementUpdateSlot.h"
 #include "src/ChannelGains.h"
 #include "src/FileExport.h"
 #include "src/FilePlayback.h"
 #include "src/LanguageCodeMetaData.h"
 #include "src/LoudnessExportData.h"
+#include "src/LoudnessTimeline.h"
+#include "src/MeteringConsumers.h"
 #include "src/MixPresentation.h"
 #include "src/MixPresentationLoudness.h"
 #include "src/MixPresentationSoloMute.h"
 #include "src/ParameterMetaData.h"
 #include "src/PlaybackMS.h"
 #include "src/RepositoryItem.h"
+#include "src/RepositorySync.h"
 #include "src/RoomSetup.h"
 #include "src/SpeakerMonitorData.h"
 #include "src/TimeFormatConverter.h"
\ No newline at end of file
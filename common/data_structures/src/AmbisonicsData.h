@@ -15,10 +15,13 @@
  */
 
 #pragma once
+#include "MeteringConsumers.h"
 #include "RealtimeDataType.h"
 
 struct AmbisonicsData {
   RealtimeDataType<std::vector<float>> speakerLoudnesses;
   std::vector<float> speakerAzimuths;
   std::vector<float> speakerElevations;
+  // Visualizers showing the speaker loudnesses.
+  MeteringConsumers consumers;
 };
\ No newline at end of file
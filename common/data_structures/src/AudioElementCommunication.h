@@ -19,32 +19,16 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_core/juce_core.h>
 
-#include <boost/unordered_map.hpp>
 #include <iostream>
 #include <thread>
+#include <vector>
 
+#include "AudioElementSharedMemory.h"
+#include "AudioElementTelemetryTable.h"
+#include "AudioElementUpdateData.h"
 #include "ParameterMetaData.h"
-#include "boost/unordered/unordered_map_fwd.hpp"
 #include "zmq.hpp"
 
-struct AudioElementUpdateData {
-  float x;
-  float y;
-  float z;
-  float loudness;
-  std::array<char, 16> uuid;
-  char name[64];
-
-  AudioElementUpdateData() {
-    x = 0;
-    y = 0;
-    z = 0;
-    loudness = 0;
-    memcpy(uuid.data(), juce::Uuid().getRawData(), 16);
-    strcpy(name, "");
-  }
-};
-
 class AudioElementPublisher {
   zmq::socket_t socket_;
   zmq::context_t context_;
@@ -61,43 +45,27 @@ class AudioElementPublisher {
 
   ~AudioElementPublisher() { socket_.close(); }
 
-  void publishData(AudioElementUpdateData data) {
+  // Send the updates of any number of instances as a single message
+  void publishData(const std::vector<AudioElementUpdateData>& data) {
     // Create a zmq message
-    zmq::message_t message(sizeof(AudioElementUpdateData));
+    zmq::message_t message(data.size() * sizeof(AudioElementUpdateData));
     // Copy the data into the message
-    memcpy(message.data(), &data, sizeof(AudioElementUpdateData));
+    memcpy(message.data(), data.data(), message.size());
     // Send the message
     socket_.send(message);
   }
 };
 
-struct AudioElementPluginUuidHash {
-  std::size_t operator()(const std::array<char, 16>& uuid) const {
-    // Hash function suggested by ChatGPT
-    std::size_t hash_value = 0;
-    for (const char& c : uuid) {
-      hash_value ^= std::hash<char>()(c) + 0x9e3779b9 + (hash_value << 6) +
-                    (hash_value >> 2);
-    }
-    return hash_value;
-  }
-};
-
-struct AudioElementPluginUuidEqual {
-  bool operator()(const std::array<char, 16>& lhs,
-                  const std::array<char, 16>& rhs) const {
-    return lhs == rhs;
-  }
-};
-
 class AudioElementSubscriber {
-  boost::unordered_map<std::array<char, 16>, AudioElementUpdateData,
-                       AudioElementPluginUuidHash, AudioElementPluginUuidEqual>
-      dataMap;
-  juce::ReadWriteLock dataMapLock;
+  // Telemetry received over ZMQ. Instances that stop publishing, because
+  // their track was deleted or bypassed, age out of the table.
+  AudioElementTelemetryTable dataTable;
   zmq::socket_t socket;
   zmq::context_t context;
   std::thread listenerThread;
+  // Telemetry from element plugins publishing through shared memory. ZMQ
+  // messages are only received from plugins that could not open it.
+  AudioElementSharedReader sharedReader;
 
   // Variables for retrying the connections and handling premature deletion
   bool closing;
@@ -160,12 +128,16 @@ class AudioElementSubscriber {
           context.close();
           break;
         }
-        // Copy the message into a data struct
-        AudioElementUpdateData d;
-        memcpy(&d, message.data(), sizeof(AudioElementUpdateData));
-        // Write the data to the data map
-        juce::ScopedWriteLock writeLock(dataMapLock);
-        dataMap[d.uuid] = d;
+        // Each message holds the updates of one or more instances
+        const size_t count = message.size() / sizeof(AudioElementUpdateData);
+        const char* bytes = static_cast<const char*>(message.data());
+        const juce::int64 now = juce::Time::currentTimeMillis();
+        for (size_t i = 0; i < count; ++i) {
+          AudioElementUpdateData d;
+          memcpy(&d, bytes + i * sizeof(AudioElementUpdateData),
+                 sizeof(AudioElementUpdateData));
+          dataTable.update(d, now);
+        }
       }
     });
   }
@@ -181,20 +153,19 @@ class AudioElementSubscriber {
 
   // AudioElementUpdateData getData(
   void getData(std::function<void(AudioElementUpdateData)> callback) const {
-    // Read the data map
-    juce::ScopedReadLock readLock(dataMapLock);
-    // Iterate through each element, calling the callback
-    for (auto it = dataMap.begin(); it != dataMap.end(); ++it) {
-      callback(it->second);
+    // Element plugins able to use shared memory publish there.
+    sharedReader.getData(callback);
+
+    // Copy out the live entries so the callback runs without the lock
+    std::vector<AudioElementUpdateData> live;
+    live.reserve(AudioElementTelemetryTable::kCapacity);
+    dataTable.getLive(live, juce::Time::currentTimeMillis());
+    for (const AudioElementUpdateData& data : live) {
+      callback(data);
     }
   }
 
-  // This will need to be called occasionally, (maybe before prepareToPlay) to
-  // avoid the map growing wildly
-  void clearData() {
-    // Write lock the data map
-    juce::ScopedWriteLock writeLock(dataMapLock);
-    // Clear the data map
-    dataMap.clear();
-  }
+  // Forget all telemetry received over ZMQ. Stale entries are dropped
+  // automatically, so this is only needed to reset immediately.
+  void clearData() { dataTable.clear(); }
 };
\ No newline at end of file
@@ -0,0 +1,291 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AudioElementPluginHub.h"
+
+#include <algorithm>
+
+AudioElementPluginHub::AudioElementPluginHub()
+    : juce::Thread("Element plugin hub"),
+      updateIntervalMs_(1000 / kDefaultUpdateRateHz),
+      loudnessThresholdDb_(kDefaultLoudnessThresholdDb),
+      positionThreshold_(kDefaultPositionThreshold),
+      connection_(*this),
+      connector_(*this) {}
+
+AudioElementPluginHub::~AudioElementPluginHub() {
+  signalThreadShouldExit();
+  notify();
+  stopThread(2000);
+  // A connection attempt times out after a second
+  connector_.stopThread(2000);
+  cancelPendingUpdate();
+  connection_.disconnect();
+}
+
+void AudioElementPluginHub::startIfNeeded() {
+  // The thread is only needed once an instance has registered, so holding a
+  // hub (e.g. in tests) costs nothing.
+  if (!isThreadRunning()) {
+    startThread();
+  }
+}
+
+void AudioElementPluginHub::run() {
+  while (!threadShouldExit()) {
+    // Sample at the update rate, or sooner if woken by a notify()
+    wait(updateIntervalMs_.load(std::memory_order_relaxed));
+    if (threadShouldExit()) {
+      break;
+    }
+    publishTelemetry();
+  }
+  // The ZMQ socket belongs to this thread.
+  const juce::ScopedLock lock(telemetryLock_);
+  localPublisher_.reset();
+}
+
+//==============================================================================
+void AudioElementPluginHub::addTelemetrySource(AudioElementUpdateSlot* slot) {
+  // Prefer writing in place to the shared memory segment read by the
+  // renderer, falling back to ZMQ where shared memory is unavailable.
+  auto sharedPublisher = std::make_unique<AudioElementSharedPublisher>();
+  if (!sharedPublisher->isOpen()) {
+    sharedPublisher.reset();
+  }
+  {
+    const juce::ScopedLock lock(telemetryLock_);
+    telemetrySources_.push_back(
+        {slot, std::move(sharedPublisher), AudioElementUpdateData(), false,
+         slot->getProcessedBlocks()});
+  }
+  startIfNeeded();
+}
+
+void AudioElementPluginHub::removeTelemetrySource(
+    AudioElementUpdateSlot* slot) {
+  const juce::ScopedLock lock(telemetryLock_);
+  telemetrySources_.erase(
+      std::remove_if(telemetrySources_.begin(), telemetrySources_.end(),
+                     [slot](const TelemetrySource& source) {
+                       return source.slot == slot;
+                     }),
+      telemetrySources_.end());
+}
+
+void AudioElementPluginHub::setUpdateRate(const int updateRateHz) {
+  updateIntervalMs_.store(1000 / juce::jlimit(1, 1000, updateRateHz),
+                          std::memory_order_relaxed);
+  notify();
+}
+
+void AudioElementPluginHub::setThresholds(const float loudnessDb,
+                                          const float position) {
+  loudnessThresholdDb_.store(loudnessDb, std::memory_order_relaxed);
+  positionThreshold_.store(position, std::memory_order_relaxed);
+}
+
+void AudioElementPluginHub::publishTelemetry() {
+  const float loudnessThreshold =
+      loudnessThresholdDb_.load(std::memory_order_relaxed);
+  const float positionThreshold =
+      positionThreshold_.load(std::memory_order_relaxed);
+  const juce::int64 now = juce::Time::currentTimeMillis();
+  // Keep the renderer from ageing out instances while nothing changes, as
+  // long as the host is still processing them.
+  const bool keepAlive = now - lastKeepAliveMs_ > 1000;
+  if (keepAlive) {
+    lastKeepAliveMs_ = now;
+  }
+
+  const juce::ScopedLock lock(telemetryLock_);
+  localUpdates_.clear();
+  for (auto& source : telemetrySources_) {
+    if (!source.slot->hasDescription()) {
+      continue;
+    }
+    const uint32_t kBlocksAtLastKeepAlive = source.blocksAtKeepAlive;
+    if (keepAlive) {
+      source.blocksAtKeepAlive = source.slot->getProcessedBlocks();
+    }
+    const AudioElementUpdateData latest = source.slot->read();
+    const bool changed =
+        !source.sentAny ||
+        AudioElementUpdateSlot::differs(source.lastSent, latest,
+                                        loudnessThreshold, positionThreshold);
+    if (changed) {
+      if (source.sharedPublisher != nullptr) {
+        source.sharedPublisher->publishData(latest);
+      } else {
+        localUpdates_.push_back(latest);
+      }
+      source.lastSent = latest;
+      source.sentAny = true;
+    } else if (keepAlive &&
+               source.blocksAtKeepAlive != kBlocksAtLastKeepAlive) {
+      if (source.sharedPublisher != nullptr) {
+        source.sharedPublisher->keepAlive();
+      } else {
+        localUpdates_.push_back(source.lastSent);
+      }
+    }
+  }
+
+  // Everything published over ZMQ goes out as one message.
+  if (!localUpdates_.empty()) {
+    if (localPublisher_ == nullptr) {
+      localPublisher_ = std::make_unique<AudioElementPublisher>();
+    }
+    localPublisher_->publishData(localUpdates_);
+  }
+}
+
+//==============================================================================
+void AudioElementPluginHub::addSyncClient(AudioElementPluginHubClient* client,
+                                          const int port) {
+  {
+    const juce::ScopedLock lock(syncLock_);
+    syncChannels_.push_back({client, nextChannel_++, true});
+    port_ = port;
+    // Late instances start from the repository the others already have.
+    if (rendererReceiver_.isSynchronised()) {
+      client->rendererRepositoryReceived(sharedRendererState_);
+    }
+  }
+  triggerAsyncUpdate();
+  startIfNeeded();
+  if (!connector_.isThreadRunning()) {
+    connector_.startThread();
+  }
+}
+
+void AudioElementPluginHub::removeSyncClient(
+    AudioElementPluginHubClient* client) {
+  const juce::ScopedLock lock(syncLock_);
+  auto found = std::find_if(
+      syncChannels_.begin(), syncChannels_.end(),
+      [client](const SyncChannel& channel) { return channel.client == client; });
+  if (found == syncChannels_.end()) {
+    return;
+  }
+  // The renderer drops the instance when its channel closes, as the
+  // connection is kept open for the remaining instances.
+  sendToRenderer(found->channel, RepositorySync::createChannelClosed());
+  syncChannels_.erase(found);
+}
+
+void AudioElementPluginHub::Connector::run() {
+  int retryMs = kMinRetryMs;
+  while (!threadShouldExit()) {
+    // Back off while the renderer is absent. A lost connection is noticed
+    // within a second.
+    if (hub_.maintainConnection()) {
+      retryMs = kMinRetryMs;
+      wait(kMinRetryMs);
+    } else {
+      wait(retryMs);
+      retryMs = std::min(retryMs * 2, kMaxRetryMs);
+    }
+  }
+}
+
+bool AudioElementPluginHub::maintainConnection() {
+  const int port = port_.load();
+  if (port < 0 || connection_.isConnected()) {
+    return true;
+  }
+  {
+    const juce::ScopedLock lock(syncLock_);
+    if (syncChannels_.empty()) {
+      return true;
+    }
+  }
+  return connection_.connectToSocket("localhost", port, 1000);
+}
+
+void AudioElementPluginHub::connectionMade() {
+  // The renderer starts from scratch on every connection
+  const juce::ScopedLock lock(syncLock_);
+  for (auto& channel : syncChannels_) {
+    channel.snapshotRequested = true;
+  }
+  triggerAsyncUpdate();
+}
+
+void AudioElementPluginHub::handleAsyncUpdate() {
+  const juce::ScopedLock lock(syncLock_);
+  if (!connection_.isConnected()) {
+    // Snapshots are sent once connected
+    return;
+  }
+
+  RepositorySync::Bundle bundle;
+  for (auto& channel : syncChannels_) {
+    // Always diff so the client's sender tracks the latest state, even when
+    // a snapshot is about to supersede the patch
+    juce::MemoryBlock patch;
+    const bool changed = channel.client->createRepositoryPatch(patch);
+    if (channel.snapshotRequested) {
+      bundle.add(channel.channel, channel.client->createRepositorySnapshot());
+      channel.snapshotRequested = false;
+    } else if (changed) {
+      bundle.add(channel.channel, patch);
+    }
+  }
+  if (!bundle.isEmpty()) {
+    connection_.sendMessage(bundle.getData());
+  }
+}
+
+void AudioElementPluginHub::messageReceived(const juce::MemoryBlock& message) {
+  const juce::ScopedLock lock(syncLock_);
+  RepositorySync::readBundle(message, [this](const uint32_t channel,
+                                             const juce::MemoryBlock& part) {
+    if (channel != kRendererChannel) {
+      // The renderer lost track of an instance's repository
+      if (RepositorySync::isResyncRequest(part)) {
+        for (auto& syncChannel : syncChannels_) {
+          if (syncChannel.channel == channel) {
+            syncChannel.snapshotRequested = true;
+            triggerAsyncUpdate();
+          }
+        }
+      }
+      return;
+    }
+
+    const RepositorySync::Receiver::Result result =
+        rendererReceiver_.apply(part, rendererState_);
+    if (result == RepositorySync::Receiver::Result::kResyncRequired) {
+      sendToRenderer(kRendererChannel, RepositorySync::createResyncRequest());
+    }
+    if (result != RepositorySync::Receiver::Result::kApplied) {
+      return;
+    }
+    // One copy for every instance, which only ever read it
+    sharedRendererState_ = rendererState_.createCopy();
+    for (auto& syncChannel : syncChannels_) {
+      syncChannel.client->rendererRepositoryReceived(sharedRendererState_);
+    }
+  });
+}
+
+void AudioElementPluginHub::sendToRenderer(const uint32_t channel,
+                                           const juce::MemoryBlock& message) {
+  if (connection_.isConnected()) {
+    RepositorySync::Bundle bundle;
+    bundle.add(channel, message);
+    connection_.sendMessage(bundle.getData());
+  }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "AudioElementCommunication.h"
+#include "AudioElementSharedMemory.h"
+#include "AudioElementUpdateSlot.h"
+#include "RepositorySync.h"
+
+// Implemented by each element plugin instance's repository sync client.
+// Called by the hub on the message thread.
+class AudioElementPluginHubClient {
+ public:
+  virtual ~AudioElementPluginHubClient() = default;
+
+  // Encode the changes to this instance's repository since the last call.
+  virtual bool createRepositoryPatch(juce::MemoryBlock& patch) = 0;
+
+  // Encode this instance's repository as of the last patch.
+  virtual juce::MemoryBlock createRepositorySnapshot() = 0;
+
+  // The renderer's repository changed. The tree is shared by every client
+  // and must not be modified.
+  virtual void rendererRepositoryReceived(const juce::ValueTree& state) = 0;
+};
+
+/**
+ * @brief Communication with the renderer, shared by every element plugin
+ * instance in the process.
+ *
+ * Hold it through a juce::SharedResourcePointer: the first instance creates
+ * the hub and the last one tears it down.
+ *
+ * One thread samples the telemetry slot of every instance and publishes the
+ * ones that changed, batched into a single message where shared memory is
+ * unavailable. A second thread keeps one connection open to the renderer's
+ * sync server, so that waiting on a connection never holds up telemetry.
+ * Every instance's repository gets its own channel on that connection. The
+ * renderer's repository arrives once and is shared by all instances.
+ */
+class AudioElementPluginHub : private juce::Thread, private juce::AsyncUpdater {
+ public:
+  static constexpr int kDefaultUpdateRateHz = 30;
+  static constexpr float kDefaultLoudnessThresholdDb = 0.1f;
+  static constexpr float kDefaultPositionThreshold = 0.01f;
+  // Channel carrying the renderer's repository.
+  static constexpr uint32_t kRendererChannel = 0;
+
+  AudioElementPluginHub();
+  ~AudioElementPluginHub() override;
+
+  //============================================================================
+  // Telemetry.
+
+  void addTelemetrySource(AudioElementUpdateSlot* slot);
+  void removeTelemetrySource(AudioElementUpdateSlot* slot);
+
+  // Sample the slots now rather than at the next update, e.g. after a rename.
+  void requestTelemetryUpdate() { notify(); }
+
+  void setUpdateRate(const int updateRateHz);
+  // Changes no larger than these are not sent.
+  void setThresholds(const float loudnessDb, const float position);
+
+  //============================================================================
+  // Repository sync. Called from the message thread.
+
+  void addSyncClient(AudioElementPluginHubClient* client, const int port);
+  void removeSyncClient(AudioElementPluginHubClient* client);
+
+  // Queue a client's repository changes to be sent. Calls made in quick
+  // succession, by any number of clients, go out as one message.
+  void syncClientChanged() { triggerAsyncUpdate(); }
+
+  bool isConnected() const { return connection_.isConnected(); }
+
+ private:
+  class Connection : public juce::InterprocessConnection {
+   public:
+    explicit Connection(AudioElementPluginHub& hub) : hub_(hub) {}
+    ~Connection() override { disconnect(); }
+
+    void connectionMade() override { hub_.connectionMade(); }
+    void connectionLost() override {}
+    void messageReceived(const juce::MemoryBlock& message) override {
+      hub_.messageReceived(message);
+    }
+
+   private:
+    AudioElementPluginHub& hub_;
+  };
+
+  // Connects to the renderer while it is absent, backing off from once a
+  // second to every few seconds.
+  class Connector : public juce::Thread {
+   public:
+    explicit Connector(AudioElementPluginHub& hub)
+        : juce::Thread("Element plugin hub connector"), hub_(hub) {}
+
+    void run() override;
+
+   private:
+    static constexpr int kMinRetryMs = 1000;
+    static constexpr int kMaxRetryMs = 8000;
+
+    AudioElementPluginHub& hub_;
+  };
+
+  struct TelemetrySource {
+    AudioElementUpdateSlot* slot;
+    // Null where shared memory is unavailable and ZMQ is used instead.
+    std::unique_ptr<AudioElementSharedPublisher> sharedPublisher;
+    AudioElementUpdateData lastSent;
+    bool sentAny;
+    // The slot's processed block count at the last keep-alive
+    uint32_t blocksAtKeepAlive;
+  };
+
+  struct SyncChannel {
+    AudioElementPluginHubClient* client;
+    uint32_t channel;
+    bool snapshotRequested;
+  };
+
+  void run() override;
+  void handleAsyncUpdate() override;
+
+  void publishTelemetry();
+  // Returns false if a connection attempt failed.
+  bool maintainConnection();
+  void startIfNeeded();
+
+  void connectionMade();
+  void messageReceived(const juce::MemoryBlock& message);
+  void sendToRenderer(const uint32_t channel, const juce::MemoryBlock& message);
+
+  // Telemetry state. Sources are registered on the message thread and
+  // sampled on the hub thread.
+  juce::CriticalSection telemetryLock_;
+  std::vector<TelemetrySource> telemetrySources_;
+  // Created on the hub thread the first time a source needs it.
+  std::unique_ptr<AudioElementPublisher> localPublisher_;
+  std::vector<AudioElementUpdateData> localUpdates_;
+  juce::int64 lastKeepAliveMs_ = 0;
+  std::atomic<int> updateIntervalMs_;
+  std::atomic<float> loudnessThresholdDb_;
+  std::atomic<float> positionThreshold_;
+
+  // Sync state, used on the message thread apart from connection attempts.
+  juce::CriticalSection syncLock_;
+  std::vector<SyncChannel> syncChannels_;
+  uint32_t nextChannel_ = kRendererChannel + 1;
+  std::atomic<int> port_{-1};
+  RepositorySync::Receiver rendererReceiver_;
+  juce::ValueTree rendererState_;
+  // Read-only copy of rendererState_ handed to the clients.
+  juce::ValueTree sharedRendererState_;
+  Connection connection_;
+  Connector connector_;
+};
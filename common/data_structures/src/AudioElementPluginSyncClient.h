@@ -19,13 +19,18 @@
 #include "data_repository/implementation/AudioElementRepository.h"
 #include "data_repository/implementation/AudioElementSpatialLayoutRepository.h"
 #include "data_structures/src/AudioElement.h"
+#include "data_structures/src/AudioElementPluginHub.h"
+#include "data_structures/src/RepositorySync.h"
 
 class AudioElementPluginListener {
  public:
   virtual void audioElementsUpdated() = 0;
 };
 
-class AudioElementPluginSyncClient : public juce::InterprocessConnection {
+// Keeps an element plugin instance's spatial layout in sync with the renderer
+// and mirrors the renderer's audio elements. All instances in a process share
+// one connection through the AudioElementPluginHub.
+class AudioElementPluginSyncClient : private AudioElementPluginHubClient {
  protected:
   AudioElementRepository
       rendererAudioElements_;  // Make protected so it can be set in unit tests
@@ -35,27 +40,23 @@ class AudioElementPluginSyncClient : public juce::InterprocessConnection {
   std::vector<AudioElementPluginListener*> listeners_;
   juce::CriticalSection rendererAudioElementsLock_;
   int port_;
-  bool initialized_;
-  std::atomic_bool connected_{false};
-  std::atomic_bool terminationRequested_{false};
-  std::thread connectionThread_;
+  // Only used by the hub, on the message thread.
+  RepositorySync::Sender sender_;
+  juce::SharedResourcePointer<AudioElementPluginHub> hub_;
 
  public:
   AudioElementPluginSyncClient(
       AudioElementSpatialLayoutRepository* AudioElementSpatialLayoutRepository,
       int port)
-      : toRegister_(AudioElementSpatialLayoutRepository),
-        port_(port),
-        initialized_(false) {}
+      : toRegister_(AudioElementSpatialLayoutRepository), port_(port) {}
 
-  ~AudioElementPluginSyncClient() override {}
+  ~AudioElementPluginSyncClient() override { hub_->removeSyncClient(this); }
 
   void disconnectClient() {
+    // Leave the hub first, it calls back into this client under its own lock
+    hub_->removeSyncClient(this);
     juce::ScopedLock lock(rendererAudioElementsLock_);
     listeners_.clear();
-    terminationRequested_ = true;
-    connectionThread_.join();
-    disconnect(30000);
   }
 
   void registerListener(AudioElementPluginListener* listener) {
@@ -91,59 +92,29 @@ class AudioElementPluginSyncClient : public juce::InterprocessConnection {
     }
   }
 
-  // EJ 10/31
-
-  void tryConnect() {  // Start a thread here to try and perform the connection
-    connectionThread_ = std::thread([this] {
-      // Try and connect, checking to see if deletion
-      // has been requested and we need to stop
-      while (!connected_ && !terminationRequested_) {
-        rendererAudioElementsLock_.enter();
-        bool connected = connectToSocket("localhost", port_, 5000);
-        if (connected) {
-          rendererAudioElementsLock_.exit();
-          connected_ = true;
-          sendAudioElementSpatialLayoutRepository();
-          return;
-        }
-        rendererAudioElementsLock_.exit();
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-      };
-    });
-  }
-
-  void connect() { tryConnect(); }
+  // Register with the hub, which connects to the renderer if it has not
+  // already and keeps retrying until it can
+  void connect() { hub_->addSyncClient(this, port_); }
 
-  void connectionMade() override {}
+  // Queue the changes made to the spatial layout to be sent to the renderer.
+  // Calls made in quick succession are coalesced into a single patch.
+  void sendAudioElementSpatialLayoutRepository() { hub_->syncClientChanged(); }
 
-  void connectionLost() override {
-    connected_ = true;  // Avoid possible deadlock if connection lost got called
-                        // while we are trying to connect. I don't think this
-                        // will happen in practice, but better safe
-    connectionThread_.join();
+ private:
+  bool createRepositoryPatch(juce::MemoryBlock& patch) override {
+    return sender_.createPatch(toRegister_->getTree(), patch);
+  }
 
-    connected_ = false;
-    if (!terminationRequested_) tryConnect();
+  juce::MemoryBlock createRepositorySnapshot() override {
+    return sender_.createSnapshot();
   }
 
-  void messageReceived(const juce::MemoryBlock& message) override {
-    juce::MemoryInputStream stream(message, false);
-    juce::ValueTree repository = juce::ValueTree::readFromStream(stream);
+  void rendererRepositoryReceived(const juce::ValueTree& state) override {
     juce::ScopedLock lock(rendererAudioElementsLock_);
-    rendererAudioElements_.setStateTree(repository);
+    rendererAudioElements_.setStateTree(state);
 
     for (auto listener : listeners_) {
       listener->audioElementsUpdated();
     }
-    initialized_ = true;
-  }
-
-  void sendAudioElementSpatialLayoutRepository() {
-    if (connected_) {
-      juce::MemoryBlock block;
-      juce::MemoryOutputStream stream(block, false);
-      toRegister_->writeToStream(stream);
-      sendMessage(block);
-    }
   }
 };
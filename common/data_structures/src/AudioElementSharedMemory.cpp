@@ -0,0 +1,217 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AudioElementSharedMemory.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+//==============================================================================
+bool SharedMemoryRegion::open(const char* name, const size_t size) {
+  close();
+#ifdef _WIN32
+  // Windows names may not contain the leading slash used by POSIX.
+  const juce::String mappingName =
+      "Local\\" + juce::String(name).trimCharactersAtStart("/");
+  HANDLE mapping = CreateFileMappingW(
+      INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+      (DWORD)((uint64_t)size >> 32), (DWORD)(size & 0xFFFFFFFF),
+      mappingName.toWideCharPointer());
+  if (mapping == nullptr) {
+    return false;
+  }
+  void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if (data == nullptr) {
+    CloseHandle(mapping);
+    return false;
+  }
+  handle_ = mapping;
+#else
+  const int fd = shm_open(name, O_CREAT | O_RDWR, 0600);
+  if (fd < 0) {
+    return false;
+  }
+  // The first process to open the segment sizes it, which zero-fills it.
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      ((size_t)info.st_size < size && ftruncate(fd, size) != 0)) {
+    ::close(fd);
+    return false;
+  }
+  void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+#endif
+  data_ = data;
+  size_ = size;
+  return true;
+}
+
+void SharedMemoryRegion::close() {
+  if (data_ == nullptr) {
+    return;
+  }
+#ifdef _WIN32
+  UnmapViewOfFile(data_);
+  CloseHandle((HANDLE)handle_);
+  handle_ = nullptr;
+#else
+  munmap(data_, size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+//==============================================================================
+AudioElementTelemetrySegment* AudioElementTelemetrySegment::open(
+    SharedMemoryRegion& region) {
+  if (!region.open(kName, sizeof(AudioElementTelemetrySegment))) {
+    return nullptr;
+  }
+  auto* segment =
+      static_cast<AudioElementTelemetrySegment*>(region.getData());
+
+  // Stamp a freshly created segment. A segment stamped by another layout or
+  // version is left alone so the caller falls back to another transport.
+  uint64_t expected = 0;
+  if (!segment->header.compare_exchange_strong(expected, kHeader,
+                                               std::memory_order_acq_rel) &&
+      expected != kHeader) {
+    region.close();
+    return nullptr;
+  }
+  return segment;
+}
+
+//==============================================================================
+AudioElementSharedPublisher::AudioElementSharedPublisher()
+    : token_((uint64_t)juce::Random::getSystemRandom().nextInt64() | 1) {
+  segment_ = AudioElementTelemetrySegment::open(region_);
+  if (segment_ != nullptr && !claimSlot()) {
+    // Every slot is in use, fall back to another transport.
+    segment_ = nullptr;
+    region_.close();
+  }
+}
+
+AudioElementSharedPublisher::~AudioElementSharedPublisher() {
+  if (slot_ != nullptr) {
+    uint64_t expected = token_;
+    slot_->owner.compare_exchange_strong(expected, 0);
+  }
+}
+
+bool AudioElementSharedPublisher::claimSlot() {
+  const int64_t now = juce::Time::currentTimeMillis();
+  for (auto& slot : segment_->slots) {
+    uint64_t owner = slot.owner.load(std::memory_order_acquire);
+    const bool stale =
+        now - slot.heartbeatMs.load(std::memory_order_relaxed) >
+        AudioElementTelemetrySegment::kStaleMs;
+    if (owner != 0 && !stale) {
+      continue;
+    }
+    if (slot.owner.compare_exchange_strong(owner, token_)) {
+      slot.published.store(0, std::memory_order_relaxed);
+      slot.heartbeatMs.store(now, std::memory_order_relaxed);
+      slot_ = &slot;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AudioElementSharedPublisher::ownsSlot() const {
+  return slot_ != nullptr &&
+         slot_->owner.load(std::memory_order_relaxed) == token_;
+}
+
+bool AudioElementSharedPublisher::publishData(
+    const AudioElementUpdateData& data) {
+  if (segment_ == nullptr) {
+    return false;
+  }
+  // The slot can be reclaimed if this instance stalled past the stale
+  // timeout, in which case move to another one.
+  if (!ownsSlot() && !claimSlot()) {
+    return false;
+  }
+
+  const uint32_t sequence = slot_->sequence.load(std::memory_order_relaxed);
+  slot_->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(&slot_->data, &data, sizeof(AudioElementUpdateData));
+  slot_->sequence.store(sequence + 2, std::memory_order_release);
+  slot_->published.store(1, std::memory_order_release);
+  slot_->heartbeatMs.store(juce::Time::currentTimeMillis(),
+                           std::memory_order_relaxed);
+  return true;
+}
+
+void AudioElementSharedPublisher::keepAlive() {
+  if (ownsSlot()) {
+    slot_->heartbeatMs.store(juce::Time::currentTimeMillis(),
+                             std::memory_order_relaxed);
+  }
+}
+
+//==============================================================================
+AudioElementSharedReader::AudioElementSharedReader() {
+  segment_ = AudioElementTelemetrySegment::open(region_);
+}
+
+void AudioElementSharedReader::getData(
+    const std::function<void(const AudioElementUpdateData&)>& callback) const {
+  if (segment_ == nullptr) {
+    return;
+  }
+  const int64_t now = juce::Time::currentTimeMillis();
+  AudioElementUpdateData snapshot;
+  for (auto& slot : segment_->slots) {
+    if (slot.owner.load(std::memory_order_relaxed) == 0 ||
+        slot.published.load(std::memory_order_acquire) == 0 ||
+        now - slot.heartbeatMs.load(std::memory_order_relaxed) >
+            AudioElementTelemetrySegment::kStaleMs) {
+      continue;
+    }
+    // Retry while a write is in progress. Writes are a short memcpy so this
+    // settles immediately in practice; give up on the slot for this read if
+    // it keeps changing.
+    for (int attempt = 0; attempt < 4; ++attempt) {
+      const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+      if (before & 1) {
+        continue;
+      }
+      std::memcpy(&snapshot, &slot.data, sizeof(AudioElementUpdateData));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == before) {
+        callback(snapshot);
+        break;
+      }
+    }
+  }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "AudioElementUpdateData.h"
+
+// A named memory segment shared between processes. Created zero-filled by
+// whichever process opens it first.
+class SharedMemoryRegion {
+ public:
+  SharedMemoryRegion() = default;
+  ~SharedMemoryRegion() { close(); }
+
+  SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+  SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+  bool open(const char* name, const size_t size);
+  void close();
+
+  void* getData() const { return data_; }
+  bool isOpen() const { return data_ != nullptr; }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+  void* handle_ = nullptr;  // Windows file mapping handle
+};
+
+/**
+ * @brief Layout of the element telemetry segment.
+ *
+ * Each element plugin instance owns one slot. Writers bump the slot's
+ * sequence to an odd value, copy the data in place and bump it back to even,
+ * so readers can take a consistent snapshot without ever blocking a writer.
+ */
+struct AudioElementTelemetrySegment {
+  static constexpr uint32_t kMagic = 0xEC11A5A1;
+  static constexpr uint32_t kVersion = 1;
+  // Magic and version packed into one word so a segment is stamped with both
+  // in a single atomic step.
+  static constexpr uint64_t kHeader = (uint64_t)kMagic << 32 | kVersion;
+  static constexpr int kNumSlots = 256;
+  // Slots whose heartbeat is older than this belong to instances that have
+  // gone away without releasing them.
+  static constexpr int64_t kStaleMs = 5000;
+  static constexpr const char* kName = "/eclipsa_element_telemetry_v1";
+
+  struct Slot {
+    // Random token of the owning instance, 0 when the slot is free.
+    std::atomic<uint64_t> owner;
+    // Milliseconds since the epoch the owner last claimed, wrote or
+    // refreshed the slot.
+    std::atomic<int64_t> heartbeatMs;
+    // Non-zero once the owner has written data. Hides a claimed slot, which
+    // may still hold a previous owner's data, until then.
+    std::atomic<uint32_t> published;
+    std::atomic<uint32_t> sequence;
+    AudioElementUpdateData data;
+  };
+
+  std::atomic<uint64_t> header;
+  Slot slots[kNumSlots];
+
+  static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                    std::atomic<int64_t>::is_always_lock_free &&
+                    std::atomic<uint32_t>::is_always_lock_free,
+                "Shared memory atomics must be address free");
+
+  // Map the segment. Returns nullptr if it cannot be opened or was created by
+  // an incompatible build.
+  static AudioElementTelemetrySegment* open(SharedMemoryRegion& region);
+};
+
+// Publishes one element plugin instance's telemetry into its own slot.
+class AudioElementSharedPublisher {
+ public:
+  AudioElementSharedPublisher();
+  ~AudioElementSharedPublisher();
+
+  // False if shared memory is unavailable and a fallback must be used.
+  bool isOpen() const { return segment_ != nullptr; }
+
+  // Write the latest data in place. Wait-free.
+  bool publishData(const AudioElementUpdateData& data);
+
+  // Refresh the slot's heartbeat without changing its data.
+  void keepAlive();
+
+ private:
+  bool claimSlot();
+  bool ownsSlot() const;
+
+  SharedMemoryRegion region_;
+  AudioElementTelemetrySegment* segment_ = nullptr;
+  AudioElementTelemetrySegment::Slot* slot_ = nullptr;
+  uint64_t token_;
+};
+
+// Reads snapshots of every live slot in the telemetry segment.
+class AudioElementSharedReader {
+ public:
+  AudioElementSharedReader();
+
+  bool isOpen() const { return segment_ != nullptr; }
+
+  // Call back with a consistent snapshot of each live slot.
+  void getData(
+      const std::function<void(const AudioElementUpdateData&)>& callback) const;
+
+ private:
+  SharedMemoryRegion region_;
+  AudioElementTelemetrySegment* segment_ = nullptr;
+};
@@ -0,0 +1,141 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AudioElementTelemetryTable.h"
+
+#include <cstring>
+
+static_assert((AudioElementTelemetryTable::kNumBuckets &
+               (AudioElementTelemetryTable::kNumBuckets - 1)) == 0,
+              "Buckets are indexed with a mask");
+
+AudioElementTelemetryTable::AudioElementTelemetryTable() { used_.fill(false); }
+
+AudioElementTelemetryTable::Key AudioElementTelemetryTable::toKey(
+    const std::array<char, 16>& uuid) {
+  Key key;
+  std::memcpy(&key.hi, uuid.data(), sizeof(key.hi));
+  std::memcpy(&key.lo, uuid.data() + sizeof(key.hi), sizeof(key.lo));
+  return key;
+}
+
+uint32_t AudioElementTelemetryTable::hash(const Key& key) {
+  // Fold both halves and finish with the MurmurHash3 64-bit mix, so every
+  // bit of the UUID reaches the bucket index.
+  uint64_t h = key.hi ^ (key.lo * 0x9e3779b97f4a7c15ull);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return (uint32_t)h;
+}
+
+int AudioElementTelemetryTable::find(const Key& key) const {
+  // Never more than half full, so the probe always ends at an empty bucket
+  int bucket = hash(key) & (kNumBuckets - 1);
+  while (used_[bucket] && !(keys_[bucket] == key)) {
+    bucket = (bucket + 1) & (kNumBuckets - 1);
+  }
+  return bucket;
+}
+
+bool AudioElementTelemetryTable::update(const AudioElementUpdateData& data,
+                                        const juce::int64 nowMs) {
+  const Key key = toKey(data.uuid);
+  const juce::SpinLock::ScopedLockType lock(lock_);
+  if (nowMs - lastSweepMs_ >= 1000) {
+    evictStaleLocked(nowMs);
+  }
+
+  int bucket = find(key);
+  if (!used_[bucket]) {
+    if (size_ >= kCapacity) {
+      // Make room from any entries that went stale since the last sweep
+      evictStaleLocked(nowMs);
+      if (size_ >= kCapacity) {
+        return false;
+      }
+      bucket = find(key);
+    }
+    used_[bucket] = true;
+    keys_[bucket] = key;
+    ++size_;
+  }
+  heartbeatsMs_[bucket] = nowMs;
+  data_[bucket] = data;
+  return true;
+}
+
+void AudioElementTelemetryTable::getLive(
+    std::vector<AudioElementUpdateData>& out, const juce::int64 nowMs) const {
+  const juce::SpinLock::ScopedLockType lock(lock_);
+  for (int i = 0; i < kNumBuckets; ++i) {
+    if (used_[i] && !isStale(heartbeatsMs_[i], nowMs)) {
+      out.push_back(data_[i]);
+    }
+  }
+}
+
+void AudioElementTelemetryTable::evictStale(const juce::int64 nowMs) {
+  const juce::SpinLock::ScopedLockType lock(lock_);
+  evictStaleLocked(nowMs);
+}
+
+void AudioElementTelemetryTable::evictStaleLocked(const juce::int64 nowMs) {
+  lastSweepMs_ = nowMs;
+  int i = 0;
+  while (i < kNumBuckets) {
+    if (used_[i] && isStale(heartbeatsMs_[i], nowMs)) {
+      // Erasing may shift a later entry into this bucket, so check it again
+      erase(i);
+    } else {
+      ++i;
+    }
+  }
+}
+
+void AudioElementTelemetryTable::erase(int bucket) {
+  // Backward shift deletion: move later entries of the probe sequence into
+  // the hole so lookups never need tombstones.
+  constexpr int kMask = kNumBuckets - 1;
+  int next = (bucket + 1) & kMask;
+  while (used_[next]) {
+    const int home = hash(keys_[next]) & kMask;
+    // The entry can fill the hole unless its home lies cyclically within
+    // (bucket, next].
+    const bool homeAfterHole =
+        ((next - home) & kMask) < ((next - bucket) & kMask);
+    if (!homeAfterHole) {
+      keys_[bucket] = keys_[next];
+      heartbeatsMs_[bucket] = heartbeatsMs_[next];
+      data_[bucket] = data_[next];
+      bucket = next;
+    }
+    next = (next + 1) & kMask;
+  }
+  used_[bucket] = false;
+  --size_;
+}
+
+void AudioElementTelemetryTable::clear() {
+  const juce::SpinLock::ScopedLockType lock(lock_);
+  used_.fill(false);
+  size_ = 0;
+}
+
+int AudioElementTelemetryTable::size() const {
+  const juce::SpinLock::ScopedLockType lock(lock_);
+  return size_;
+}
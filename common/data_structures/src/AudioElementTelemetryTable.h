@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "AudioElementUpdateData.h"
+
+/**
+ * @brief Fixed-capacity table of the latest telemetry received from each
+ * element plugin instance, keyed by the instance's UUID.
+ *
+ * Open addressing with linear probing over structure-of-arrays storage, so
+ * probing only touches the packed keys and heartbeats. Every update refreshes
+ * the entry's heartbeat. Entries not refreshed within kStaleMs belong to
+ * tracks that were deleted or bypassed. They are hidden from readers at once,
+ * and updates sweep them out about once a second.
+ *
+ * Updates and reads may come from different threads. The lock is only held
+ * while copying, never while calling back into readers.
+ */
+class AudioElementTelemetryTable {
+ public:
+  // As many instances as the shared memory segment has slots.
+  static constexpr int kCapacity = 256;
+  // Kept at most half full so probe sequences stay short.
+  static constexpr int kNumBuckets = 2 * kCapacity;
+  // Publishers refresh unchanged telemetry every second.
+  static constexpr juce::int64 kStaleMs = 5000;
+
+  AudioElementTelemetryTable();
+
+  /**
+   * @brief Insert or replace the entry for data.uuid.
+   *
+   * @return False if the table is full of live entries and data was dropped.
+   */
+  bool update(const AudioElementUpdateData& data, const juce::int64 nowMs);
+
+  // Copy out every entry refreshed within kStaleMs of nowMs, as a contiguous
+  // array to iterate without holding the lock.
+  void getLive(std::vector<AudioElementUpdateData>& out,
+               const juce::int64 nowMs) const;
+
+  // Drop every entry not refreshed within kStaleMs of nowMs.
+  void evictStale(const juce::int64 nowMs);
+
+  void clear();
+
+  int size() const;
+
+ private:
+  struct Key {
+    uint64_t hi;
+    uint64_t lo;
+
+    bool operator==(const Key& other) const {
+      return hi == other.hi && lo == other.lo;
+    }
+  };
+
+  static Key toKey(const std::array<char, 16>& uuid);
+  static uint32_t hash(const Key& key);
+  static bool isStale(const juce::int64 heartbeatMs, const juce::int64 nowMs) {
+    return nowMs - heartbeatMs > kStaleMs;
+  }
+
+  int find(const Key& key) const;
+  void evictStaleLocked(const juce::int64 nowMs);
+  void erase(int bucket);
+
+  mutable juce::SpinLock lock_;
+  int size_ = 0;
+  juce::int64 lastSweepMs_ = 0;
+  // Structure of arrays.
+  std::array<bool, kNumBuckets> used_;
+  std::array<Key, kNumBuckets> keys_;
+  std::array<juce::int64, kNumBuckets> heartbeatsMs_;
+  std::array<AudioElementUpdateData, kNumBuckets> data_;
+};
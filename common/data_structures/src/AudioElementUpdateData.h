@@ -18,18 +18,25 @@
 
 #include <juce_core/juce_core.h>
 
-#include "data_structures/src/AudioElementCommunication.h"
+#include <array>
+#include <cstring>
 
-class MessagingThread : public juce::Thread {
- public:
-  MessagingThread(const juce::String& threadName);
-  ~MessagingThread();
+// Position and loudness telemetry sent by each element plugin instance to the
+// renderer.
+struct AudioElementUpdateData {
+  float x;
+  float y;
+  float z;
+  float loudness;
+  std::array<char, 16> uuid;
+  char name[64];
 
-  void pushAudioElementUpdateData(const AudioElementUpdateData& data);
-
- private:
-  void run() override;
-  juce::SpinLock queueLock_;
-  std::vector<AudioElementUpdateData> dataQueue_;
-  std::unique_ptr<AudioElementPublisher> publisher_;
-};
\ No newline at end of file
+  AudioElementUpdateData() {
+    x = 0;
+    y = 0;
+    z = 0;
+    loudness = 0;
+    memcpy(uuid.data(), juce::Uuid().getRawData(), 16);
+    strcpy(name, "");
+  }
+};
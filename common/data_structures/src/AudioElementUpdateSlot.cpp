@@ -0,0 +1,92 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AudioElementUpdateSlot.h"
+
+#include <cmath>
+#include <cstring>
+
+AudioElementUpdateSlot::AudioElementUpdateSlot() {
+  for (auto& description : descriptions_) {
+    description.uuid.fill(0);
+    description.name[0] = '\0';
+  }
+}
+
+void AudioElementUpdateSlot::setLoudness(const float loudness) {
+  loudness_.store(loudness, std::memory_order_relaxed);
+}
+
+void AudioElementUpdateSlot::setX(const float x) {
+  x_.store(x, std::memory_order_relaxed);
+}
+
+void AudioElementUpdateSlot::setY(const float y) {
+  y_.store(y, std::memory_order_relaxed);
+}
+
+void AudioElementUpdateSlot::setZ(const float z) {
+  z_.store(z, std::memory_order_relaxed);
+}
+
+void AudioElementUpdateSlot::setDescription(const juce::Uuid& id,
+                                            const juce::String& name) {
+  const uint32_t version = descriptionVersion_.load(std::memory_order_relaxed);
+  // Order the writes below after the previous publication, so a reader that
+  // sees any of them also sees the version move.
+  std::atomic_thread_fence(std::memory_order_release);
+
+  Description& next = descriptions_[(version + 1) & 1];
+  std::memcpy(next.uuid.data(), id.getRawData(), next.uuid.size());
+  std::strncpy(next.name, name.toRawUTF8(), sizeof(next.name));
+  next.name[sizeof(next.name) - 1] = '\0';
+  descriptionVersion_.store(version + 1, std::memory_order_release);
+}
+
+AudioElementUpdateData AudioElementUpdateSlot::read() const {
+  AudioElementUpdateData data;
+  data.loudness = loudness_.load(std::memory_order_relaxed);
+  data.x = x_.load(std::memory_order_relaxed);
+  data.y = y_.load(std::memory_order_relaxed);
+  data.z = z_.load(std::memory_order_relaxed);
+
+  // The published buffer is only rewritten after another one has been
+  // published, so an unchanged version means the copy is intact.
+  Description description;
+  while (true) {
+    const uint32_t version =
+        descriptionVersion_.load(std::memory_order_acquire);
+    std::memcpy(&description, &descriptions_[version & 1],
+                sizeof(Description));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (descriptionVersion_.load(std::memory_order_relaxed) == version) {
+      break;
+    }
+  }
+  data.uuid = description.uuid;
+  std::memcpy(data.name, description.name, sizeof(data.name));
+  return data;
+}
+
+bool AudioElementUpdateSlot::differs(const AudioElementUpdateData& previous,
+                                     const AudioElementUpdateData& current,
+                                     const float loudnessThresholdDb,
+                                     const float positionThreshold) {
+  return std::abs(current.loudness - previous.loudness) > loudnessThresholdDb ||
+         std::abs(current.x - previous.x) > positionThreshold ||
+         std::abs(current.y - previous.y) > positionThreshold ||
+         std::abs(current.z - previous.z) > positionThreshold ||
+         current.uuid != previous.uuid ||
+         std::strncmp(current.name, previous.name, sizeof(current.name)) != 0;
+}
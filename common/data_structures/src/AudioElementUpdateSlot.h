@@ -0,0 +1,94 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "AudioElementUpdateData.h"
+
+/**
+ * @brief Latest telemetry of one element plugin instance, written by the
+ * plugin and sampled by the messaging thread.
+ *
+ * Only the most recent value of each field is kept, so any number of writes
+ * between two samples cost one message. Loudness and position are plain
+ * atomics and may be written from the audio thread. The name and UUID change
+ * rarely and are double-buffered behind a version counter: the writer fills
+ * the inactive buffer and publishes it, and a reader retries if the version
+ * moved while it was copying.
+ */
+class AudioElementUpdateSlot {
+ public:
+  AudioElementUpdateSlot();
+
+  //============================================================================
+  // Writers. Wait-free and allocation-free.
+  void setLoudness(const float loudness);
+  void setX(const float x);
+  void setY(const float y);
+  void setZ(const float z);
+  // Count a block of audio processed by the instance. Instances the host
+  // stopped processing are left to age out of the renderer.
+  void addProcessedBlock() {
+    processedBlocks_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Must only be called from one thread at a time.
+  void setDescription(const juce::Uuid& id, const juce::String& name);
+
+  //============================================================================
+  // Reader.
+
+  // False until the first setDescription(), before which there is nothing
+  // identifying the instance to send.
+  bool hasDescription() const {
+    return descriptionVersion_.load(std::memory_order_acquire) != 0;
+  }
+
+  // A consistent copy of the latest values.
+  AudioElementUpdateData read() const;
+
+  // Blocks counted so far. Only compare it with an earlier value.
+  uint32_t getProcessedBlocks() const {
+    return processedBlocks_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief True if current differs enough from previous to be worth sending.
+   * Loudness and position changes within the thresholds are ignored, any
+   * change of UUID or name is not.
+   */
+  static bool differs(const AudioElementUpdateData& previous,
+                      const AudioElementUpdateData& current,
+                      const float loudnessThresholdDb,
+                      const float positionThreshold);
+
+ private:
+  struct Description {
+    std::array<char, 16> uuid;
+    char name[64];
+  };
+
+  std::atomic<float> loudness_{-70.f};
+  std::atomic<float> x_{0.f}, y_{0.f}, z_{0.f};
+  Description descriptions_[2];
+  std::atomic<uint32_t> descriptionVersion_{0};
+  std::atomic<uint32_t> processedBlocks_{0};
+};
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "MeteringConsumers.h"
 #include "RealtimeDataType.h"
 
 struct ChannelMonitorData {
@@ -24,4 +25,6 @@ struct ChannelMonitorData {
   }
   std::atomic_bool resetStats;
   RealtimeDataType<std::vector<float>> channelLoudnesses;
+  // UI components showing the channel meters.
+  MeteringConsumers consumers;
 };
\ No newline at end of file
@@ -37,7 +37,14 @@ FileExport::FileExport()
       lpcm_sample_size_(24),
       sample_tally_(0),
       profile_(FileProfile::BASE),
-      exportCompleted_(true) {}
+      exportCompleted_(true),
+      muxProgress_(1.f),
+      exportCancelled_(false),
+      droppedSamples_(0),
+      exportSummary_(""),
+      incrementalExport_(false),
+      dirtyStartTime_(0),
+      dirtyEndTime_(0) {}
 
 FileExport::FileExport(int startTime, int endTime, juce::String exportFile,
                        juce::String exportFolder,
@@ -68,10 +75,17 @@ FileExport::FileExport(int startTime, int endTime, juce::String exportFile,
       opus_total_bitrate_(opus_total_bitrate),
       lpcm_sample_size_(lpcm_sample_size),
       sample_tally_(0),
-      exportCompleted_(exportCompleted) {}
+      exportCompleted_(exportCompleted),
+      muxProgress_(1.f),
+      exportCancelled_(false),
+      droppedSamples_(0),
+      exportSummary_(""),
+      incrementalExport_(false),
+      dirtyStartTime_(0),
+      dirtyEndTime_(0) {}
 
 FileExport FileExport::fromTree(const juce::ValueTree tree) {
-  return FileExport(
+  FileExport fileExport(
       tree[kStartTime], tree[kEndTime], tree[kExportFile], tree[kExportFolder],
       (AudioFileFormat)(int)tree[kAudioFileFormat],
       (AudioCodec)(int)tree[kAudioCodec], tree[kBitDepth], tree[kSampleRate],
@@ -79,6 +93,14 @@ FileExport FileExport::fromTree(const juce::ValueTree tree) {
       tree[kVideoSource], tree[kVideoExportFolder], tree[kManualExport],
       (FileProfile)(int)tree[kProfile], tree[kFlacCompressionLevel],
       tree[kOpusTotalBitrate], tree[kLPCMSampleSize], tree[kExportCompleted]);
+  fileExport.setMuxProgress(tree.getProperty(kMuxProgress, 1.f));
+  fileExport.setExportCancelled(tree.getProperty(kExportCancelled, false));
+  fileExport.setDroppedSamples(tree.getProperty(kDroppedSamples, 0));
+  fileExport.setExportSummary(tree.getProperty(kExportSummary, ""));
+  fileExport.setIncrementalExport(tree.getProperty(kIncrementalExport, false));
+  fileExport.setDirtyStartTime(tree.getProperty(kDirtyStartTime, 0.0));
+  fileExport.setDirtyEndTime(tree.getProperty(kDirtyEndTime, 0.0));
+  return fileExport;
 }
 
 juce::ValueTree FileExport::toValueTree() const {
@@ -102,7 +124,14 @@ juce::ValueTree FileExport::toValueTree() const {
            {kOpusTotalBitrate, opus_total_bitrate_},
            {kLPCMSampleSize, lpcm_sample_size_},
            {kSampleTally, static_cast<juce::int64>(sample_tally_)},
-           {kExportCompleted, exportCompleted_}}};
+           {kExportCompleted, exportCompleted_},
+           {kMuxProgress, muxProgress_},
+           {kExportCancelled, exportCancelled_},
+           {kDroppedSamples, droppedSamples_},
+           {kExportSummary, exportSummary_},
+           {kIncrementalExport, incrementalExport_},
+           {kDirtyStartTime, dirtyStartTime_},
+           {kDirtyEndTime, dirtyEndTime_}}};
 }
 
 juce::String FileExport::expandTildePath(const juce::String& path) {
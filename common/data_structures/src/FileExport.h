@@ -133,4 +133,21 @@ class FileExport final : public RepositoryItemBase {
   EXPORT_VALUE(int, lpcm_sample_size, LPCMSampleSize);
   EXPORT_VALUE(long, sample_tally, SampleTally);
   EXPORT_VALUE(bool, exportCompleted, ExportCompleted);
+  // Fraction of the post-bounce video mux done, from 0 to 1
+  EXPORT_VALUE(float, muxProgress, MuxProgress);
+  // The user cancelled the post-bounce work of the last export
+  EXPORT_VALUE(bool, exportCancelled, ExportCancelled);
+  // Samples the last WAV export dropped because the disk fell behind
+  EXPORT_VALUE(juce::int64, droppedSamples, DroppedSamples);
+  // Throughput of the last export, as shown to the user
+  EXPORT_VALUE(juce::String, exportSummary, ExportSummary);
+  // Re-encode only the dirty range of the previous IAMF export and splice it
+  // into that file. The range is in seconds of the session, like startTime
+  // and endTime, but fractional, as edits rarely fall on whole seconds. It is
+  // rounded out to whole frames. The export screen has no control for it: it
+  // is set through the repository by whatever tracks the edits made since the
+  // previous export, before the next bounce.
+  EXPORT_VALUE(bool, incrementalExport, IncrementalExport);
+  EXPORT_VALUE(double, dirtyStartTime, DirtyStartTime);
+  EXPORT_VALUE(double, dirtyEndTime, DirtyEndTime);
 };
@@ -0,0 +1,315 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LoudnessTimeline.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+enum TimelineMetric { kMomentaryMetric = 0, kShortTermMetric, kTruePeakMetric };
+
+const char* const kTimelineMetricNames[] = {"momentary", "short_term",
+                                            "true_peak"};
+
+// Guards against 0.3 / 0.1 evaluating to 2.9999... when mapping times to
+// node indices.
+constexpr double kIndexEpsilon = 1e-6;
+
+float sanitiseTimelineValue(const float value) {
+  return std::isnan(value) || value < LoudnessTimeline::kFloor
+             ? LoudnessTimeline::kFloor
+             : value;
+}
+}  // namespace
+
+LoudnessTimeline::LoudnessTimeline(const int maxPoints, const int fifoSize)
+    : fifo_(fifoSize), queue_(fifoSize), kMaxPoints_(std::max(2, maxPoints)) {
+  levels_.emplace_back();
+  levels_[0].reserve(kMaxPoints_);
+
+  // Drain periodically so history is kept while no editor is open. Without a
+  // message loop (e.g. in tests) the owner drains explicitly.
+  if (juce::MessageManager::getInstanceWithoutCreating() != nullptr) {
+    startTimer(250);
+  }
+}
+
+LoudnessTimeline::~LoudnessTimeline() { stopTimer(); }
+
+bool LoudnessTimeline::push(const LoudnessTimelinePoint& point) {
+  int start1, size1, start2, size2;
+  fifo_.prepareToWrite(1, start1, size1, start2, size2);
+  if (size1 + size2 == 0) {
+    droppedPoints_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  const int index = size1 > 0 ? start1 : start2;
+  queue_[index] = {point, producerSession_.load(std::memory_order_relaxed)};
+  fifo_.finishedWrite(1);
+  return true;
+}
+
+void LoudnessTimeline::restart() {
+  producerSession_.fetch_add(1, std::memory_order_relaxed);
+  droppedPoints_.store(0, std::memory_order_relaxed);
+}
+
+int LoudnessTimeline::drain() {
+  int start1, size1, start2, size2;
+  const int numReady = fifo_.getNumReady();
+  fifo_.prepareToRead(numReady, start1, size1, start2, size2);
+
+  auto consume = [this](const int start, const int size) {
+    for (int i = start; i < start + size; ++i) {
+      // A new session discards everything measured before it.
+      if (queue_[i].session != consumerSession_) {
+        clear();
+        consumerSession_ = queue_[i].session;
+      }
+      append(queue_[i].point);
+    }
+  };
+  consume(start1, size1);
+  consume(start2, size2);
+
+  fifo_.finishedRead(size1 + size2);
+  return size1 + size2;
+}
+
+void LoudnessTimeline::clear() {
+  levels_.resize(1);
+  levels_[0].clear();
+  basePointsPerNode_ = 1;
+  numPoints_ = 0;
+}
+
+double LoudnessTimeline::getResolutionSeconds() const {
+  return basePointsPerNode_ * kIntervalSeconds;
+}
+
+double LoudnessTimeline::getDurationSeconds() const {
+  return numPoints_ * kIntervalSeconds;
+}
+
+LoudnessTimeline::Node LoudnessTimeline::makeNode(
+    const LoudnessTimelinePoint& point) {
+  const std::array<float, 3> values = {
+      sanitiseTimelineValue(point.momentary),
+      sanitiseTimelineValue(point.shortTerm),
+      sanitiseTimelineValue(point.truePeak)};
+  return {values, values, {values[0], values[1], values[2]}, 1};
+}
+
+void LoudnessTimeline::combine(Node& into, const Node& from) {
+  for (int m = 0; m < 3; ++m) {
+    into.min[m] = std::min(into.min[m], from.min[m]);
+    into.max[m] = std::max(into.max[m], from.max[m]);
+    into.sum[m] += from.sum[m];
+  }
+  into.count += from.count;
+}
+
+LoudnessTimeline::Range LoudnessTimeline::getRange(const Node& node,
+                                                   const int metric) {
+  if (node.count == 0) {
+    return {kFloor, kFloor, kFloor};
+  }
+  return {node.min[metric], node.max[metric],
+          (float)(node.sum[metric] / node.count)};
+}
+
+void LoudnessTimeline::append(const LoudnessTimelinePoint& point) {
+  const Node node = makeNode(point);
+
+  // Extend the node covering this measurement on every level.
+  for (size_t k = 0; k < levels_.size(); ++k) {
+    const uint64_t pointsPerNode = (uint64_t)basePointsPerNode_ << k;
+    const uint64_t index = numPoints_ / pointsPerNode;
+    if (index == levels_[k].size()) {
+      levels_[k].push_back(node);
+    } else {
+      combine(levels_[k].back(), node);
+    }
+  }
+  ++numPoints_;
+
+  // Keep a single node at the top so every range has a decomposition.
+  if (levels_.back().size() > 1) {
+    Node top = levels_.back()[0];
+    combine(top, levels_.back()[1]);
+    levels_.push_back({top});
+  }
+
+  if ((int)levels_[0].size() > kMaxPoints_) {
+    discardFinestLevel();
+  }
+}
+
+void LoudnessTimeline::discardFinestLevel() {
+  levels_.erase(levels_.begin());
+  basePointsPerNode_ *= 2;
+  levels_[0].reserve(kMaxPoints_);
+}
+
+LoudnessTimeline::Summary LoudnessTimeline::getSummary(
+    double startSeconds, double endSeconds) const {
+  const double resolution = getResolutionSeconds();
+  const double duration = getDurationSeconds();
+  startSeconds = std::max(0.0, startSeconds);
+  endSeconds = std::min(duration, endSeconds);
+
+  Node total{{kFloor, kFloor, kFloor}, {kFloor, kFloor, kFloor}, {}, 0};
+  if (startSeconds >= duration || endSeconds <= startSeconds) {
+    return {startSeconds, std::max(startSeconds, endSeconds),
+            getRange(total, kMomentaryMetric),
+            getRange(total, kShortTermMetric),
+            getRange(total, kTruePeakMetric)};
+  }
+
+  const size_t numNodes = levels_[0].size();
+  size_t first = std::min(
+      numNodes - 1, (size_t)std::floor(startSeconds / resolution +
+                                       kIndexEpsilon));
+  size_t last = std::min(
+      numNodes,
+      (size_t)std::ceil(endSeconds / resolution - kIndexEpsilon));
+  // Ranges finer than the resolution read the node containing them.
+  last = std::max(last, first + 1);
+
+  const double summaryStart = first * resolution;
+  const double summaryEnd = std::min(duration, last * resolution);
+
+  // Walk up the levels, taking the unpaired node at either end of the range
+  // before halving it. At most two nodes are read per level.
+  bool empty = true;
+  auto add = [&](const Node& node) {
+    if (empty) {
+      total = node;
+      empty = false;
+    } else {
+      combine(total, node);
+    }
+  };
+  for (size_t k = 0; first < last && k < levels_.size(); ++k) {
+    if (first & 1) {
+      add(levels_[k][first++]);
+    }
+    if (last & 1) {
+      add(levels_[k][--last]);
+    }
+    first >>= 1;
+    last >>= 1;
+  }
+
+  return {summaryStart, summaryEnd, getRange(total, kMomentaryMetric),
+          getRange(total, kShortTermMetric), getRange(total, kTruePeakMetric)};
+}
+
+std::vector<LoudnessTimeline::Summary> LoudnessTimeline::getSummaries(
+    const double startSeconds, const double endSeconds,
+    const int numSummaries) const {
+  std::vector<Summary> summaries;
+  if (numSummaries <= 0 || endSeconds <= startSeconds) {
+    return summaries;
+  }
+  summaries.reserve(numSummaries);
+  const double step = (endSeconds - startSeconds) / numSummaries;
+  for (int i = 0; i < numSummaries; ++i) {
+    summaries.push_back(getSummary(startSeconds + i * step,
+                                   startSeconds + (i + 1) * step));
+  }
+  return summaries;
+}
+
+std::vector<LoudnessTimeline::Summary> LoudnessTimeline::getExportSummaries(
+    double resolutionSeconds) const {
+  resolutionSeconds = std::max(resolutionSeconds, getResolutionSeconds());
+  const int numSummaries = (int)std::ceil(
+      getDurationSeconds() / resolutionSeconds - kIndexEpsilon);
+  std::vector<Summary> summaries;
+  summaries.reserve(numSummaries);
+  for (int i = 0; i < numSummaries; ++i) {
+    summaries.push_back(getSummary(i * resolutionSeconds,
+                                   (i + 1) * resolutionSeconds));
+  }
+  return summaries;
+}
+
+juce::String LoudnessTimeline::toCSV(const double resolutionSeconds) const {
+  juce::MemoryOutputStream out;
+  out << "start_s,end_s";
+  for (const char* name : kTimelineMetricNames) {
+    out << "," << name << "_min," << name << "_max," << name << "_mean";
+  }
+  out << "\n";
+
+  for (const Summary& summary : getExportSummaries(resolutionSeconds)) {
+    out << juce::String(summary.startSeconds, 1) << ","
+        << juce::String(summary.endSeconds, 1);
+    for (const Range& range :
+         {summary.momentary, summary.shortTerm, summary.truePeak}) {
+      out << "," << juce::String(range.min, 2) << ","
+          << juce::String(range.max, 2) << "," << juce::String(range.mean, 2);
+    }
+    out << "\n";
+  }
+  return out.toString();
+}
+
+juce::String LoudnessTimeline::toJSON(const double resolutionSeconds) const {
+  auto toVar = [](const Range& range) {
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("min", range.min);
+    obj->setProperty("max", range.max);
+    obj->setProperty("mean", range.mean);
+    return juce::var(obj);
+  };
+
+  juce::Array<juce::var> points;
+  for (const Summary& summary : getExportSummaries(resolutionSeconds)) {
+    auto* point = new juce::DynamicObject();
+    point->setProperty("start_s", summary.startSeconds);
+    point->setProperty("end_s", summary.endSeconds);
+    point->setProperty(kTimelineMetricNames[kMomentaryMetric],
+                       toVar(summary.momentary));
+    point->setProperty(kTimelineMetricNames[kShortTermMetric],
+                       toVar(summary.shortTerm));
+    point->setProperty(kTimelineMetricNames[kTruePeakMetric],
+                       toVar(summary.truePeak));
+    points.add(juce::var(point));
+  }
+
+  auto* root = new juce::DynamicObject();
+  root->setProperty("duration_s", getDurationSeconds());
+  root->setProperty("resolution_s",
+                    std::max(resolutionSeconds, getResolutionSeconds()));
+  root->setProperty("dropped_points", getNumDroppedPoints());
+  root->setProperty("points", points);
+  return juce::JSON::toString(juce::var(root));
+}
+
+juce::File LoudnessTimeline::getCSVReportFile(const juce::String& exportFile) {
+  return juce::File(exportFile + ".loudness.csv");
+}
+
+juce::File LoudnessTimeline::getJSONReportFile(
+    const juce::String& exportFile) {
+  return juce::File(exportFile + ".loudness.json");
+}
+
+bool LoudnessTimeline::writeReport(const juce::String& exportFile) const {
+  return getCSVReportFile(exportFile).replaceWithText(toCSV()) &&
+         getJSONReportFile(exportFile).replaceWithText(toJSON());
+}
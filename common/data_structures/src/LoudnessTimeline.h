@@ -0,0 +1,153 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// One loudness measurement taken every LoudnessTimeline::kIntervalSeconds.
+struct LoudnessTimelinePoint {
+  float momentary, shortTerm, truePeak;
+};
+
+/**
+ * @brief Whole-program loudness history for graphing and reporting.
+ *
+ * The audio thread pushes 100 ms measurements into a wait-free single
+ * producer, single consumer FIFO. The FIFO is drained on the message thread
+ * into a mip-mapped store where every level summarises pairs of nodes from
+ * the level below as min/max/mean. Range queries therefore touch at most two
+ * nodes per level.
+ *
+ * Memory is bounded: once the finest level holds maxPoints nodes it is
+ * discarded and the next level becomes the finest, halving the time
+ * resolution of the retained history.
+ *
+ * push() and restart() may be called from the audio thread. Everything else
+ * must be called from a single consumer thread, normally the message thread.
+ */
+class LoudnessTimeline : private juce::Timer {
+ public:
+  static constexpr double kIntervalSeconds = 0.1;
+  // Values below this, including silence and invalid readings, are stored as
+  // the floor so that means stay finite.
+  static constexpr float kFloor = -120.f;
+
+  struct Range {
+    float min, max, mean;
+  };
+
+  struct Summary {
+    double startSeconds, endSeconds;
+    Range momentary, shortTerm, truePeak;
+  };
+
+  /**
+   * @param maxPoints Finest-level nodes kept before the resolution is halved.
+   * The default keeps 100 ms resolution for about 1.8 hours.
+   * @param fifoSize Measurements buffered between drains.
+   */
+  LoudnessTimeline(const int maxPoints = 1 << 16, const int fifoSize = 1024);
+  ~LoudnessTimeline() override;
+
+  //============================================================================
+  // Producer side (audio thread).
+
+  // Queue a measurement. Returns false and counts a drop if the FIFO is full.
+  bool push(const LoudnessTimelinePoint& point);
+
+  // Begin a new measurement session. The store is cleared on the next drain,
+  // before any measurement pushed after this call is added.
+  void restart();
+
+  //============================================================================
+  // Consumer side.
+
+  // Move queued measurements into the store. Returns the number added.
+  int drain();
+
+  // Remove all measurements from the store.
+  void clear();
+
+  // Duration of a node at the finest retained level.
+  double getResolutionSeconds() const;
+  double getDurationSeconds() const;
+  int getNumDroppedPoints() const { return droppedPoints_.load(); }
+  bool isEmpty() const { return numPoints_ == 0; }
+
+  // Summary of [startSeconds, endSeconds), clamped to the stored duration.
+  Summary getSummary(double startSeconds, double endSeconds) const;
+
+  // numSummaries consecutive summaries evenly dividing the range, e.g. one per
+  // pixel column of a graph.
+  std::vector<Summary> getSummaries(const double startSeconds,
+                                    const double endSeconds,
+                                    const int numSummaries) const;
+
+  /**
+   * @brief Export the history at the given resolution. A resolution of zero
+   * or less exports the finest retained level.
+   */
+  juce::String toCSV(const double resolutionSeconds = 0.0) const;
+  juce::String toJSON(const double resolutionSeconds = 0.0) const;
+
+  // The loudness report of an export, written next to exportFile beside its
+  // export stats report.
+  static juce::File getCSVReportFile(const juce::String& exportFile);
+  static juce::File getJSONReportFile(const juce::String& exportFile);
+  bool writeReport(const juce::String& exportFile) const;
+
+ private:
+  struct Node {
+    std::array<float, 3> min, max;
+    std::array<double, 3> sum;
+    uint32_t count;
+  };
+
+  struct QueuedPoint {
+    LoudnessTimelinePoint point;
+    uint32_t session;
+  };
+
+  static Node makeNode(const LoudnessTimelinePoint& point);
+  static void combine(Node& into, const Node& from);
+  static Range getRange(const Node& node, const int metric);
+
+  void timerCallback() override { drain(); }
+
+  void append(const LoudnessTimelinePoint& point);
+  void discardFinestLevel();
+  std::vector<Summary> getExportSummaries(double resolutionSeconds) const;
+
+  // FIFO between the audio thread and the consumer.
+  juce::AbstractFifo fifo_;
+  std::vector<QueuedPoint> queue_;
+  std::atomic<uint32_t> producerSession_{0};
+  std::atomic<int> droppedPoints_{0};
+
+  // Mip-mapped store. levels_[0] is the finest retained level and each node
+  // of levels_[k] covers (basePointsPerNode_ << k) measurements.
+  const int kMaxPoints_;
+  std::vector<std::vector<Node>> levels_;
+  uint32_t basePointsPerNode_ = 1;
+  uint64_t numPoints_ = 0;
+  uint32_t consumerSession_ = 0;
+};
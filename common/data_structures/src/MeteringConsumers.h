@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+
+/**
+ * @brief Counts the UI components currently displaying a set of meter data.
+ *
+ * Processors that only measure to feed meters check isWatched() and skip
+ * their work while it is false. Components hold a Registration for as long
+ * as they display the data.
+ */
+class MeteringConsumers {
+ public:
+  class Registration {
+   public:
+    explicit Registration(MeteringConsumers& consumers)
+        : consumers_(consumers) {
+      consumers_.count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    ~Registration() {
+      consumers_.count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    Registration(const Registration&) = delete;
+    Registration& operator=(const Registration&) = delete;
+
+   private:
+    MeteringConsumers& consumers_;
+  };
+
+  bool isWatched() const {
+    return count_.load(std::memory_order_relaxed) > 0;
+  }
+
+ private:
+  std::atomic<int> count_{0};
+};
@@ -0,0 +1,543 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "RepositorySync.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+enum SyncOp : uint8_t {
+  kSetProperty = 1,
+  kRemoveProperty,
+  kInsertChild,
+  kRemoveChild,
+  kReplaceRoot,
+};
+
+enum SyncValueType : uint8_t {
+  kVoidValue = 0,
+  kFalseValue,
+  kTrueValue,
+  kIntValue,
+  kInt64Value,
+  kDoubleValue,
+  kStringValue,
+  kBinaryValue,
+  kArrayValue,
+};
+
+// Deeper trees than this are rejected as malformed.
+constexpr int kMaxSyncTreeDepth = 64;
+
+//==============================================================================
+// Encoding. Integers are written 7 bits at a time, signed ones zigzag encoded
+// first so that small negative values stay short.
+void syncWriteVarUInt(juce::OutputStream& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.writeByte((char)((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.writeByte((char)value);
+}
+
+void syncWriteVarInt(juce::OutputStream& out, const int64_t value) {
+  syncWriteVarUInt(out, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+void syncWriteString(juce::OutputStream& out, const juce::String& string) {
+  const size_t numBytes = string.getNumBytesAsUTF8();
+  syncWriteVarUInt(out, numBytes);
+  out.write(string.toRawUTF8(), numBytes);
+}
+
+void syncWriteValue(juce::OutputStream& out, const juce::var& value) {
+  if (value.isVoid() || value.isUndefined()) {
+    out.writeByte(kVoidValue);
+  } else if (value.isBool()) {
+    out.writeByte((bool)value ? kTrueValue : kFalseValue);
+  } else if (value.isInt()) {
+    out.writeByte(kIntValue);
+    syncWriteVarInt(out, (int)value);
+  } else if (value.isInt64()) {
+    out.writeByte(kInt64Value);
+    syncWriteVarInt(out, (juce::int64)value);
+  } else if (value.isDouble()) {
+    out.writeByte(kDoubleValue);
+    out.writeDouble((double)value);
+  } else if (auto* block = value.getBinaryData()) {
+    out.writeByte(kBinaryValue);
+    syncWriteVarUInt(out, block->getSize());
+    out.write(block->getData(), block->getSize());
+  } else if (auto* array = value.getArray()) {
+    out.writeByte(kArrayValue);
+    syncWriteVarUInt(out, (uint64_t)array->size());
+    for (const auto& element : *array) {
+      syncWriteValue(out, element);
+    }
+  } else {
+    // Strings, and anything else a property could hold, travel as text.
+    out.writeByte(kStringValue);
+    syncWriteString(out, value.toString());
+  }
+}
+
+void syncWriteTree(juce::OutputStream& out, const juce::ValueTree& tree) {
+  if (!tree.isValid()) {
+    syncWriteString(out, {});
+    return;
+  }
+  syncWriteString(out, tree.getType().toString());
+  syncWriteVarUInt(out, (uint64_t)tree.getNumProperties());
+  for (int i = 0; i < tree.getNumProperties(); ++i) {
+    const juce::Identifier name = tree.getPropertyName(i);
+    syncWriteString(out, name.toString());
+    syncWriteValue(out, tree.getProperty(name));
+  }
+  syncWriteVarUInt(out, (uint64_t)tree.getNumChildren());
+  for (const auto& child : tree) {
+    syncWriteTree(out, child);
+  }
+}
+
+void syncWriteHeader(juce::OutputStream& out,
+                     const RepositorySync::MessageType type,
+                     const uint32_t sequence) {
+  out.writeByte((char)RepositorySync::kProtocolVersion);
+  out.writeByte((char)type);
+  syncWriteVarUInt(out, sequence);
+}
+
+// Accumulates patch operations, each addressed by the child indices leading
+// from the root to the tree it applies to.
+struct SyncPatchWriter {
+  juce::MemoryOutputStream ops;
+  std::vector<int> path;
+  uint32_t numOps = 0;
+
+  void begin(const SyncOp op) {
+    ops.writeByte((char)op);
+    syncWriteVarUInt(ops, path.size());
+    for (const int index : path) {
+      syncWriteVarUInt(ops, (uint64_t)index);
+    }
+    ++numOps;
+  }
+};
+
+// Emit the operations turning shadow into state, applying each one to shadow
+// as it goes.
+void syncDiffTree(juce::ValueTree& shadow, const juce::ValueTree& state,
+                  SyncPatchWriter& writer) {
+  for (int i = shadow.getNumProperties(); --i >= 0;) {
+    const juce::Identifier name = shadow.getPropertyName(i);
+    if (!state.hasProperty(name)) {
+      writer.begin(kRemoveProperty);
+      syncWriteString(writer.ops, name.toString());
+      shadow.removeProperty(name, nullptr);
+    }
+  }
+  for (int i = 0; i < state.getNumProperties(); ++i) {
+    const juce::Identifier name = state.getPropertyName(i);
+    const juce::var& value = state.getProperty(name);
+    const juce::var* previous = shadow.getPropertyPointer(name);
+    if (previous == nullptr || !previous->equalsWithSameType(value)) {
+      writer.begin(kSetProperty);
+      syncWriteString(writer.ops, name.toString());
+      syncWriteValue(writer.ops, value);
+      shadow.setProperty(name, value, nullptr);
+    }
+  }
+
+  const int numShared =
+      std::min(shadow.getNumChildren(), state.getNumChildren());
+  for (int i = 0; i < numShared; ++i) {
+    juce::ValueTree shadowChild = shadow.getChild(i);
+    const juce::ValueTree stateChild = state.getChild(i);
+    if (shadowChild.getType() == stateChild.getType()) {
+      writer.path.push_back(i);
+      syncDiffTree(shadowChild, stateChild, writer);
+      writer.path.pop_back();
+    } else {
+      writer.begin(kRemoveChild);
+      syncWriteVarUInt(writer.ops, (uint64_t)i);
+      writer.begin(kInsertChild);
+      syncWriteVarUInt(writer.ops, (uint64_t)i);
+      syncWriteTree(writer.ops, stateChild);
+      shadow.removeChild(i, nullptr);
+      shadow.addChild(stateChild.createCopy(), i, nullptr);
+    }
+  }
+  for (int i = numShared; i < state.getNumChildren(); ++i) {
+    writer.begin(kInsertChild);
+    syncWriteVarUInt(writer.ops, (uint64_t)i);
+    syncWriteTree(writer.ops, state.getChild(i));
+    shadow.appendChild(state.getChild(i).createCopy(), nullptr);
+  }
+  for (int i = shadow.getNumChildren(); --i >= state.getNumChildren();) {
+    writer.begin(kRemoveChild);
+    syncWriteVarUInt(writer.ops, (uint64_t)i);
+    shadow.removeChild(i, nullptr);
+  }
+}
+
+//==============================================================================
+// Decoding. Any malformed input marks the reader as failed rather than
+// throwing, and every read after a failure returns an empty value.
+class SyncReader {
+ public:
+  explicit SyncReader(const juce::MemoryBlock& message)
+      : in_(message, false) {}
+
+  bool failed() const { return failed_; }
+
+  uint8_t readByte() {
+    if (!require(1)) {
+      return 0;
+    }
+    return (uint8_t)in_.readByte();
+  }
+
+  uint64_t readVarUInt() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      const uint8_t byte = readByte();
+      value |= (uint64_t)(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    failed_ = true;
+    return 0;
+  }
+
+  int64_t readVarInt() {
+    const uint64_t value = readVarUInt();
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+  }
+
+  // Reads a count or index that must fit in an int.
+  int readIndex() {
+    const uint64_t value = readVarUInt();
+    if (value > (uint64_t)std::numeric_limits<int>::max()) {
+      failed_ = true;
+      return 0;
+    }
+    return (int)value;
+  }
+
+  juce::String readString() {
+    const juce::MemoryBlock bytes = readBlock();
+    return juce::String::fromUTF8((const char*)bytes.getData(),
+                                  (int)bytes.getSize());
+  }
+
+  // A length-prefixed run of bytes.
+  juce::MemoryBlock readBlock() {
+    const int numBytes = readIndex();
+    if (!require((size_t)numBytes)) {
+      return {};
+    }
+    juce::MemoryBlock block((size_t)numBytes);
+    in_.read(block.getData(), numBytes);
+    return block;
+  }
+
+  bool isExhausted() { return in_.getNumBytesRemaining() == 0; }
+
+  juce::var readValue(const int depth = 0) {
+    switch (readByte()) {
+      case kVoidValue:
+        return {};
+      case kFalseValue:
+        return false;
+      case kTrueValue:
+        return true;
+      case kIntValue:
+        return (int)readVarInt();
+      case kInt64Value:
+        return (juce::int64)readVarInt();
+      case kDoubleValue:
+        return require(sizeof(double)) ? in_.readDouble() : 0.0;
+      case kStringValue:
+        return readString();
+      case kBinaryValue:
+        return readBlock();
+      case kArrayValue: {
+        const int numElements = readIndex();
+        if (depth >= kMaxSyncTreeDepth || !require((size_t)numElements)) {
+          failed_ = true;
+          return {};
+        }
+        juce::Array<juce::var> array;
+        for (int i = 0; i < numElements && !failed_; ++i) {
+          array.add(readValue(depth + 1));
+        }
+        return array;
+      }
+      default:
+        failed_ = true;
+        return {};
+    }
+  }
+
+  juce::ValueTree readTree(const int depth = 0) {
+    const juce::String type = readString();
+    if (failed_ || type.isEmpty()) {
+      return {};
+    }
+    if (depth >= kMaxSyncTreeDepth) {
+      failed_ = true;
+      return {};
+    }
+    juce::ValueTree tree{juce::Identifier(type)};
+    const int numProperties = readIndex();
+    for (int i = 0; i < numProperties && !failed_; ++i) {
+      const juce::String name = readString();
+      const juce::var value = readValue();
+      if (name.isEmpty()) {
+        failed_ = true;
+      } else if (!failed_) {
+        tree.setProperty(name, value, nullptr);
+      }
+    }
+    const int numChildren = readIndex();
+    for (int i = 0; i < numChildren && !failed_; ++i) {
+      tree.appendChild(readTree(depth + 1), nullptr);
+    }
+    return tree;
+  }
+
+ private:
+  bool require(const size_t numBytes) {
+    if (failed_ || (size_t)in_.getNumBytesRemaining() < numBytes) {
+      failed_ = true;
+    }
+    return !failed_;
+  }
+
+  juce::MemoryInputStream in_;
+  bool failed_ = false;
+};
+
+// Apply one patch operation to state. Returns false if it does not fit the
+// tree, meaning the receiver is out of step.
+bool syncApplyOp(SyncReader& reader, juce::ValueTree& state) {
+  const uint8_t op = reader.readByte();
+  juce::ValueTree target = state;
+  const int depth = reader.readIndex();
+  for (int i = 0; i < depth && !reader.failed(); ++i) {
+    target = target.getChild(reader.readIndex());
+  }
+  if (reader.failed() || !target.isValid()) {
+    return false;
+  }
+
+  switch (op) {
+    case kSetProperty: {
+      const juce::String name = reader.readString();
+      const juce::var value = reader.readValue();
+      if (reader.failed() || name.isEmpty()) {
+        return false;
+      }
+      target.setProperty(name, value, nullptr);
+      return true;
+    }
+    case kRemoveProperty: {
+      const juce::String name = reader.readString();
+      if (reader.failed() || !target.hasProperty(name)) {
+        return false;
+      }
+      target.removeProperty(name, nullptr);
+      return true;
+    }
+    case kInsertChild: {
+      const int index = reader.readIndex();
+      const juce::ValueTree child = reader.readTree();
+      if (reader.failed() || !child.isValid() ||
+          index > target.getNumChildren()) {
+        return false;
+      }
+      target.addChild(child, index, nullptr);
+      return true;
+    }
+    case kRemoveChild: {
+      const int index = reader.readIndex();
+      if (reader.failed() || index >= target.getNumChildren()) {
+        return false;
+      }
+      target.removeChild(index, nullptr);
+      return true;
+    }
+    case kReplaceRoot: {
+      const juce::ValueTree root = reader.readTree();
+      if (reader.failed() || depth != 0) {
+        return false;
+      }
+      state = root;
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+namespace RepositorySync {
+//==============================================================================
+bool Sender::createPatch(const juce::ValueTree& state,
+                         juce::MemoryBlock& patch) {
+  SyncPatchWriter writer;
+  if (shadow_.isValid() && state.isValid() &&
+      shadow_.getType() == state.getType()) {
+    syncDiffTree(shadow_, state, writer);
+  } else if (shadow_.isValid() || state.isValid()) {
+    writer.begin(kReplaceRoot);
+    syncWriteTree(writer.ops, state);
+    shadow_ = state.createCopy();
+  }
+  if (writer.numOps == 0) {
+    return false;
+  }
+
+  ++sequence_;
+  juce::MemoryOutputStream out(patch, false);
+  syncWriteHeader(out, kPatch, sequence_);
+  syncWriteVarUInt(out, writer.numOps);
+  out.write(writer.ops.getData(), writer.ops.getDataSize());
+  out.flush();
+  return true;
+}
+
+juce::MemoryBlock Sender::createSnapshot() const {
+  juce::MemoryBlock snapshot;
+  juce::MemoryOutputStream out(snapshot, false);
+  syncWriteHeader(out, kSnapshot, sequence_);
+  syncWriteTree(out, shadow_);
+  out.flush();
+  return snapshot;
+}
+
+//==============================================================================
+Receiver::Result Receiver::apply(const juce::MemoryBlock& message,
+                                 juce::ValueTree& state) {
+  SyncReader reader(message);
+  const uint8_t version = reader.readByte();
+  const uint8_t type = reader.readByte();
+  const uint32_t sequence = (uint32_t)reader.readVarUInt();
+  // Nothing useful can be done with a peer speaking another version.
+  if (reader.failed() || version != kProtocolVersion) {
+    return Result::kIgnored;
+  }
+
+  auto requestResync = [this] {
+    synchronised_ = false;
+    if (awaitingSnapshot_) {
+      return Result::kIgnored;
+    }
+    awaitingSnapshot_ = true;
+    return Result::kResyncRequired;
+  };
+
+  if (type == kSnapshot) {
+    juce::ValueTree snapshot = reader.readTree();
+    if (reader.failed()) {
+      awaitingSnapshot_ = false;
+      return requestResync();
+    }
+    state = snapshot;
+    sequence_ = sequence;
+    synchronised_ = true;
+    awaitingSnapshot_ = false;
+    return Result::kApplied;
+  }
+
+  if (type != kPatch) {
+    return Result::kIgnored;
+  }
+  if (!synchronised_) {
+    return requestResync();
+  }
+  // Patches already covered by the current snapshot.
+  if ((int32_t)(sequence - sequence_) <= 0) {
+    return Result::kIgnored;
+  }
+  if (sequence != sequence_ + 1) {
+    return requestResync();
+  }
+
+  const int numOps = reader.readIndex();
+  for (int i = 0; i < numOps; ++i) {
+    if (!syncApplyOp(reader, state)) {
+      return requestResync();
+    }
+  }
+  if (reader.failed()) {
+    return requestResync();
+  }
+  sequence_ = sequence;
+  return Result::kApplied;
+}
+
+//==============================================================================
+juce::MemoryBlock createResyncRequest() {
+  juce::MemoryBlock request;
+  juce::MemoryOutputStream out(request, false);
+  syncWriteHeader(out, kResyncRequest, 0);
+  out.flush();
+  return request;
+}
+
+bool isResyncRequest(const juce::MemoryBlock& message) {
+  return message.getSize() >= 2 && (uint8_t)message[0] == kProtocolVersion &&
+         (uint8_t)message[1] == kResyncRequest;
+}
+
+juce::MemoryBlock createChannelClosed() {
+  juce::MemoryBlock closed;
+  juce::MemoryOutputStream out(closed, false);
+  syncWriteHeader(out, kChannelClosed, 0);
+  out.flush();
+  return closed;
+}
+
+bool isChannelClosed(const juce::MemoryBlock& message) {
+  return message.getSize() >= 2 && (uint8_t)message[0] == kProtocolVersion &&
+         (uint8_t)message[1] == kChannelClosed;
+}
+
+//==============================================================================
+void Bundle::add(const uint32_t channel, const juce::MemoryBlock& message) {
+  juce::MemoryOutputStream out(data_, true);
+  syncWriteVarUInt(out, channel);
+  syncWriteVarUInt(out, message.getSize());
+  out.write(message.getData(), message.getSize());
+  out.flush();
+}
+
+bool readBundle(
+    const juce::MemoryBlock& bundle,
+    const std::function<void(uint32_t, const juce::MemoryBlock&)>& callback) {
+  SyncReader reader(bundle);
+  while (!reader.isExhausted()) {
+    const uint32_t channel = (uint32_t)reader.readVarUInt();
+    const juce::MemoryBlock message = reader.readBlock();
+    if (reader.failed()) {
+      return false;
+    }
+    callback(channel, message);
+  }
+  return true;
+}
+}  // namespace RepositorySync
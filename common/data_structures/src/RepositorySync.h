@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Versioned delta protocol for mirroring a repository's ValueTree over
+ * an InterprocessConnection.
+ *
+ * Every message starts with a protocol version, a message type and a sequence
+ * number. A snapshot carries the whole tree and sets the receiver's sequence.
+ * A patch carries the property and child changes made since the previous
+ * message and must be numbered exactly one past the receiver's sequence. A
+ * receiver that misses a patch, or cannot apply one, asks the sender for a
+ * fresh snapshot with a resync request.
+ *
+ * Values and trees use a compact binary encoding: integers are written with
+ * the fewest bytes needed and only what changed is sent.
+ *
+ * Several repositories can share one connection. Each connection message is
+ * then a bundle of messages tagged with the channel they belong to, so
+ * changes to many repositories also travel together.
+ */
+namespace RepositorySync {
+constexpr uint8_t kProtocolVersion = 2;
+
+enum MessageType : uint8_t {
+  kSnapshot = 1,
+  kPatch,
+  kResyncRequest,
+  // The repository on this channel has gone away.
+  kChannelClosed,
+};
+
+// Encodes the changes made to a tree since they were last sent.
+class Sender {
+ public:
+  /**
+   * @brief Encode everything that changed in state since the previous patch
+   * as the next patch. Any number of edits to the tree between two calls are
+   * coalesced into a single patch.
+   *
+   * @return False, leaving patch untouched, if nothing changed.
+   */
+  bool createPatch(const juce::ValueTree& state, juce::MemoryBlock& patch);
+
+  // Encode the state as of the last patch. Peers receiving it are in step
+  // with the next patch.
+  juce::MemoryBlock createSnapshot() const;
+
+  uint32_t getSequence() const { return sequence_; }
+
+ private:
+  // The tree as peers last saw it. Updated in place while diffing.
+  juce::ValueTree shadow_;
+  uint32_t sequence_ = 0;
+};
+
+// Applies snapshots and patches to a local copy of a remote tree.
+class Receiver {
+ public:
+  enum class Result {
+    kApplied,
+    // A stale or unexpected message that was dropped.
+    kIgnored,
+    // The local copy is out of step. Send createResyncRequest() to the peer.
+    kResyncRequired,
+  };
+
+  /**
+   * @brief Apply a message to state. A snapshot or a root replacement may
+   * assign a new tree to state.
+   */
+  Result apply(const juce::MemoryBlock& message, juce::ValueTree& state);
+
+  bool isSynchronised() const { return synchronised_; }
+  uint32_t getSequence() const { return sequence_; }
+
+ private:
+  bool synchronised_ = false;
+  // Set once a resync has been requested so that patches arriving before the
+  // snapshot do not trigger further requests.
+  bool awaitingSnapshot_ = false;
+  uint32_t sequence_ = 0;
+};
+
+juce::MemoryBlock createResyncRequest();
+bool isResyncRequest(const juce::MemoryBlock& message);
+
+juce::MemoryBlock createChannelClosed();
+bool isChannelClosed(const juce::MemoryBlock& message);
+
+// Messages for several channels, sent as one connection message.
+class Bundle {
+ public:
+  void add(const uint32_t channel, const juce::MemoryBlock& message);
+  bool isEmpty() const { return data_.getSize() == 0; }
+  const juce::MemoryBlock& getData() const { return data_; }
+
+ private:
+  juce::MemoryBlock data_;
+};
+
+/**
+ * @brief Call back with each channel's message in a bundle, in order.
+ *
+ * @return False if the bundle is malformed. Messages before the fault have
+ * been delivered.
+ */
+bool readBundle(
+    const juce::MemoryBlock& bundle,
+    const std::function<void(uint32_t, const juce::MemoryBlock&)>& callback);
+}  // namespace RepositorySync
@@ -17,6 +17,7 @@
 #pragma once
 #include <processors/mix_monitoring/loudness_standards/MeasureEBU128.h>
 
+#include "MeteringConsumers.h"
 #include "RealtimeDataType.h"
 
 struct SpeakerMonitorData {
@@ -28,4 +29,7 @@ struct SpeakerMonitorData {
   RealtimeDataType<MeasureEBU128::LoudnessStats> loudnessEBU128;
   RealtimeDataType<std::vector<float>> playbackLoudness;
   RealtimeDataType<std::array<float, 2>> binauralLoudness;
+  // UI components showing the meters. Producers that only feed meters idle
+  // while there are none.
+  MeteringConsumers consumers;
 };
\ No newline at end of file
@@ -0,0 +1,83 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/AudioElementSharedMemory.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+// Data published for the given UUID, or an empty vector. Other processes may
+// share the segment, so only matching entries are collected.
+std::vector<AudioElementUpdateData> readFor(
+    const AudioElementSharedReader& reader, const juce::Uuid& id) {
+  std::vector<AudioElementUpdateData> found;
+  reader.getData([&](const AudioElementUpdateData& data) {
+    if (std::memcmp(data.uuid.data(), id.getRawData(), 16) == 0) {
+      found.push_back(data);
+    }
+  });
+  return found;
+}
+
+AudioElementUpdateData makeData(const juce::Uuid& id, const float x) {
+  AudioElementUpdateData data;
+  std::memcpy(data.uuid.data(), id.getRawData(), 16);
+  data.x = x;
+  data.loudness = -20.f;
+  std::strcpy(data.name, "Element");
+  return data;
+}
+}  // namespace
+
+TEST(test_element_shared_memory, publish_and_read) {
+  AudioElementSharedPublisher publisher;
+  AudioElementSharedReader reader;
+  ASSERT_TRUE(publisher.isOpen());
+  ASSERT_TRUE(reader.isOpen());
+
+  const juce::Uuid id;
+  // Claimed slots are hidden until written.
+  EXPECT_TRUE(readFor(reader, id).empty());
+
+  ASSERT_TRUE(publisher.publishData(makeData(id, 0.25f)));
+  auto found = readFor(reader, id);
+  ASSERT_EQ(found.size(), 1);
+  EXPECT_EQ(found[0].x, 0.25f);
+  EXPECT_STREQ(found[0].name, "Element");
+
+  // Updates are written in place.
+  publisher.publishData(makeData(id, 0.5f));
+  found = readFor(reader, id);
+  ASSERT_EQ(found.size(), 1);
+  EXPECT_EQ(found[0].x, 0.5f);
+}
+
+TEST(test_element_shared_memory, instances_own_separate_slots) {
+  AudioElementSharedReader reader;
+  const juce::Uuid idA, idB;
+  auto publisherA = std::make_unique<AudioElementSharedPublisher>();
+  AudioElementSharedPublisher publisherB;
+  publisherA->publishData(makeData(idA, 1.f));
+  publisherB.publishData(makeData(idB, 2.f));
+
+  EXPECT_EQ(readFor(reader, idA).size(), 1);
+  EXPECT_EQ(readFor(reader, idB).size(), 1);
+
+  // Destroying an instance releases its slot.
+  publisherA.reset();
+  EXPECT_TRUE(readFor(reader, idA).empty());
+  EXPECT_EQ(readFor(reader, idB).size(), 1);
+}
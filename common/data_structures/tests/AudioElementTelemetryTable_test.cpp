@@ -0,0 +1,106 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/AudioElementTelemetryTable.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+AudioElementUpdateData makeData(const float loudness) {
+  AudioElementUpdateData data;
+  data.loudness = loudness;
+  return data;
+}
+
+bool contains(const std::vector<AudioElementUpdateData>& entries,
+              const AudioElementUpdateData& data) {
+  return std::any_of(entries.begin(), entries.end(),
+                     [&](const AudioElementUpdateData& entry) {
+                       return entry.uuid == data.uuid &&
+                              entry.loudness == data.loudness;
+                     });
+}
+}  // namespace
+
+TEST(test_element_telemetry_table, replaces_by_uuid) {
+  AudioElementTelemetryTable table;
+  AudioElementUpdateData a = makeData(-20.f);
+  const AudioElementUpdateData b = makeData(-30.f);
+  ASSERT_TRUE(table.update(a, 1000));
+  ASSERT_TRUE(table.update(b, 1000));
+  a.loudness = -10.f;
+  ASSERT_TRUE(table.update(a, 1100));
+  EXPECT_EQ(table.size(), 2);
+
+  std::vector<AudioElementUpdateData> live;
+  table.getLive(live, 1200);
+  ASSERT_EQ(live.size(), 2u);
+  EXPECT_TRUE(contains(live, a));
+  EXPECT_TRUE(contains(live, b));
+}
+
+TEST(test_element_telemetry_table, stale_entries_age_out) {
+  AudioElementTelemetryTable table;
+  const AudioElementUpdateData gone = makeData(-20.f);
+  const AudioElementUpdateData alive = makeData(-30.f);
+  table.update(gone, 1000);
+  table.update(alive, 1000);
+  table.update(alive, 5000);
+
+  // Hidden from readers as soon as the heartbeat is too old
+  std::vector<AudioElementUpdateData> live;
+  table.getLive(live, 1000 + AudioElementTelemetryTable::kStaleMs + 1);
+  ASSERT_EQ(live.size(), 1u);
+  EXPECT_TRUE(contains(live, alive));
+
+  // And dropped by the next sweep
+  table.update(alive, 1000 + AudioElementTelemetryTable::kStaleMs + 1);
+  EXPECT_EQ(table.size(), 1);
+}
+
+TEST(test_element_telemetry_table, bounded_capacity) {
+  AudioElementTelemetryTable table;
+  std::vector<AudioElementUpdateData> entries;
+  for (int i = 0; i < AudioElementTelemetryTable::kCapacity; ++i) {
+    entries.push_back(makeData((float)i));
+    ASSERT_TRUE(table.update(entries.back(), 1000));
+  }
+  EXPECT_FALSE(table.update(makeData(1.f), 1000));
+
+  // Existing entries can still be updated while full
+  entries[7].loudness = -7.f;
+  EXPECT_TRUE(table.update(entries[7], 1000));
+
+  // Evicting stale entries makes room without disturbing the others
+  for (int i = 0; i < AudioElementTelemetryTable::kCapacity; i += 2) {
+    table.update(entries[i], 9000);
+  }
+  const AudioElementUpdateData late = makeData(2.f);
+  EXPECT_TRUE(table.update(late, 9000));
+  EXPECT_EQ(table.size(), AudioElementTelemetryTable::kCapacity / 2 + 1);
+
+  std::vector<AudioElementUpdateData> live;
+  table.getLive(live, 9000);
+  EXPECT_EQ(live.size(), AudioElementTelemetryTable::kCapacity / 2 + 1);
+  EXPECT_TRUE(contains(live, late));
+  for (int i = 0; i < AudioElementTelemetryTable::kCapacity; i += 2) {
+    EXPECT_TRUE(contains(live, entries[i]));
+  }
+
+  table.clear();
+  EXPECT_EQ(table.size(), 0);
+}
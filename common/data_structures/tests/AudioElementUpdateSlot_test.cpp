@@ -0,0 +1,106 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/AudioElementUpdateSlot.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+TEST(test_element_update_slot, keeps_latest_values) {
+  AudioElementUpdateSlot slot;
+  EXPECT_FALSE(slot.hasDescription());
+
+  const juce::Uuid id;
+  slot.setDescription(id, "Dialogue");
+  EXPECT_TRUE(slot.hasDescription());
+  for (int i = 0; i < 750; ++i) {
+    slot.setLoudness(-60.f + i * 0.01f);
+  }
+  slot.setX(1.f);
+  slot.setY(-2.f);
+  slot.setZ(3.f);
+
+  const AudioElementUpdateData data = slot.read();
+  EXPECT_FLOAT_EQ(data.loudness, -60.f + 749 * 0.01f);
+  EXPECT_EQ(data.x, 1.f);
+  EXPECT_EQ(data.y, -2.f);
+  EXPECT_EQ(data.z, 3.f);
+  EXPECT_EQ(std::memcmp(data.uuid.data(), id.getRawData(), 16), 0);
+  EXPECT_STREQ(data.name, "Dialogue");
+}
+
+TEST(test_element_update_slot, thresholds) {
+  AudioElementUpdateSlot slot;
+  slot.setDescription(juce::Uuid(), "Bed");
+  slot.setLoudness(-20.f);
+  const AudioElementUpdateData sent = slot.read();
+
+  // Sub-threshold jitter is not worth a message.
+  slot.setLoudness(-20.05f);
+  slot.setX(0.005f);
+  EXPECT_FALSE(AudioElementUpdateSlot::differs(sent, slot.read(), 0.1f, 0.01f));
+
+  slot.setLoudness(-20.5f);
+  EXPECT_TRUE(AudioElementUpdateSlot::differs(sent, slot.read(), 0.1f, 0.01f));
+  slot.setLoudness(-20.f);
+  slot.setZ(0.5f);
+  EXPECT_TRUE(AudioElementUpdateSlot::differs(sent, slot.read(), 0.1f, 0.01f));
+  slot.setZ(0.f);
+  slot.setX(0.f);
+
+  // Descriptions always count.
+  slot.setDescription(juce::Uuid(), "Bed");
+  EXPECT_TRUE(AudioElementUpdateSlot::differs(sent, slot.read(), 0.1f, 0.01f));
+}
+
+TEST(test_element_update_slot, counts_processed_blocks) {
+  AudioElementUpdateSlot slot;
+  const uint32_t kBefore = slot.getProcessedBlocks();
+  // Telemetry written outside processBlock is not audio activity.
+  slot.setX(1.f);
+  slot.setDescription(juce::Uuid(), "Bed");
+  EXPECT_EQ(slot.getProcessedBlocks(), kBefore);
+
+  slot.setLoudness(-20.f);
+  slot.addProcessedBlock();
+  EXPECT_NE(slot.getProcessedBlocks(), kBefore);
+}
+
+TEST(test_element_update_slot, descriptions_are_never_torn) {
+  AudioElementUpdateSlot slot;
+  const juce::Uuid first, second;
+  slot.setDescription(first, "first");
+
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    for (int i = 0; i < 20000; ++i) {
+      slot.setDescription(i & 1 ? first : second, i & 1 ? "first" : "second");
+    }
+    done = true;
+  });
+
+  while (!done) {
+    const AudioElementUpdateData data = slot.read();
+    const bool isFirst =
+        std::memcmp(data.uuid.data(), first.getRawData(), 16) == 0;
+    EXPECT_STREQ(data.name, isFirst ? "first" : "second");
+    if (!isFirst) {
+      EXPECT_EQ(std::memcmp(data.uuid.data(), second.getRawData(), 16), 0);
+    }
+  }
+  writer.join();
+}
@@ -0,0 +1,134 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/LoudnessTimeline.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+LoudnessTimelinePoint makePoint(const int i) {
+  // Deterministic, non-monotonic values.
+  const float v = -60.f + (float)((i * 37) % 50);
+  return {v, v - 1.f, v + 2.f};
+}
+}  // namespace
+
+TEST(test_loudness_timeline, range_queries_match_brute_force) {
+  LoudnessTimeline timeline(1 << 12, 1 << 12);
+  const int kNumPoints = 1000;
+  for (int i = 0; i < kNumPoints; ++i) {
+    ASSERT_TRUE(timeline.push(makePoint(i)));
+  }
+  ASSERT_EQ(timeline.drain(), kNumPoints);
+  EXPECT_DOUBLE_EQ(timeline.getDurationSeconds(), 100.0);
+
+  for (const auto& [first, last] : std::vector<std::pair<int, int>>{
+           {0, 1000}, {3, 4}, {1, 999}, {17, 513}, {500, 501}, {998, 1000}}) {
+    float min = 1e9f, max = -1e9f;
+    double sum = 0.0;
+    for (int i = first; i < last; ++i) {
+      min = std::min(min, makePoint(i).momentary);
+      max = std::max(max, makePoint(i).momentary);
+      sum += makePoint(i).momentary;
+    }
+    const auto summary = timeline.getSummary(first * 0.1, last * 0.1);
+    EXPECT_NEAR(summary.startSeconds, first * 0.1, 1e-9);
+    EXPECT_NEAR(summary.endSeconds, last * 0.1, 1e-9);
+    EXPECT_EQ(summary.momentary.min, min);
+    EXPECT_EQ(summary.momentary.max, max);
+    EXPECT_NEAR(summary.momentary.mean, sum / (last - first), 1e-3);
+    EXPECT_EQ(summary.shortTerm.max, max - 1.f);
+    EXPECT_EQ(summary.truePeak.min, min + 2.f);
+  }
+}
+
+TEST(test_loudness_timeline, memory_is_bounded) {
+  const int kMaxPoints = 64;
+  LoudnessTimeline timeline(kMaxPoints, 64);
+  float overallMax = -1e9f;
+  for (int i = 0; i < 1000; ++i) {
+    timeline.push(makePoint(i));
+    overallMax = std::max(overallMax, makePoint(i).momentary);
+    timeline.drain();
+  }
+  EXPECT_DOUBLE_EQ(timeline.getDurationSeconds(), 100.0);
+  // 1000 points need four halvings to fit 64 nodes.
+  EXPECT_DOUBLE_EQ(timeline.getResolutionSeconds(), 1.6);
+  EXPECT_EQ(timeline.getSummary(0.0, 100.0).momentary.max, overallMax);
+  EXPECT_EQ(timeline.getSummaries(0.0, 100.0, 10).size(), 10);
+}
+
+TEST(test_loudness_timeline, restart_and_overflow) {
+  LoudnessTimeline timeline(1024, 8);
+  for (int i = 0; i < 10; ++i) {
+    timeline.push(makePoint(i));
+  }
+  // One slot of the FIFO is always kept free.
+  EXPECT_EQ(timeline.getNumDroppedPoints(), 3);
+  EXPECT_EQ(timeline.drain(), 7);
+
+  // Points pushed before the restart are kept until the new session's first
+  // point is drained.
+  timeline.push(makePoint(0));
+  timeline.restart();
+  EXPECT_EQ(timeline.getNumDroppedPoints(), 0);
+  timeline.push({-1.f, -2.f, -3.f});
+  timeline.drain();
+  EXPECT_DOUBLE_EQ(timeline.getDurationSeconds(), 0.1);
+  EXPECT_EQ(timeline.getSummary(0.0, 1.0).momentary.mean, -1.f);
+}
+
+TEST(test_loudness_timeline, invalid_values_and_export) {
+  LoudnessTimeline timeline;
+  EXPECT_TRUE(timeline.isEmpty());
+  timeline.push({-std::numeric_limits<float>::infinity(),
+                 std::numeric_limits<float>::quiet_NaN(), -300.f});
+  timeline.push({-23.f, -24.f, -1.f});
+  timeline.drain();
+
+  const auto summary = timeline.getSummary(0.0, 0.2);
+  EXPECT_EQ(summary.momentary.min, LoudnessTimeline::kFloor);
+  EXPECT_EQ(summary.shortTerm.min, LoudnessTimeline::kFloor);
+  EXPECT_EQ(summary.truePeak.max, -1.f);
+
+  juce::StringArray lines;
+  lines.addLines(timeline.toCSV());
+  lines.removeEmptyStrings();
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_TRUE(lines[0].startsWith("start_s,end_s,momentary_min"));
+
+  const juce::var json = juce::JSON::parse(timeline.toJSON(0.2));
+  ASSERT_EQ(json["points"].size(), 1);
+  EXPECT_FLOAT_EQ((float)json["points"][0]["true_peak"]["max"], -1.f);
+}
+
+TEST(test_loudness_timeline, report_next_to_export) {
+  const juce::String kExportFile(
+      (std::filesystem::current_path() / "loudness_timeline_test.iamf")
+          .string());
+  LoudnessTimeline timeline;
+  timeline.push({-23.f, -24.f, -1.f});
+  timeline.drain();
+  ASSERT_TRUE(timeline.writeReport(kExportFile));
+
+  const juce::File kCSV = LoudnessTimeline::getCSVReportFile(kExportFile);
+  const juce::File kJSON = LoudnessTimeline::getJSONReportFile(kExportFile);
+  EXPECT_EQ(kCSV.loadFileAsString(), timeline.toCSV());
+  EXPECT_EQ(kJSON.loadFileAsString(), timeline.toJSON());
+  kCSV.deleteFile();
+  kJSON.deleteFile();
+}
@@ -0,0 +1,35 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/MeteringConsumers.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+TEST(test_metering_consumers, watched_while_registered) {
+  MeteringConsumers consumers;
+  EXPECT_FALSE(consumers.isWatched());
+
+  auto editor = std::make_unique<MeteringConsumers::Registration>(consumers);
+  EXPECT_TRUE(consumers.isWatched());
+  {
+    const MeteringConsumers::Registration roomView(consumers);
+    EXPECT_TRUE(consumers.isWatched());
+  }
+  EXPECT_TRUE(consumers.isWatched());
+
+  editor.reset();
+  EXPECT_FALSE(consumers.isWatched());
+}
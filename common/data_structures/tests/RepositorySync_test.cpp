@@ -0,0 +1,228 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/RepositorySync.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+using Result = RepositorySync::Receiver::Result;
+
+namespace {
+juce::ValueTree makeElement(const juce::String& name, const int channels) {
+  juce::ValueTree element{"element"};
+  element.setProperty("name", name, nullptr);
+  element.setProperty("channels", channels, nullptr);
+  return element;
+}
+
+juce::ValueTree makeRepository() {
+  juce::ValueTree repository{"repository"};
+  repository.appendChild(makeElement("Bed", 10), nullptr);
+  repository.appendChild(makeElement("Dialogue", 1), nullptr);
+  return repository;
+}
+
+// Send the pending changes in state to the receiver, returning the result.
+Result sync(RepositorySync::Sender& sender, const juce::ValueTree& state,
+            RepositorySync::Receiver& receiver, juce::ValueTree& mirror) {
+  juce::MemoryBlock patch;
+  if (!sender.createPatch(state, patch)) {
+    return Result::kIgnored;
+  }
+  return receiver.apply(patch, mirror);
+}
+}  // namespace
+
+TEST(test_repository_sync, snapshot_then_patches) {
+  juce::ValueTree state = makeRepository();
+  RepositorySync::Sender sender;
+  RepositorySync::Receiver receiver;
+  juce::ValueTree mirror;
+
+  juce::MemoryBlock patch;
+  ASSERT_TRUE(sender.createPatch(state, patch));
+  EXPECT_EQ(receiver.apply(sender.createSnapshot(), mirror), Result::kApplied);
+  EXPECT_TRUE(mirror.isEquivalentTo(state));
+  // The snapshot already covers the first patch.
+  EXPECT_EQ(receiver.apply(patch, mirror), Result::kIgnored);
+
+  // Property changes, removals and child insertions and removals.
+  state.getChild(0).setProperty("name", "Music", nullptr);
+  state.getChild(1).removeProperty("channels", nullptr);
+  state.setProperty("version", 2, nullptr);
+  state.addChild(makeElement("Effects", 2), 1, nullptr);
+  EXPECT_EQ(sync(sender, state, receiver, mirror), Result::kApplied);
+  EXPECT_TRUE(mirror.isEquivalentTo(state));
+
+  state.removeChild(0, nullptr);
+  state.getChild(1).setProperty("gain", 0.5, nullptr);
+  EXPECT_EQ(sync(sender, state, receiver, mirror), Result::kApplied);
+  EXPECT_TRUE(mirror.isEquivalentTo(state));
+  EXPECT_EQ(receiver.getSequence(), sender.getSequence());
+}
+
+TEST(test_repository_sync, bursts_coalesce) {
+  juce::ValueTree state = makeRepository();
+  RepositorySync::Sender sender;
+  juce::MemoryBlock patch;
+  ASSERT_TRUE(sender.createPatch(state, patch));
+  const uint32_t sequence = sender.getSequence();
+
+  juce::MemoryBlock single;
+  state.getChild(0).setProperty("channels", 3, nullptr);
+  ASSERT_TRUE(sender.createPatch(state, single));
+
+  // Many edits between two patches cost the same as the last one alone.
+  juce::MemoryBlock burst;
+  for (int i = 0; i < 100; ++i) {
+    state.getChild(0).setProperty("channels", i, nullptr);
+  }
+  state.getChild(0).setProperty("channels", 4, nullptr);
+  ASSERT_TRUE(sender.createPatch(state, burst));
+  EXPECT_EQ(burst.getSize(), single.getSize());
+  EXPECT_EQ(sender.getSequence(), sequence + 2);
+
+  // Nothing changed, nothing to send.
+  EXPECT_FALSE(sender.createPatch(state, patch));
+  EXPECT_EQ(sender.getSequence(), sequence + 2);
+}
+
+TEST(test_repository_sync, patch_is_smaller_than_snapshot) {
+  juce::ValueTree state{"repository"};
+  for (int i = 0; i < 28; ++i) {
+    state.appendChild(makeElement("Element " + juce::String(i), 2), nullptr);
+  }
+  RepositorySync::Sender sender;
+  juce::MemoryBlock patch;
+  ASSERT_TRUE(sender.createPatch(state, patch));
+
+  state.getChild(12).setProperty("channels", 6, nullptr);
+  ASSERT_TRUE(sender.createPatch(state, patch));
+  EXPECT_LT(patch.getSize() * 20, sender.createSnapshot().getSize());
+}
+
+TEST(test_repository_sync, gap_requests_resync) {
+  juce::ValueTree state = makeRepository();
+  RepositorySync::Sender sender;
+  RepositorySync::Receiver receiver;
+  juce::ValueTree mirror;
+
+  // Patches before any snapshot cannot be applied.
+  juce::MemoryBlock patch;
+  ASSERT_TRUE(sender.createPatch(state, patch));
+  EXPECT_EQ(receiver.apply(patch, mirror), Result::kResyncRequired);
+  EXPECT_TRUE(RepositorySync::isResyncRequest(
+      RepositorySync::createResyncRequest()));
+  EXPECT_FALSE(RepositorySync::isResyncRequest(patch));
+
+  EXPECT_EQ(receiver.apply(sender.createSnapshot(), mirror), Result::kApplied);
+  EXPECT_TRUE(receiver.isSynchronised());
+
+  // Lose a patch. Only the first patch after the gap asks for a resync.
+  state.setProperty("lost", true, nullptr);
+  ASSERT_TRUE(sender.createPatch(state, patch));
+  state.setProperty("after", 1, nullptr);
+  EXPECT_EQ(sync(sender, state, receiver, mirror), Result::kResyncRequired);
+  state.setProperty("later", 1, nullptr);
+  EXPECT_EQ(sync(sender, state, receiver, mirror), Result::kIgnored);
+  EXPECT_FALSE(receiver.isSynchronised());
+
+  EXPECT_EQ(receiver.apply(sender.createSnapshot(), mirror), Result::kApplied);
+  EXPECT_TRUE(mirror.isEquivalentTo(state));
+}
+
+TEST(test_repository_sync, root_replacement_and_values) {
+  juce::ValueTree state = makeRepository();
+  RepositorySync::Sender sender;
+  RepositorySync::Receiver receiver;
+  juce::ValueTree mirror;
+  juce::MemoryBlock patch;
+  ASSERT_TRUE(sender.createPatch(state, patch));
+  ASSERT_EQ(receiver.apply(sender.createSnapshot(), mirror), Result::kApplied);
+
+  // Replacing the tree with one of another type resends it whole.
+  juce::ValueTree replacement{"other"};
+  replacement.setProperty("negative", -70, nullptr);
+  replacement.setProperty("large", (juce::int64)1 << 40, nullptr);
+  replacement.setProperty("flag", false, nullptr);
+  replacement.setProperty("ratio", 0.25, nullptr);
+  replacement.setProperty(
+      "text", juce::String::fromUTF8("\xc3\xa9l\xc3\xa9ment", 9), nullptr);
+  juce::Array<juce::var> list;
+  list.add(1);
+  list.add("two");
+  replacement.setProperty("list", list, nullptr);
+  EXPECT_EQ(sync(sender, replacement, receiver, mirror), Result::kApplied);
+  EXPECT_TRUE(mirror.isEquivalentTo(replacement));
+
+  // A type change of the same value is still a change.
+  replacement.setProperty("ratio", 1, nullptr);
+  EXPECT_EQ(sync(sender, replacement, receiver, mirror), Result::kApplied);
+  EXPECT_TRUE(mirror.getProperty("ratio").isInt());
+}
+
+TEST(test_repository_sync, malformed_messages) {
+  RepositorySync::Receiver receiver;
+  juce::ValueTree mirror;
+  EXPECT_EQ(receiver.apply(juce::MemoryBlock(), mirror), Result::kIgnored);
+
+  RepositorySync::Sender sender;
+  juce::MemoryBlock patch;
+  ASSERT_TRUE(sender.createPatch(makeRepository(), patch));
+  juce::MemoryBlock snapshot = sender.createSnapshot();
+  juce::MemoryBlock truncated(snapshot.getSize() / 2);
+  std::memcpy(truncated.getData(), snapshot.getData(), truncated.getSize());
+  EXPECT_EQ(receiver.apply(truncated, mirror), Result::kResyncRequired);
+  EXPECT_FALSE(receiver.isSynchronised());
+}
+
+TEST(test_repository_sync, bundles) {
+  RepositorySync::Sender first, second;
+  juce::MemoryBlock firstPatch, secondPatch;
+  ASSERT_TRUE(first.createPatch(makeRepository(), firstPatch));
+  ASSERT_TRUE(second.createPatch(makeElement("Solo", 1), secondPatch));
+
+  RepositorySync::Bundle bundle;
+  EXPECT_TRUE(bundle.isEmpty());
+  bundle.add(0, firstPatch);
+  bundle.add(300, secondPatch);
+  bundle.add(7, RepositorySync::createChannelClosed());
+
+  std::vector<std::pair<uint32_t, juce::MemoryBlock>> messages;
+  EXPECT_TRUE(RepositorySync::readBundle(
+      bundle.getData(), [&](uint32_t channel, const juce::MemoryBlock& m) {
+        messages.emplace_back(channel, m);
+      }));
+  ASSERT_EQ(messages.size(), 3u);
+  EXPECT_EQ(messages[0].first, 0u);
+  EXPECT_EQ(messages[0].second, firstPatch);
+  EXPECT_EQ(messages[1].first, 300u);
+  EXPECT_EQ(messages[1].second, secondPatch);
+  EXPECT_EQ(messages[2].first, 7u);
+  EXPECT_TRUE(RepositorySync::isChannelClosed(messages[2].second));
+  EXPECT_FALSE(RepositorySync::isChannelClosed(firstPatch));
+
+  // A truncated bundle delivers what it can and reports the fault.
+  juce::MemoryBlock truncated(bundle.getData().getSize() - 1);
+  std::memcpy(truncated.getData(), bundle.getData().getData(),
+              truncated.getSize());
+  int numDelivered = 0;
+  EXPECT_FALSE(RepositorySync::readBundle(
+      truncated,
+      [&](uint32_t, const juce::MemoryBlock&) { ++numDelivered; }));
+  EXPECT_EQ(numDelivered, 2);
+}
@@ -16,4 +16,5 @@
 
 #include "src/transport/BackgroundBuffer.cpp"
 #include "src/transport/IAMFDecoderSource.cpp"
-#include "src/transport/IAMFPlaybackDevice.cpp"
\ No newline at end of file
+#include "src/transport/IAMFPlaybackDevice.cpp"
+#include "src/transport/PrefetchByteSource.cpp"
\ No newline at end of file
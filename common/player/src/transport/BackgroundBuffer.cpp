@@ -18,11 +18,11 @@
 
 #include "processors/file_output/iamf_export_utils/IAMFFileReader.h"
 
-BackgroundBuffer::BackgroundBuffer(const unsigned paddingSeconds,
+BackgroundBuffer::BackgroundBuffer(const float paddingSeconds,
                                    IAMFFileReader& decoder)
     : decoder_(decoder), stop_(false), eof_(false) {
   const auto kStreamData = decoder_.getStreamData();
-  padSamples_ = std::min((size_t)paddingSeconds * kStreamData.sampleRate,
+  padSamples_ = std::min((size_t)(paddingSeconds * kStreamData.sampleRate),
                          kStreamData.numFrames * kStreamData.frameSize);
   absSamplePos_ = 0;
   decoder_.seekFrame(0);
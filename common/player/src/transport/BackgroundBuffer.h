@@ -25,7 +25,19 @@
 
 class BackgroundBuffer {
  public:
-  BackgroundBuffer(const unsigned paddingSeconds, IAMFFileReader& decoder);
+  // Memory bounds for buffering playback. Encoded temporal units are small, so
+  // they are read far ahead of the decoder, and only a little decoded audio is
+  // kept ahead of the playhead.
+  struct Settings {
+    // Encoded bytes kept in memory, see PrefetchByteSource
+    size_t encodedBytes = 16 << 20;
+    // Decoded audio to buffer before playing. The ring holding it is three
+    // times as long, which also serves short seeks back. Longer seeks jump
+    // the reader to the temporal unit, see IAMFFileReader::seekFrame.
+    float decodedSeconds = 0.5f;
+  };
+
+  BackgroundBuffer(const float paddingSeconds, IAMFFileReader& decoder);
   ~BackgroundBuffer();
 
   bool isReady();
@@ -17,8 +17,10 @@
 #include "logger/logger.h"
 #include "processors/file_output/iamf_export_utils/IAMFFileReader.h"
 
-IAMFDecoderSource::IAMFDecoderSource(std::unique_ptr<IAMFFileReader> reader)
-    : decoder_(std::move(reader)), isPlaying_(false) {
+IAMFDecoderSource::IAMFDecoderSource(
+    std::unique_ptr<IAMFFileReader> reader,
+    const BackgroundBuffer::Settings& settings)
+    : kSettings_(settings), decoder_(std::move(reader)), isPlaying_(false) {
   streamData_ = decoder_->getStreamData();
 }
 
@@ -57,7 +59,8 @@ bool IAMFDecoderSource::seek(size_t frameIndex) {
 void IAMFDecoderSource::prepareToPlay(int, double) {
   const juce::SpinLock::ScopedLockType lock(stateLock_);
   if (!buffer_) {
-    buffer_ = std::make_unique<BackgroundBuffer>(kPadSecs_, *decoder_);
+    buffer_ = std::make_unique<BackgroundBuffer>(kSettings_.decodedSeconds,
+                                                 *decoder_);
   }
 }
 
@@ -82,7 +85,8 @@ void IAMFDecoderSource::setLayout(
 
   // Prepare to play again
   LOG_INFO(0, "IAMFDecoderSource: Buffering audio with new layout");
-  buffer_ = std::make_unique<BackgroundBuffer>(kPadSecs_, *decoder_);
+  buffer_ = std::make_unique<BackgroundBuffer>(kSettings_.decodedSeconds,
+                                                 *decoder_);
 
   LOG_INFO(0, "IAMFDecoderSource: Layout change complete. New channel count: " +
                   std::to_string(streamData_.numChannels));
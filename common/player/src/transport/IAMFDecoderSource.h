@@ -30,7 +30,9 @@
  */
 class IAMFDecoderSource : public juce::AudioSource {
  public:
-  explicit IAMFDecoderSource(std::unique_ptr<IAMFFileReader> reader);
+  explicit IAMFDecoderSource(
+      std::unique_ptr<IAMFFileReader> reader,
+      const BackgroundBuffer::Settings& settings = {});
 
   void play();
   void pause();
@@ -71,7 +73,7 @@ class IAMFDecoderSource : public juce::AudioSource {
  private:
   void recreateDecoder();
 
-  static constexpr unsigned kPadSecs_ = 5;
+  const BackgroundBuffer::Settings kSettings_;
   std::unique_ptr<IAMFFileReader> decoder_;
   IAMFFileReader::StreamData streamData_;
   std::unique_ptr<BackgroundBuffer> buffer_;
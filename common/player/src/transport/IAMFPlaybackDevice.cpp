@@ -18,6 +18,7 @@
 
 #include "data_structures/src/FilePlayback.h"
 #include "player/src/transport/IAMFDecoderSource.h"
+#include "player/src/transport/PrefetchByteSource.h"
 #include "processors/file_output/iamf_export_utils/IAMFFileReader.h"
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
 
@@ -25,14 +26,27 @@ IAMFPlaybackDevice::Result IAMFPlaybackDevice::create(
     const std::filesystem::path iamfPath, const juce::String pbDeviceName,
     std::atomic_bool& abortConstruction,
     FilePlaybackRepository& filePlaybackRepo,
-    juce::AudioDeviceManager& deviceManager) {
+    juce::AudioDeviceManager& deviceManager,
+    const BackgroundBuffer::Settings& bufferSettings) {
+  // Encoded bytes are read ahead into memory so the decoder only waits on the
+  // disk after seeking out of what is cached. The file is deliberately
+  // streamed rather than mapped: it is the file a new export writes, and the
+  // player only lets go of it once that export has started writing.
+  auto source = std::make_unique<StreamByteSource>(iamfPath);
+  if (!source->isOpen()) {
+    LOG_ERROR(0, "IAMFPlaybackDevice: Failed to open IAMF file");
+    return {nullptr, Error::kInvalidIAMFFile};
+  }
+
   // Attempt to create the IAMFFileReader first. Being unable to create the
   // reader for any reason invalidates the playback device.
   // While attempting to index the file during construction, we acknowledge that
   // due to the potential size of IAMF files we may need to abort before
   // indexing can complete
   auto reader = IAMFFileReader::createIamfReader(
-      iamfPath, IAMFFileReader::kDefaultReaderSettings, abortConstruction);
+      std::make_unique<PrefetchByteSource>(std::move(source),
+                                           bufferSettings.encodedBytes),
+      IAMFFileReader::kDefaultReaderSettings, abortConstruction);
   if (!reader && abortConstruction) {
     return {nullptr, Error::kEarlyAbortRequested};
   }
@@ -43,7 +57,8 @@ IAMFPlaybackDevice::Result IAMFPlaybackDevice::create(
 
   auto device = std::unique_ptr<IAMFPlaybackDevice>(
       new IAMFPlaybackDevice(iamfPath, pbDeviceName, filePlaybackRepo,
-                             deviceManager, std::move(reader)));
+                             deviceManager, std::move(reader),
+                             bufferSettings));
 
   // Complete initialization
   FilePlayback fpb = filePlaybackRepo.get();
@@ -52,15 +67,16 @@ IAMFPlaybackDevice::Result IAMFPlaybackDevice::create(
   return {std::move(device), Error::kNoError};
 }
 
-IAMFPlaybackDevice::IAMFPlaybackDevice(const std::filesystem::path iamfPath,
-                                       const juce::String pbDeviceName,
-                                       FilePlaybackRepository& filePlaybackRepo,
-                                       juce::AudioDeviceManager& deviceManager,
-                                       std::unique_ptr<IAMFFileReader> reader)
+IAMFPlaybackDevice::IAMFPlaybackDevice(
+    const std::filesystem::path iamfPath, const juce::String pbDeviceName,
+    FilePlaybackRepository& filePlaybackRepo,
+    juce::AudioDeviceManager& deviceManager,
+    std::unique_ptr<IAMFFileReader> reader,
+    const BackgroundBuffer::Settings& bufferSettings)
     : kPath_(iamfPath),
       fpbr_(filePlaybackRepo),
       deviceManager_(deviceManager),
-      decoderSource_(std::move(reader)) {
+      decoderSource_(std::move(reader), bufferSettings) {
   deviceManager_.initialiseWithDefaultDevices(0, 2);
 
   decoderSource_.setOnFinishedCallback([this] {
@@ -38,7 +38,8 @@ class IAMFPlaybackDevice : private juce::ValueTree::Listener {
                        const juce::String pbDeviceName,
                        std::atomic_bool& abortConstruction,
                        FilePlaybackRepository& filePlaybackRepo,
-                       juce::AudioDeviceManager& deviceManager);
+                       juce::AudioDeviceManager& deviceManager,
+                       const BackgroundBuffer::Settings& bufferSettings = {});
 
   ~IAMFPlaybackDevice();
 
@@ -56,7 +57,8 @@ class IAMFPlaybackDevice : private juce::ValueTree::Listener {
                      const juce::String pbDeviceName,
                      FilePlaybackRepository& filePlaybackRepo,
                      juce::AudioDeviceManager& deviceManager,
-                     std::unique_ptr<IAMFFileReader> reader);
+                     std::unique_ptr<IAMFFileReader> reader,
+                     const BackgroundBuffer::Settings& bufferSettings);
 
   struct PlaybackState {
     bool wasPlaying;
@@ -0,0 +1,203 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "PrefetchByteSource.h"
+
+#include <algorithm>
+#include <cstring>
+
+PrefetchByteSource::PrefetchByteSource(std::unique_ptr<IAMFByteSource> source,
+                                       const size_t maxBytes)
+    : source_(std::move(source)),
+      kSize_(source_->getSize()),
+      kMaxBlocks_(std::max<size_t>(maxBytes / kBlockSize, 4)),
+      kBlocksBehind_(kMaxBlocks_ / 4),
+      kBlocksAhead_(kMaxBlocks_ - 2 - kBlocksBehind_) {
+  source_->willReadSequentially();
+  prefetchThread_ = std::thread(&PrefetchByteSource::prefetchTask, this);
+}
+
+PrefetchByteSource::~PrefetchByteSource() {
+  {
+    const std::lock_guard<std::mutex> lock(cacheMutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (prefetchThread_.joinable()) {
+    prefetchThread_.join();
+  }
+}
+
+std::span<const uint8_t> PrefetchByteSource::read(const size_t maxBytes) {
+  std::unique_lock<std::mutex> lock(cacheMutex_);
+  if (position_ >= kSize_ || maxBytes == 0) {
+    return {};
+  }
+
+  const uint64_t kIndex = position_ / kBlockSize;
+  auto found = blocks_.find(kIndex);
+  if (found == blocks_.end()) {
+    // Wait for the read-ahead if it is already loading the block, otherwise
+    // load it here, e.g. just after seeking out of the window
+    cv_.notify_all();
+    cv_.wait(lock, [&] { return loadingBlock_ != kIndex; });
+    found = blocks_.find(kIndex);
+    if (found == blocks_.end()) {
+      // The window leaves room for the pinned block and the one being read
+      // ahead, so a block outside it can always be reused here
+      Blocks::node_type block = takeBlock(kIndex);
+      lock.unlock();
+      loadBlock(block);
+      lock.lock();
+      auto inserted = blocks_.insert(std::move(block));
+      if (!inserted.inserted) {
+        // The read-ahead loaded it first
+        --numBlocks_;
+      }
+      found = inserted.position;
+    }
+  }
+
+  const std::vector<uint8_t>& kBlock = found->second;
+  const size_t kOffset = (size_t)(position_ - kIndex * kBlockSize);
+  if (kOffset >= kBlock.size()) {
+    // The file was shorter than it claimed
+    return {};
+  }
+  const size_t kCount = std::min(maxBytes, kBlock.size() - kOffset);
+  pinnedBlock_ = kIndex;
+  position_ += kCount;
+  if (position_ / kBlockSize != kIndex) {
+    cv_.notify_all();
+  }
+  return std::span<const uint8_t>(kBlock.data() + kOffset, kCount);
+}
+
+bool PrefetchByteSource::seek(const uint64_t position) {
+  if (position > kSize_) {
+    return false;
+  }
+  {
+    const std::lock_guard<std::mutex> lock(cacheMutex_);
+    position_ = position;
+  }
+  cv_.notify_all();
+  return true;
+}
+
+uint64_t PrefetchByteSource::getPosition() const {
+  const std::lock_guard<std::mutex> lock(cacheMutex_);
+  return position_;
+}
+
+size_t PrefetchByteSource::getCachedBytes() const {
+  const std::lock_guard<std::mutex> lock(cacheMutex_);
+  size_t bytes = 0;
+  for (const auto& [index, block] : blocks_) {
+    bytes += block.size();
+  }
+  return bytes;
+}
+
+void PrefetchByteSource::prefetchTask() {
+  std::unique_lock<std::mutex> lock(cacheMutex_);
+  while (!stop_) {
+    uint64_t index;
+    Blocks::node_type block;
+    if (findMissingBlock(index)) {
+      block = takeBlock(index);
+    }
+    if (block.empty()) {
+      // Woken when reads move into a new block, on seeks and on stopping
+      cv_.wait(lock);
+      continue;
+    }
+
+    loadingBlock_ = index;
+    lock.unlock();
+    loadBlock(block);
+    lock.lock();
+    if (!blocks_.insert(std::move(block)).inserted) {
+      --numBlocks_;
+    }
+    loadingBlock_ = kNoBlock;
+    cv_.notify_all();
+  }
+}
+
+bool PrefetchByteSource::findMissingBlock(uint64_t& index) const {
+  const uint64_t kFirst = position_ / kBlockSize;
+  const uint64_t kEnd = std::min<uint64_t>(
+      kFirst + kBlocksAhead_, (kSize_ + kBlockSize - 1) / kBlockSize);
+  for (uint64_t i = kFirst; i < kEnd; ++i) {
+    if (i != loadingBlock_ && !blocks_.contains(i)) {
+      index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+PrefetchByteSource::Blocks::node_type PrefetchByteSource::takeBlock(
+    const uint64_t index) {
+  if (numBlocks_ < kMaxBlocks_) {
+    ++numBlocks_;
+    Blocks block;
+    block.emplace(index, std::vector<uint8_t>());
+    return block.extract(block.begin());
+  }
+
+  // Reuse the block furthest outside the window kept around the read position
+  const uint64_t kFirst = position_ / kBlockSize;
+  const uint64_t kStart = kFirst - std::min<uint64_t>(kFirst, kBlocksBehind_);
+  const uint64_t kEnd = kFirst + kBlocksAhead_;
+  auto furthest = blocks_.end();
+  uint64_t furthestDistance = 0;
+  for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+    const uint64_t kDistance = it->first < kStart ? kStart - it->first
+                               : it->first >= kEnd ? it->first - kEnd + 1
+                                                   : 0;
+    if (kDistance > furthestDistance && it->first != pinnedBlock_) {
+      furthest = it;
+      furthestDistance = kDistance;
+    }
+  }
+  if (furthest == blocks_.end()) {
+    return {};
+  }
+  Blocks::node_type block = blocks_.extract(furthest);
+  block.key() = index;
+  return block;
+}
+
+void PrefetchByteSource::loadBlock(Blocks::node_type& block) {
+  const uint64_t kOffset = block.key() * kBlockSize;
+  std::vector<uint8_t>& bytes = block.mapped();
+  bytes.resize((size_t)std::min<uint64_t>(kBlockSize, kSize_ - kOffset));
+
+  const std::lock_guard<std::mutex> lock(sourceMutex_);
+  size_t filled = 0;
+  if (source_->seek(kOffset)) {
+    while (filled < bytes.size()) {
+      const std::span<const uint8_t> kChunk =
+          source_->read(bytes.size() - filled);
+      if (kChunk.empty()) {
+        break;
+      }
+      std::memcpy(bytes.data() + filled, kChunk.data(), kChunk.size());
+      filled += kChunk.size();
+    }
+  }
+  bytes.resize(filled);
+}
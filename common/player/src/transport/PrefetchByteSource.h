@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "processors/file_output/iamf_export_utils/IAMFByteSource.h"
+
+/**
+ * @brief Keeps encoded bytes of an IAMF file in memory ahead of the decoder.
+ *
+ * A background thread reads the file in fixed-size blocks ahead of the read
+ * position, so the decoder never waits on the disk. Some blocks are also kept
+ * behind the read position. Seeking within the cached blocks keeps them and
+ * the read-ahead carries on from there. The cache never holds more than
+ * maxBytes, rounded down to whole blocks.
+ */
+class PrefetchByteSource : public IAMFByteSource {
+ public:
+  static constexpr size_t kBlockSize = 64 << 10;
+
+  PrefetchByteSource(std::unique_ptr<IAMFByteSource> source,
+                     const size_t maxBytes);
+  ~PrefetchByteSource() override;
+
+  std::span<const uint8_t> read(const size_t maxBytes) override;
+  bool seek(const uint64_t position) override;
+  uint64_t getPosition() const override;
+  uint64_t getSize() const override { return kSize_; }
+  void willReadSequentially() override { cv_.notify_all(); }
+
+  // Bytes cached at the moment, read ahead or kept behind.
+  size_t getCachedBytes() const;
+
+ private:
+  using Blocks = std::map<uint64_t, std::vector<uint8_t>>;
+  static constexpr uint64_t kNoBlock = UINT64_MAX;
+
+  void prefetchTask();
+  // First block ahead of the read position that is neither cached nor being
+  // loaded. Called with cacheMutex_ held.
+  bool findMissingBlock(uint64_t& index) const;
+  // A block to load index into, reusing the block furthest outside the window
+  // once the cache is full. Empty if every cached block is still wanted.
+  // Called with cacheMutex_ held.
+  Blocks::node_type takeBlock(const uint64_t index);
+  void loadBlock(Blocks::node_type& block);
+
+  std::unique_ptr<IAMFByteSource> source_;
+  const uint64_t kSize_;
+  const size_t kMaxBlocks_, kBlocksBehind_, kBlocksAhead_;
+  // Guards source_, which loads from both threads
+  std::mutex sourceMutex_;
+  mutable std::mutex cacheMutex_;
+  std::condition_variable cv_;
+  Blocks blocks_;
+  // Cached blocks plus the one being loaded
+  size_t numBlocks_ = 0;
+  uint64_t position_ = 0;
+  uint64_t loadingBlock_ = kNoBlock;
+  // The block the last view was handed out of, which is never reused
+  uint64_t pinnedBlock_ = kNoBlock;
+  bool stop_ = false;
+  std::thread prefetchThread_;
+};
@@ -0,0 +1,108 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/transport/PrefetchByteSource.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "processors/tests/CountingByteSource.h"
+
+namespace {
+constexpr size_t kBlock = PrefetchByteSource::kBlockSize;
+
+std::vector<uint8_t> makeBytes(const size_t count) {
+  std::vector<uint8_t> bytes(count);
+  for (size_t i = 0; i < count; ++i) {
+    bytes[i] = (uint8_t)(i * 31 + i / 251);
+  }
+  return bytes;
+}
+
+void waitForCachedBytes(const PrefetchByteSource& source, const size_t bytes) {
+  for (int i = 0; i < 500 && source.getCachedBytes() < bytes; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_GE(source.getCachedBytes(), bytes);
+}
+}  // namespace
+
+TEST(PrefetchByteSource, reads_whole_source) {
+  const std::vector<uint8_t> kBytes = makeBytes(16 * kBlock + 123);
+  PrefetchByteSource source(std::make_unique<MemoryByteSource>(kBytes),
+                            4 * kBlock);
+  ASSERT_EQ(source.getSize(), kBytes.size());
+
+  // Odd sized reads cross block boundaries
+  std::vector<uint8_t> read;
+  for (std::span<const uint8_t> chunk = source.read(5000); !chunk.empty();
+       chunk = source.read(5000)) {
+    read.insert(read.end(), chunk.begin(), chunk.end());
+    EXPECT_LE(source.getCachedBytes(), 4 * kBlock);
+  }
+  EXPECT_EQ(read, kBytes);
+  EXPECT_EQ(source.getPosition(), kBytes.size());
+}
+
+TEST(PrefetchByteSource, reads_ahead_within_bound) {
+  const std::vector<uint8_t> kBytes = makeBytes(64 * kBlock);
+  PrefetchByteSource source(std::make_unique<MemoryByteSource>(kBytes),
+                            16 * kBlock);
+  // Ten blocks are read ahead of the position. Room is left for four behind
+  // it and two more while reading, so read-ahead never fills the cache.
+  waitForCachedBytes(source, 10 * kBlock);
+  EXPECT_LE(source.getCachedBytes(), 10 * kBlock);
+}
+
+TEST(PrefetchByteSource, seeks_within_window_keep_cache) {
+  const std::vector<uint8_t> kBytes = makeBytes(64 * kBlock);
+  std::atomic<uint64_t> count = 0;
+  PrefetchByteSource source(
+      std::make_unique<CountingByteSource>(kBytes, count), 8 * kBlock);
+
+  // Read into the fourth block. Two blocks are kept behind it and four read
+  // ahead of it.
+  ASSERT_TRUE(source.seek(3 * kBlock));
+  ASSERT_EQ(source.read(10).size(), 10u);
+  waitForCachedBytes(source, 4 * kBlock);
+  ASSERT_TRUE(source.seek(kBlock));
+  ASSERT_EQ(source.read(kBlock).size(), kBlock);
+  waitForCachedBytes(source, 6 * kBlock);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const uint64_t kCountBefore = count;
+
+  // Back and forth within the window without touching the file
+  for (const uint64_t kPosition :
+       {2 * kBlock + 7, kBlock, 4 * kBlock - 200}) {
+    ASSERT_TRUE(source.seek(kPosition));
+    const std::span<const uint8_t> kRead = source.read(100);
+    ASSERT_FALSE(kRead.empty());
+    EXPECT_EQ(kRead[0], kBytes[kPosition]);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(count, kCountBefore);
+
+  // Far outside the window the block is loaded on demand
+  ASSERT_TRUE(source.seek(40 * kBlock + 5));
+  const std::span<const uint8_t> kFar = source.read(10);
+  ASSERT_EQ(kFar.size(), 10u);
+  EXPECT_EQ(kFar[0], kBytes[40 * kBlock + 5]);
+  EXPECT_LE(source.getCachedBytes(), 8 * kBlock);
+  EXPECT_FALSE(source.seek(kBytes.size() + 1));
+}
@@ -18,24 +18,22 @@
 #include <memory>
 
 #include "data_structures/src/AudioElementCommunication.h"
-#include "processors/audioelementplugin_publisher/MessagingThread.h"
 
 AudioElementPluginDataPublisher::AudioElementPluginDataPublisher(
     AudioElementSpatialLayoutRepository* audioElementSpatialLayoutRepository,
-    AudioElementParameterTree* automationParameterTree)
+    AudioElementParameterTree* automationParameterTree,
+    const ChannelMeter* sharedMeter)
     : audioElementSpatialLayoutData_(audioElementSpatialLayoutRepository),
       automationParameterTree_(automationParameterTree),
-      messagingThread_(std::make_unique<MessagingThread>(
-          juce::String("AudioElementPublisherThread"))) {
+      meterSource_(sharedMeter) {
   // Set up the initial data
-  localData_.x = automationParameterTree_->getXPosition();
-  localData_.y = automationParameterTree_->getYPosition();
-  localData_.z = automationParameterTree_->getZPosition();
-
-  avgLoudness_.update(-70.f);
-  jassert(messagingThread_ != nullptr);
+  slot_.setX(automationParameterTree_->getXPosition());
+  slot_.setY(automationParameterTree_->getYPosition());
+  slot_.setZ(automationParameterTree_->getZPosition());
+  slot_.setLoudness(-70.f);
   // Update any information from the repository
   updateData();
+  hub_->addTelemetrySource(&slot_);
 
   automationParameterTree_->addXPositionListener(this);
   automationParameterTree_->addYPositionListener(this);
@@ -44,48 +42,39 @@ AudioElementPluginDataPublisher::AudioElementPluginDataPublisher(
   audioElementSpatialLayoutRepository->registerListener(this);
 }
 
-AudioElementPluginDataPublisher::~AudioElementPluginDataPublisher() {}
+AudioElementPluginDataPublisher::~AudioElementPluginDataPublisher() {
+  hub_->removeTelemetrySource(&slot_);
+}
 
 void AudioElementPluginDataPublisher::prepareToPlay(double sampleRate,
-                                                    int samplesPerBlock) {}
+                                                    int samplesPerBlock) {
+  meterSource_.prepare(getHostWideLayout().size());
+}
 
 void AudioElementPluginDataPublisher::updateData() {
-  // Fetch the audio element plugin name from the repository
-  strncpy(localData_.name,
-          audioElementSpatialLayoutData_->get().getName().toRawUTF8(),
-          sizeof(localData_.name));
-  localData_.name[sizeof(localData_.name) - 1] =
-      '\0';  // Ensure null-terminated
-  channels_ =
-      audioElementSpatialLayoutData_->get().getChannelLayout().getNumChannels();
-
-  std::memcpy(localData_.uuid.data(),
-              audioElementSpatialLayoutData_->get().getId().getRawData(),
-              localData_.uuid.size());
-
-  float loudness(-70.f);
-
-  avgLoudness_.read(loudness);  // Reset the average loudness
-
-  localData_.loudness = loudness;
-
-  messagingThread_->pushAudioElementUpdateData(localData_);
+  // Fetch the audio element plugin name and ID from the repository
+  const AudioElementSpatialLayout layout =
+      audioElementSpatialLayoutData_->get();
+  channels_ = layout.getChannelLayout().getNumChannels();
+  slot_.setDescription(layout.getId(), layout.getName());
+
+  // Send renames and the like without waiting for the next sample
+  hub_->requestTelemetryUpdate();
 }
 
 void AudioElementPluginDataPublisher::processBlock(
     juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) {
+  const int channels = channels_.load(std::memory_order_relaxed);
+  const ChannelMeter& levels = meterSource_.measure(buffer, channels);
   float loudness = 0;
-  for (int i = 0; i < channels_; ++i) {
-    float chLoud =
-        20.0f * std::log10(buffer.getRMSLevel(i, 0, buffer.getNumSamples()));
+  for (int i = 0; i < channels; ++i) {
+    float chLoud = levels.getRMSdB(i);
     // Clamp the loudness to -70 dB since some tracks will be -Inf
     loudness += std::max(chLoud, -70.0f);
   }
-  loudness = loudness / channels_;
-  avgLoudness_.update(loudness);
+  loudness = loudness / channels;
 
-  if (loudness != localData_.loudness) {
-    localData_.loudness = loudness;
-    messagingThread_->pushAudioElementUpdateData(localData_);
-  }
+  // The messaging thread samples the latest value at its update rate
+  slot_.setLoudness(loudness);
+  slot_.addProcessedBlock();
 }
@@ -16,15 +16,17 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
+#include "../metering/ChannelMeter.h"
 #include "../processor_base/ProcessorBase.h"
-#include "MessagingThread.h"
 #include "data_repository/implementation/AudioElementSpatialLayoutRepository.h"
 #include "data_structures/src/AudioElementCommunication.h"
 #include "data_structures/src/AudioElementParameterTree.h"
+#include "data_structures/src/AudioElementPluginHub.h"
+#include "data_structures/src/AudioElementUpdateSlot.h"
 #include "data_structures/src/ParameterMetaData.h"
-#include "data_structures/src/RealtimeDataType.h"
 #include "data_structures/src/SpeakerMonitorData.h"
 
 //==============================================================================
@@ -36,7 +38,8 @@ class AudioElementPluginDataPublisher final
   //==============================================================================
   AudioElementPluginDataPublisher(
       AudioElementSpatialLayoutRepository* audioElementSpatialLayoutRepository,
-      AudioElementParameterTree* automationParameterTree);
+      AudioElementParameterTree* automationParameterTree,
+      const ChannelMeter* sharedMeter = nullptr);
   ~AudioElementPluginDataPublisher() override;
 
   //==============================================================================
@@ -75,15 +78,14 @@ class AudioElementPluginDataPublisher final
   //==============================================================================
   void parameterChanged(const juce::String& parameterID,
                         float newValue) override {
-    // Guaranteed to be called before processBlock so we don't need to lock
+    // May be called from the audio thread, so only touch the atomic slot
     if (parameterID == AutoParamMetaData::xPosition) {
-      localData_.x = newValue;
+      slot_.setX(newValue);
     } else if (parameterID == AutoParamMetaData::yPosition) {
-      localData_.y = newValue;
+      slot_.setY(newValue);
     } else if (parameterID == AutoParamMetaData::zPosition) {
-      localData_.z = newValue;
+      slot_.setZ(newValue);
     }
-    updateData();
   }
 
   //==============================================================================
@@ -91,12 +93,13 @@ class AudioElementPluginDataPublisher final
  private:
   void updateData();
 
-  RealtimeDataType<float> avgLoudness_;
   AudioElementSpatialLayoutRepository* audioElementSpatialLayoutData_;
   AudioElementParameterTree* automationParameterTree_;
-  std::unique_ptr<MessagingThread> messagingThread_;
-  AudioElementUpdateData localData_;
-  int channels_;
+  // Latest values, sampled and sent by the process-wide hub
+  AudioElementUpdateSlot slot_;
+  juce::SharedResourcePointer<AudioElementPluginHub> hub_;
+  std::atomic<int> channels_;
+  ChannelMeterSource meterSource_;
 
   //==============================================================================
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioElementPluginDataPublisher)
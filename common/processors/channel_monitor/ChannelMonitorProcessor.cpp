@@ -22,9 +22,11 @@
 ChannelMonitorProcessor::ChannelMonitorProcessor(
     ChannelMonitorData& channelMonitorData,
     MixPresentationRepository* mixPresentationRepository,
-    MixPresentationSoloMuteRepository* mixPresentationSoloMuteRepository)
+    MixPresentationSoloMuteRepository* mixPresentationSoloMuteRepository,
+    const ChannelMeter* sharedMeter)
     : numChannels_(juce::AudioChannelSet::ambisonic(5).size()),
       channelMonitorData_(channelMonitorData),
+      meterSource_(sharedMeter),
       loudness_(std::vector<float>(numChannels_, -300.f)),
       mixPresentationRepository_(mixPresentationRepository),
       mixPresentationSoloMuteRepository_(mixPresentationSoloMuteRepository) {
@@ -41,7 +43,9 @@ const juce::String ChannelMonitorProcessor::getName() const {
 }
 
 void ChannelMonitorProcessor::prepareToPlay(double sampleRate,
-                                            int samplesPerBlock) {}
+                                            int samplesPerBlock) {
+  meterSource_.prepare(numChannels_);
+}
 
 void ChannelMonitorProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                            juce::MidiBuffer& midiMessages) {
@@ -49,12 +53,18 @@ void ChannelMonitorProcessor::processBlock(juce::AudioBuffer<float>& buffer,
 
   juce::ScopedNoDenormals noDenormals;
 
-  for (int i = 0; i < buffer.getNumChannels(); i++) {
-    loudness_[i] =
-        20.0f * std::log10(buffer.getRMSLevel(i, 0, buffer.getNumSamples()));
+  // Channel levels are only used by the meters.
+  if (!channelMonitorData_.consumers.isWatched()) {
+    return;
+  }
+
+  const ChannelMeter& levels = meterSource_.measure(buffer);
+  const int numMetered = std::min(levels.getNumChannels(), numChannels_);
+  for (int i = 0; i < numMetered; i++) {
+    loudness_[i] = levels.getRMSdB(i);
   }
 
-  for (int i = buffer.getNumChannels(); i < numChannels_; i++) {
+  for (int i = numMetered; i < numChannels_; i++) {
     loudness_[i] = -120.0f;
   }
 
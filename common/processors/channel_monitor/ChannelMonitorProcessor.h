@@ -29,6 +29,7 @@
 #include <juce_dsp/juce_dsp.h>
 
 #include "../../data_repository/implementation/MixPresentationRepository.h"
+#include "../metering/ChannelMeter.h"
 #include "../processor_base/ProcessorBase.h"
 #include "data_repository/implementation/MixPresentationSoloMuteRepository.h"
 
@@ -39,7 +40,8 @@ class ChannelMonitorProcessor final : public ProcessorBase,
   ChannelMonitorProcessor(
       ChannelMonitorData& channelMonitorData,
       MixPresentationRepository* mixPresentationRepository,
-      MixPresentationSoloMuteRepository* mixPresentationSoloMuteRepository);
+      MixPresentationSoloMuteRepository* mixPresentationSoloMuteRepository,
+      const ChannelMeter* sharedMeter = nullptr);
   ~ChannelMonitorProcessor() override;
 
   void prepareToPlay(double sampleRate, int samplesPerBlock) override;
@@ -62,6 +64,7 @@ class ChannelMonitorProcessor final : public ProcessorBase,
   MixPresentationRepository* mixPresentationRepository_;
   MixPresentationSoloMuteRepository* mixPresentationSoloMuteRepository_;
   int numChannels_;
+  ChannelMeterSource meterSource_;
   // replace with thread safe data-struct
   std::vector<float> loudness_;
 
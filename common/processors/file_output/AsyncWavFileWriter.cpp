@@ -0,0 +1,132 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AsyncWavFileWriter.h"
+
+#include <logger/logger.h>
+
+#include <chrono>
+
+namespace {
+// How long the writing thread sleeps when the queue is empty
+constexpr std::chrono::milliseconds kIdleWait{10};
+}  // namespace
+
+AsyncWavFileWriter::AsyncWavFileWriter(const int numChannels,
+                                       const int sampleRate,
+                                       const int bitDepth)
+    : numChannels_(numChannels),
+      file_(numChannels, sampleRate, bitDepth),
+      queue_(numChannels, sampleRate * kQueueSeconds),
+      fifo_(sampleRate * kQueueSeconds),
+      channelPointers_(numChannels) {}
+
+AsyncWavFileWriter::~AsyncWavFileWriter() { close(); }
+
+bool AsyncWavFileWriter::open(const std::string& filename) {
+  close();
+  fifo_.reset();
+  stop_ = false;
+  writeFailed_ = false;
+  droppedSamples_ = 0;
+  if (!file_.open(filename, {}, {})) {
+    return false;
+  }
+  thread_ = std::thread(&AsyncWavFileWriter::run, this);
+  return true;
+}
+
+bool AsyncWavFileWriter::write(const juce::AudioBuffer<float>& buffer,
+                               const bool waitForSpace) {
+  const int kNumSamples = buffer.getNumSamples();
+  jassert(buffer.getNumChannels() >= numChannels_);
+  if (!isOpen() || kNumSamples <= 0 ||
+      buffer.getNumChannels() < numChannels_) {
+    return false;
+  }
+
+  while (fifo_.getFreeSpace() < kNumSamples) {
+    // A block larger than the whole queue can never fit
+    if (!waitForSpace || writeFailed_ ||
+        kNumSamples > fifo_.getTotalSize() - 1) {
+      droppedSamples_ += kNumSamples;
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  int start1, size1, start2, size2;
+  fifo_.prepareToWrite(kNumSamples, start1, size1, start2, size2);
+  for (int ch = 0; ch < numChannels_; ++ch) {
+    queue_.copyFrom(ch, start1, buffer, ch, 0, size1);
+    if (size2 > 0) {
+      queue_.copyFrom(ch, start2, buffer, ch, size1, size2);
+    }
+  }
+  fifo_.finishedWrite(size1 + size2);
+  return true;
+}
+
+bool AsyncWavFileWriter::close() {
+  if (!isOpen()) {
+    return false;
+  }
+  stop_ = true;
+  thread_.join();
+
+  const bool kClosed = file_.close();
+  if (droppedSamples_ > 0) {
+    LOG_WARNING(0, "WAV Writer: Dropped " +
+                       std::to_string(droppedSamples_.load()) +
+                       " samples the disk could not keep up with.");
+  }
+  return kClosed && !writeFailed_;
+}
+
+void AsyncWavFileWriter::run() {
+  while (true) {
+    // Read stop_ first, so the final pass sees every block queued before it
+    const bool kStopping = stop_;
+    const int kWritten = writeQueued();
+    if (kStopping) {
+      return;
+    }
+    if (kWritten == 0) {
+      std::this_thread::sleep_for(kIdleWait);
+    }
+  }
+}
+
+int AsyncWavFileWriter::writeQueued() {
+  const auto writeRange = [this](const int start, const int size) {
+    if (size <= 0 || writeFailed_) {
+      return;
+    }
+    for (int ch = 0; ch < numChannels_; ++ch) {
+      channelPointers_[ch] = queue_.getReadPointer(ch, start);
+    }
+    if (!file_.write(channelPointers_.data(), size)) {
+      // Keep draining the queue so the audio thread is not held up
+      LOG_ERROR(0, "WAV Writer: Failed to write audio to the file.");
+      writeFailed_ = true;
+    }
+  };
+
+  int start1, size1, start2, size2;
+  fifo_.prepareToRead(fifo_.getNumReady(), start1, size1, start2, size2);
+  writeRange(start1, size1);
+  writeRange(start2, size2);
+  fifo_.finishedRead(size1 + size2);
+  return size1 + size2;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "adm_export_utils/BW64Writer.h"
+
+/**
+ * @brief Writes a WAV file from the audio thread without touching the disk
+ * there.
+ *
+ * Blocks are copied into a preallocated lock-free queue and written out by a
+ * dedicated thread in large writes. The file is written as BW64, so it is a
+ * plain WAV file until it outgrows 4 GiB and becomes RF64 after that.
+ *
+ * When the queue is full a realtime caller's block is dropped and counted,
+ * rather than stalling the audio thread. An offline caller waits for room.
+ */
+class AsyncWavFileWriter {
+ public:
+  // Seconds of audio the queue holds
+  static constexpr int kQueueSeconds = 4;
+
+  // bitDepth 16 and 24 are integer PCM, 32 is IEEE float.
+  AsyncWavFileWriter(int numChannels, int sampleRate, int bitDepth);
+  ~AsyncWavFileWriter();
+
+  // Create the file and start the writing thread.
+  bool open(const std::string& filename);
+
+  // Queue the first channels of buffer. Returns false if the block was
+  // dropped, which only happens when waitForSpace is false or the file can
+  // no longer be written.
+  bool write(const juce::AudioBuffer<float>& buffer, bool waitForSpace);
+
+  // Write out the queued audio, then complete and close the file. Returns
+  // false if the file could not be written in full.
+  bool close();
+
+  bool isOpen() const { return thread_.joinable(); }
+
+  // Samples of every channel dropped because the queue was full
+  int64_t getDroppedSamples() const { return droppedSamples_.load(); }
+
+ private:
+  void run();
+  // Write every queued sample to the file. Returns the number written.
+  int writeQueued();
+
+  const int numChannels_;
+  BW64Writer file_;
+  juce::AudioBuffer<float> queue_;
+  juce::AbstractFifo fifo_;
+  std::vector<const float*> channelPointers_;
+  std::atomic_bool stop_{false};
+  std::atomic_bool writeFailed_{false};
+  std::atomic<int64_t> droppedSamples_{0};
+  std::thread thread_;
+};
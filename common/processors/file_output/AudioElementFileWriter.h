@@ -25,12 +25,14 @@ class AudioElementFileWriter {
  public:
   AudioElementFileWriter(const juce::String& filename, double sampleRate,
                          int bitDepth, AudioCodec codec,
-                         AudioElement& element)
+                         AudioElement& element,
+                         juce::TimeSliceThread* backgroundThread = nullptr)
       : element_(element)  // Use a local copy of the audio element to avoid
                            // updates elsewhere causing issues
   {
     fileWriter = new FileWriter(filename, sampleRate, element.getChannelCount(),
-                                element.getFirstChannel(), bitDepth, codec);
+                                element.getFirstChannel(), bitDepth, codec,
+                                backgroundThread);
   }
 
   ~AudioElementFileWriter() {
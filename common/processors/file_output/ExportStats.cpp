@@ -0,0 +1,200 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ExportStats.h"
+
+#include <logger/logger.h>
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace {
+int64_t nowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double toSeconds(const int64_t nanos) { return nanos * 1e-9; }
+
+std::mutex statsRegistryMutex;
+std::vector<std::pair<const FileExportRepository*, std::weak_ptr<ExportStats>>>
+    statsRegistry;
+}  // namespace
+
+std::shared_ptr<ExportStats> ExportStats::forExport(
+    const FileExportRepository& repository) {
+  const std::lock_guard<std::mutex> lock(statsRegistryMutex);
+  for (const auto& [owner, stats] : statsRegistry) {
+    if (owner == &repository) {
+      if (auto shared = stats.lock()) {
+        return shared;
+      }
+    }
+  }
+
+  // Drop the entry along with the stats, so a later repository at the same
+  // address does not find them
+  std::shared_ptr<ExportStats> stats(new ExportStats(), [](ExportStats* p) {
+    {
+      const std::lock_guard<std::mutex> lock(statsRegistryMutex);
+      std::erase_if(statsRegistry,
+                    [](const auto& entry) { return entry.second.expired(); });
+    }
+    delete p;
+  });
+  statsRegistry.emplace_back(&repository, stats);
+  return stats;
+}
+
+juce::File ExportStats::getReportFile(const juce::String& exportFile) {
+  return juce::File(exportFile + ".export_stats.json");
+}
+
+const char* ExportStats::getStageName(const Stage stage) {
+  switch (stage) {
+    case kLoudness:
+      return "loudness";
+    case kEncode:
+      return "encode";
+    case kStemEnqueue:
+      return "audio_element_enqueue";
+    case kMux:
+      return "mux";
+    default:
+      return "unknown";
+  }
+}
+
+void ExportStats::beginRender(const int sampleRate) {
+  for (StageTotals& stage : stages_) {
+    stage.nanos = 0;
+    stage.frames = 0;
+    stage.bytes = 0;
+    stage.calls = 0;
+  }
+  sampleRate_ = sampleRate;
+  renderedFrames_ = 0;
+  renderNanos_ = 0;
+  maxQueueDepth_ = 0;
+  renderStart_ = nowNanos();
+}
+
+void ExportStats::endRender() { renderNanos_ = nowNanos() - renderStart_; }
+
+void ExportStats::record(const Stage stage,
+                         const std::chrono::nanoseconds elapsed,
+                         const int64_t frames, const int64_t bytes) {
+  StageTotals& totals = stages_[stage];
+  totals.nanos += elapsed.count();
+  totals.frames += frames;
+  totals.bytes += bytes;
+  ++totals.calls;
+}
+
+void ExportStats::recordQueueDepth(const int depth) {
+  int previous = maxQueueDepth_;
+  while (depth > previous &&
+         !maxQueueDepth_.compare_exchange_weak(previous, depth)) {
+  }
+}
+
+double ExportStats::getAudioSeconds(const int64_t frames) const {
+  return sampleRate_ > 0 ? (double)frames / sampleRate_ : 0.0;
+}
+
+double ExportStats::getRealtimeFactor() const {
+  const double kSeconds = toSeconds(renderNanos_);
+  return kSeconds > 0.0 ? getAudioSeconds(renderedFrames_) / kSeconds : 0.0;
+}
+
+juce::var ExportStats::toVar() const {
+  // Throughput of work taking the given time, with the audio it covered
+  const auto describe = [this](juce::DynamicObject& object,
+                               const int64_t nanos, const int64_t frames,
+                               const int64_t bytes) {
+    const double kSeconds = toSeconds(nanos);
+    object.setProperty("seconds", kSeconds);
+    object.setProperty("frames", (juce::int64)frames);
+    object.setProperty("bytes", (juce::int64)bytes);
+    object.setProperty("frames_per_second",
+                       kSeconds > 0.0 ? frames / kSeconds : 0.0);
+    object.setProperty("bytes_per_second",
+                       kSeconds > 0.0 ? bytes / kSeconds : 0.0);
+    object.setProperty(
+        "realtime_factor",
+        kSeconds > 0.0 ? getAudioSeconds(frames) / kSeconds : 0.0);
+  };
+
+  juce::DynamicObject::Ptr report = new juce::DynamicObject();
+  report->setProperty("sample_rate", sampleRate_.load());
+  report->setProperty("audio_seconds", getAudioSeconds(renderedFrames_));
+  report->setProperty("max_queue_depth", maxQueueDepth_.load());
+
+  juce::DynamicObject::Ptr render = new juce::DynamicObject();
+  describe(*render, renderNanos_, renderedFrames_, 0);
+  report->setProperty("render", render.get());
+
+  juce::DynamicObject::Ptr stages = new juce::DynamicObject();
+  int64_t stageNanosDuringRender = 0;
+  for (int i = 0; i < kNumStages; ++i) {
+    const StageTotals& totals = stages_[i];
+    juce::DynamicObject::Ptr stage = new juce::DynamicObject();
+    describe(*stage, totals.nanos, totals.frames, totals.bytes);
+    stage->setProperty("calls", (juce::int64)totals.calls.load());
+    if (i == kStemEnqueue) {
+      // Time to queue blocks says nothing about how fast they are written
+      stage->removeProperty("bytes");
+      stage->removeProperty("bytes_per_second");
+    }
+    stages->setProperty(getStageName((Stage)i), stage.get());
+    if (i != kMux) {
+      stageNanosDuringRender += totals.nanos;
+    }
+  }
+  report->setProperty("stages", stages.get());
+  report->setProperty(
+      "host_and_renderer_seconds",
+      toSeconds(std::max<int64_t>(0, renderNanos_ - stageNanosDuringRender)));
+  return report.get();
+}
+
+juce::String ExportStats::getSummary() const {
+  juce::String summary =
+      "Last export: " + juce::String(getRealtimeFactor(), 1) + "x realtime";
+  for (const Stage stage : {kLoudness, kEncode, kStemEnqueue}) {
+    const double kSeconds = toSeconds(stages_[stage].nanos);
+    if (kSeconds > 0.0) {
+      summary << ", " << getStageName(stage) << " "
+              << juce::String(getAudioSeconds(stages_[stage].frames) / kSeconds,
+                              0)
+              << "x";
+    }
+  }
+  if (stages_[kMux].calls > 0) {
+    summary << ", mux " << juce::String(toSeconds(stages_[kMux].nanos), 1)
+            << " s";
+  }
+  return summary;
+}
+
+bool ExportStats::writeReport(const juce::File& file) const {
+  if (!file.replaceWithText(juce::JSON::toString(toVar()))) {
+    LOG_WARNING(0, "Export Stats: Failed to write " +
+                       file.getFullPathName().toStdString());
+    return false;
+  }
+  return true;
+}
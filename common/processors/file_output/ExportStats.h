@@ -0,0 +1,113 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_data_structures/juce_data_structures.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "data_repository/implementation/FileExportRepository.h"
+
+/**
+ * @brief Timings and throughput of one export, by stage.
+ *
+ * Every processor taking part in an export records into the same stats,
+ * which they find through the export's repository. Stages may record from
+ * any thread. Time the host and renderers spend on the audio is whatever
+ * part of the render is not accounted for by the stages.
+ */
+class ExportStats {
+ public:
+  // kStemEnqueue only covers queueing blocks for the audio element files,
+  // which are written on their own thread.
+  enum Stage { kLoudness, kEncode, kStemEnqueue, kMux, kNumStages };
+
+  // Times the enclosing scope as work of a stage on frames of audio.
+  class ScopedTimer {
+   public:
+    ScopedTimer(ExportStats* stats, const Stage stage, const int64_t frames)
+        : stats_(stats),
+          stage_(stage),
+          frames_(frames),
+          start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+      if (stats_ != nullptr) {
+        stats_->record(stage_, std::chrono::steady_clock::now() - start_,
+                       frames_, bytes_);
+      }
+    }
+
+    void addBytes(const int64_t bytes) { bytes_ += bytes; }
+
+   private:
+    ExportStats* stats_;
+    const Stage stage_;
+    const int64_t frames_;
+    int64_t bytes_ = 0;
+    const std::chrono::steady_clock::time_point start_;
+  };
+
+  // The stats of exports configured by the repository, created on first use.
+  // Keyed on the repository rather than its state tree, which loading a
+  // project replaces.
+  static std::shared_ptr<ExportStats> forExport(
+      const FileExportRepository& repository);
+
+  // The report written next to exportFile.
+  static juce::File getReportFile(const juce::String& exportFile);
+
+  static const char* getStageName(const Stage stage);
+
+  // Clear everything and start timing the render of an export.
+  void beginRender(const int sampleRate);
+  // Count frames of audio the host rendered for the export.
+  void addRenderedFrames(const int64_t frames) { renderedFrames_ += frames; }
+  void endRender();
+
+  void record(const Stage stage, const std::chrono::nanoseconds elapsed,
+              const int64_t frames, const int64_t bytes);
+
+  // Note how many jobs were ahead of the export on a queue it waited on.
+  void recordQueueDepth(const int depth);
+
+  double getRealtimeFactor() const;
+
+  juce::var toVar() const;
+  // One line for the export screen
+  juce::String getSummary() const;
+  bool writeReport(const juce::File& file) const;
+
+ private:
+  struct StageTotals {
+    std::atomic<int64_t> nanos{0};
+    std::atomic<int64_t> frames{0};
+    std::atomic<int64_t> bytes{0};
+    std::atomic<int64_t> calls{0};
+  };
+
+  double getAudioSeconds(const int64_t frames) const;
+
+  std::array<StageTotals, kNumStages> stages_;
+  std::atomic<int> sampleRate_{0};
+  std::atomic<int64_t> renderedFrames_{0};
+  std::atomic<int64_t> renderStart_{0};
+  std::atomic<int64_t> renderNanos_{0};
+  std::atomic<int> maxQueueDepth_{0};
+};
@@ -0,0 +1,112 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "FileExportJobQueue.h"
+
+FileExportJobQueue& FileExportJobQueue::getInstance() {
+  static FileExportJobQueue instance;
+  return instance;
+}
+
+FileExportJobQueue::FileExportJobQueue() : thread_([this] { run(); }) {}
+
+FileExportJobQueue::~FileExportJobQueue() {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    for (Entry& entry : pending_) {
+      entry.cancelled->store(true);
+    }
+    if (runningCancelled_ != nullptr) {
+      runningCancelled_->store(true);
+    }
+  }
+  jobAdded_.notify_all();
+  thread_.join();
+}
+
+void FileExportJobQueue::enqueue(const juce::ValueTree& owner, Job job,
+                                 Completion onComplete) {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back({owner, std::move(job), std::move(onComplete),
+                        std::make_shared<std::atomic_bool>(false)});
+  }
+  jobAdded_.notify_one();
+}
+
+void FileExportJobQueue::cancel(const juce::ValueTree& owner) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (Entry& entry : pending_) {
+    if (entry.owner == owner) {
+      entry.cancelled->store(true);
+    }
+  }
+  if (runningOwner_ == owner) {
+    runningCancelled_->store(true);
+    jobDone_.wait(lock, [&] { return runningOwner_ != owner; });
+  }
+}
+
+int FileExportJobQueue::getNumJobs() const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return (int)pending_.size() + (runningOwner_.isValid() ? 1 : 0);
+}
+
+bool FileExportJobQueue::hasJobs(const juce::ValueTree& owner) const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  if (runningOwner_ == owner) {
+    return true;
+  }
+  for (const Entry& entry : pending_) {
+    if (entry.owner == owner) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FileExportJobQueue::waitUntilIdle() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  jobDone_.wait(lock,
+                [&] { return pending_.empty() && !runningOwner_.isValid(); });
+}
+
+void FileExportJobQueue::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    jobAdded_.wait(lock, [&] { return stop_ || !pending_.empty(); });
+    if (pending_.empty()) {
+      return;
+    }
+
+    Entry entry = std::move(pending_.front());
+    pending_.pop_front();
+    runningOwner_ = entry.owner;
+    runningCancelled_ = entry.cancelled;
+    lock.unlock();
+
+    bool succeeded = false;
+    if (!entry.cancelled->load()) {
+      succeeded = entry.job(*entry.cancelled);
+    }
+    entry.onComplete(succeeded, entry.cancelled->load());
+    entry = {};
+
+    lock.lock();
+    runningOwner_ = juce::ValueTree();
+    runningCancelled_ = nullptr;
+    jobDone_.notify_all();
+  }
+}
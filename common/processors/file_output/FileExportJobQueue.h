@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_data_structures/juce_data_structures.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Runs post-bounce export work, such as muxing video, one job at a
+ * time on a background thread so that the host is not blocked.
+ *
+ * Jobs belong to the state tree of the export they were queued for. Queueing
+ * is shared by the whole process, so exports from several plugin instances
+ * wait their turn.
+ */
+class FileExportJobQueue {
+ public:
+  // Returns true if the job succeeded. Long jobs should poll cancelled.
+  using Job = std::function<bool(const std::atomic_bool& cancelled)>;
+  // Called on the queue's thread once the job has run or been cancelled.
+  using Completion = std::function<void(bool succeeded, bool cancelled)>;
+
+  static FileExportJobQueue& getInstance();
+
+  FileExportJobQueue();
+  ~FileExportJobQueue();
+
+  void enqueue(const juce::ValueTree& owner, Job job, Completion onComplete);
+
+  // Cancel every job of owner. Returns once its running job, if any, has
+  // stopped, so the caller may reuse the files it was writing.
+  void cancel(const juce::ValueTree& owner);
+
+  bool hasJobs(const juce::ValueTree& owner) const;
+
+  // Jobs queued or running, for every owner.
+  int getNumJobs() const;
+
+  // Block until every queued job has completed.
+  void waitUntilIdle();
+
+ private:
+  struct Entry {
+    juce::ValueTree owner;
+    Job job;
+    Completion onComplete;
+    std::shared_ptr<std::atomic_bool> cancelled;
+  };
+
+  void run();
+
+  mutable std::mutex mutex_;
+  std::condition_variable jobAdded_;
+  std::condition_variable jobDone_;
+  std::deque<Entry> pending_;
+  // The job being run, whose owner is empty while idle
+  juce::ValueTree runningOwner_;
+  std::shared_ptr<std::atomic_bool> runningCancelled_;
+  bool stop_ = false;
+  std::thread thread_;
+};
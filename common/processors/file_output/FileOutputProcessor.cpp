@@ -16,12 +16,16 @@
 
 #include <logger/logger.h>
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <string>
 
 #include "data_structures/src/AudioElement.h"
+#include "FileExportJobQueue.h"
 #include "data_structures/src/FileExport.h"
 #include "iamf_export_utils/IAMFExportUtil.h"
+#include "iamf_export_utils/IAMFSplicer.h"
 
 //==============================================================================
 FileOutputProcessor::FileOutputProcessor(
@@ -34,7 +38,8 @@ FileOutputProcessor::FileOutputProcessor(
       fileExportRepository_(fileExportRepository),
       audioElementRepository_(audioElementRepository),
       mixPresentationRepository_(mixPresentationRepository),
-      mixPresentationLoudnessRepository_(mixPresentationLoudnessRepository) {}
+      mixPresentationLoudnessRepository_(mixPresentationLoudnessRepository),
+      stats_(ExportStats::forExport(fileExportRepository)) {}
 
 FileOutputProcessor::~FileOutputProcessor() {}
 
@@ -65,8 +70,7 @@ void FileOutputProcessor::setNonRealtime(bool isNonRealtime) noexcept {
   FileExport config = fileExportRepository_.get();
   // Initialize the writer if we are rendering in offline mode
   if (!performingRender_) {
-    if ((config.getAudioFileFormat() == AudioFileFormat::IAMF) &&
-        (config.getExportAudio())) {
+    if (isExportedHere(config)) {
       initializeFileExport(config);
     }
     return;
@@ -83,42 +87,163 @@ void FileOutputProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                        juce::MidiBuffer& midiMessages) {
   juce::ignoreUnused(midiMessages);
 
+  if (incremental_) {
+    writePatchBlock(buffer);
+    return;
+  }
+
   if (!(shouldBufferBeWritten(buffer))) {
     // If we are not performing a render or the buffer is empty, do not write
     return;
   }
 
-  for (int i = 0; i < iamfWavFileWriters_.size(); ++i) {
-    iamfWavFileWriters_[i]->write(buffer);
+  writeBlock(buffer);
+}
+
+void FileOutputProcessor::writeBlock(juce::AudioBuffer<float>& buffer) {
+  const int kNumSamples = buffer.getNumSamples();
+  stats_->addRenderedFrames(kNumSamples);
+
+  if (!iamfWavFileWriters_.empty()) {
+    // Only hands the blocks to the writer thread, so no bytes are counted
+    ExportStats::ScopedTimer timer(stats_.get(), ExportStats::kStemEnqueue,
+                                   kNumSamples);
+    for (auto& writer : iamfWavFileWriters_) {
+      writer->write(buffer);
+    }
   }
 
+  // Times itself, as it knows the size of what it encodes
   if (iamfFileWriter_) {
     iamfFileWriter_->writeFrame(buffer);
   }
+
+  if (admFileWriter_) {
+    ExportStats::ScopedTimer timer(stats_.get(), ExportStats::kEncode,
+                                   kNumSamples);
+    admFileWriter_->writeFrame(buffer);
+  }
+}
+
+void FileOutputProcessor::writePatchBlock(
+    const juce::AudioBuffer<float>& buffer) {
+  const int kNumSamples = buffer.getNumSamples();
+  if (!performingRender_ || kNumSamples < 1 || sampleRate_ <= 0) {
+    return;
+  }
+
+  // Hosts rendering only the dirty range start part way through the
+  // timeline, so the position comes from the play head when there is one
+  long position = sampleTally_;
+  if (auto* playHead = getPlayHead()) {
+    const auto kPosition = playHead->getPosition();
+    if (kPosition.hasValue() && kPosition->getTimeInSamples().hasValue()) {
+      position = (long)*kPosition->getTimeInSamples();
+    }
+  }
+  sampleTally_ = position + kNumSamples;
+
+  if (patchFill_ > 0 && position != patchFrameStart_ + patchFill_) {
+    // The timeline jumped, so the frame being gathered can't be completed
+    patchFill_ = 0;
+  }
+  if (patchFrame_.getNumChannels() != buffer.getNumChannels()) {
+    patchFrame_.setSize(buffer.getNumChannels(), numSamples_);
+  }
+
+  int offset = 0;
+  while (offset < kNumSamples) {
+    if (patchFill_ == 0) {
+      // The first whole frame of the dirty range from here on
+      const long kFromOrigin = position + offset - frameOrigin_;
+      const long kFrame =
+          std::max(firstDirtyFrame_, kFromOrigin / numSamples_ +
+                                         (kFromOrigin % numSamples_ > 0));
+      patchFrameStart_ = frameOrigin_ + kFrame * numSamples_;
+      const long kFrameEnd = patchFrameStart_ + numSamples_;
+      if (patchFrameStart_ >= dirtyEnd_ ||
+          patchFrameStart_ >= position + kNumSamples ||
+          ((startTime_ != 0 || endTime_ != 0) &&
+           kFrameEnd / sampleRate_ > endTime_)) {
+        return;
+      }
+      if (firstPatchFrame_ < 0) {
+        firstPatchFrame_ = kFrame;
+      } else if (kFrame != firstPatchFrame_ + numPatchFrames_) {
+        patchBroken_ = true;
+      }
+      offset = (int)(patchFrameStart_ - position);
+    }
+
+    const int kCount =
+        std::min(numSamples_ - patchFill_, kNumSamples - offset);
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+      patchFrame_.copyFrom(ch, patchFill_, buffer, ch, offset, kCount);
+    }
+    patchFill_ += kCount;
+    offset += kCount;
+    if (patchFill_ == numSamples_) {
+      writeBlock(patchFrame_);
+      ++numPatchFrames_;
+      patchFill_ = 0;
+    }
+  }
+}
+
+void FileOutputProcessor::publishExportStats(const ExportStats& stats,
+                                             FileExport& config) {
+  stats.writeReport(ExportStats::getReportFile(
+      FileExport::expandTildePath(config.getExportFile())));
+  config.setExportSummary(stats.getSummary());
+}
+
+bool FileOutputProcessor::isExportedHere(const FileExport& config) {
+  return config.getExportAudio() &&
+         (config.getAudioFileFormat() == AudioFileFormat::IAMF ||
+          config.getAudioFileFormat() == AudioFileFormat::ADM);
 }
 
 //==============================================================================
 void FileOutputProcessor::initializeFileExport(FileExport& config) {
   LOG_ANALYTICS(0, "Beginning .iamf file export");
+  // The previous export's muxing would read files this one overwrites
+  FileExportJobQueue::getInstance().cancel(fileExportRepository_.getTree());
+  exportSuperseded_->store(true);
+  exportSuperseded_ = std::make_shared<std::atomic_bool>(false);
   performingRender_ = true;
+  stats_->beginRender(config.getSampleRate());
   startTime_ = config.getStartTime();
   endTime_ = config.getEndTime();
   std::string exportFile = config.getExportFile().toStdString();
 
-  // To create the IAMF file, create a list of all the audio element wav
-  // files to be created
-  juce::OwnedArray<AudioElement> audioElements;
-  audioElementRepository_.getAll(audioElements);
+  if (config.getAudioFileFormat() == AudioFileFormat::ADM) {
+    initializeADMExport(config);
+    return;
+  }
+  if (canExportIncrementally(config)) {
+    initializePatchExport(config);
+    return;
+  }
+
+  sampleRate_ = config.getSampleRate();
   iamfWavFileWriters_.clear();
-  iamfWavFileWriters_.reserve(audioElements.size());
-  for (int i = 0; i < audioElements.size(); i++) {
-    juce::String wavFilePath =
-        config.getExportFile() + "_audio_element_ " + juce::String(i) + ".wav";
-    sampleRate_ = config.getSampleRate();
+  if (config.getExportAudioElements()) {
+    // The IAMF file is encoded straight from the rendered blocks, so the
+    // per audio element files are only written when they were asked for.
+    // They are written on a background thread to keep disk I/O off the
+    // render.
+    juce::OwnedArray<AudioElement> audioElements;
+    audioElementRepository_.getAll(audioElements);
+    iamfWavFileWriters_.reserve(audioElements.size());
+    stemWriterThread_.startThread();
+    for (int i = 0; i < audioElements.size(); i++) {
+      juce::String wavFilePath = config.getExportFile() + "_audio_element_ " +
+                                 juce::String(i) + ".wav";
 
-    iamfWavFileWriters_.emplace_back(new AudioElementFileWriter(
-        wavFilePath, config.getSampleRate(), config.getBitDepth(),
-        config.getAudioCodec(), *audioElements[i]));
+      iamfWavFileWriters_.emplace_back(new AudioElementFileWriter(
+          wavFilePath, config.getSampleRate(), config.getBitDepth(),
+          config.getAudioCodec(), *audioElements[i], &stemWriterThread_));
+    }
   }
   sampleTally_ = 0;
 
@@ -126,6 +251,7 @@ void FileOutputProcessor::initializeFileExport(FileExport& config) {
   config.setSampleTally(sampleTally_);
   // Reset the export completed flag used by validation components
   config.setExportCompleted(false);
+  config.setExportCancelled(false);
   fileExportRepository_.update(config);
 
   iamfFileWriter_ = nullptr;
@@ -141,8 +267,15 @@ void FileOutputProcessor::initializeFileExport(FileExport& config) {
         mixPresentationRepository_, mixPresentationLoudnessRepository_,
         numSamples_, config.getSampleRate());
 
+    // Stream the IAMF track straight into the video export when there is
+    // video to mux it with, rather than muxing the .iamf afterwards
+    std::string mp4Path;
+    if (config.getExportVideo() && IAMFExportHelper::canMuxVideo(config)) {
+      mp4Path = config.getVideoExportFolder().toStdString();
+    }
+
     // Open the file for writing
-    bool openSuccess = iamfFileWriter_->open(kIamfPath.toStdString());
+    bool openSuccess = iamfFileWriter_->open(kIamfPath.toStdString(), mp4Path);
     if (!openSuccess) {
       iamfFileWriter_ = nullptr;
       LOG_ERROR(0, "IAMF File Writer: Failed to open file for writing: " +
@@ -154,40 +287,306 @@ void FileOutputProcessor::initializeFileExport(FileExport& config) {
   }
 }
 
+bool FileOutputProcessor::canExportIncrementally(const FileExport& config) {
+  if (!config.getIncrementalExport() ||
+      config.getAudioFileFormat() != AudioFileFormat::IAMF) {
+    return false;
+  }
+  if (config.getAudioCodec() == AudioCodec::OPUS) {
+    LOG_INFO(0,
+             "FileOutputProcessor: Opus frames depend on the frames before "
+             "them, so the whole file is exported.");
+    return false;
+  }
+  if (config.getDirtyEndTime() <= config.getDirtyStartTime() ||
+      !std::filesystem::exists(
+          FileExport::expandTildePath(config.getExportFile()).toStdString())) {
+    LOG_INFO(0,
+             "FileOutputProcessor: No previous export to splice into, so the "
+             "whole file is exported.");
+    return false;
+  }
+  return true;
+}
+
+std::filesystem::path FileOutputProcessor::getPatchFile(
+    const juce::String& exportFile) {
+  return (FileExport::expandTildePath(exportFile) + ".patch.iamf")
+      .toStdString();
+}
+
+void FileOutputProcessor::initializePatchExport(FileExport& config) {
+  LOG_ANALYTICS(0, "Re-exporting the dirty range of the .iamf file");
+  incremental_ = true;
+  sampleRate_ = config.getSampleRate();
+  sampleTally_ = 0;
+  iamfWavFileWriters_.clear();
+
+  // The previous export's first frame is the first block that
+  // shouldBufferBeWritten() let through
+  frameOrigin_ = 0;
+  if (startTime_ != 0 || endTime_ != 0) {
+    const long kStart = (long)startTime_ * sampleRate_;
+    frameOrigin_ = (kStart + numSamples_ - 1) / numSamples_ * numSamples_;
+  }
+  // The dirty range is in fractional seconds; whole frames overlapping it
+  // are re-encoded
+  const long kDirtyStart =
+      (long)std::llround(config.getDirtyStartTime() * sampleRate_);
+  firstDirtyFrame_ =
+      std::max(0L, (kDirtyStart - frameOrigin_) / numSamples_);
+  dirtyEnd_ = (long)std::llround(config.getDirtyEndTime() * sampleRate_);
+  patchFrame_.setSize(getTotalNumInputChannels(), numSamples_);
+  patchFill_ = 0;
+  firstPatchFrame_ = -1;
+  numPatchFrames_ = 0;
+  patchBroken_ = false;
+
+  config.setSampleTally(sampleTally_);
+  config.setExportCompleted(false);
+  config.setExportCancelled(false);
+  fileExportRepository_.update(config);
+
+  // Video is muxed from the .iamf once the patch is spliced into it
+  const std::string kPatchFile = getPatchFile(config.getExportFile()).string();
+  iamfFileWriter_ = std::make_unique<IAMFFileWriter>(
+      fileExportRepository_, audioElementRepository_,
+      mixPresentationRepository_, mixPresentationLoudnessRepository_,
+      numSamples_, config.getSampleRate());
+  if (!iamfFileWriter_->open(kPatchFile)) {
+    iamfFileWriter_ = nullptr;
+    LOG_ERROR(0, "IAMF File Writer: Failed to open file for writing: " +
+                     kPatchFile);
+  }
+}
+
+void FileOutputProcessor::initializeADMExport(FileExport& config) {
+  sampleRate_ = config.getSampleRate();
+  sampleTally_ = 0;
+  iamfWavFileWriters_.clear();
+  iamfFileWriter_ = nullptr;
+  config.setExportCompleted(false);
+  config.setExportCancelled(false);
+  fileExportRepository_.update(config);
+
+  admFileWriter_ = nullptr;
+  const juce::String kAdmPath =
+      FileExport::expandTildePath(config.getExportFile());
+  if (!FileExport::validateFilePath(kAdmPath.toStdString(), false)) {
+    LOG_WARNING(
+        0, "FileOutputProcessor: Cannot write ADM data to an invalid path.");
+    return;
+  }
+
+  admFileWriter_ = std::make_unique<ADMFileWriter>(
+      audioElementRepository_, mixPresentationRepository_,
+      config.getSampleRate(), config.getBitDepth());
+  if (!admFileWriter_->open(kAdmPath.toStdString())) {
+    admFileWriter_ = nullptr;
+    LOG_ERROR(0, "ADM File Writer: Failed to open file for writing: " +
+                     kAdmPath.toStdString());
+  }
+}
+
 void FileOutputProcessor::closeFileExport(FileExport& config) {
+  stats_->endRender();
+  if (admFileWriter_) {
+    LOG_ANALYTICS(0, "closing ADM BWF file");
+    const bool kAdmExported = admFileWriter_->close();
+    if (!kAdmExported) {
+      LOG_WARNING(0, "ADM File Writer: Failed to complete the file.");
+    }
+    admFileWriter_ = nullptr;
+    auto fe = fileExportRepository_.get();
+    if (kAdmExported) {
+      publishExportStats(*stats_, fe);
+    }
+    fe.setExportCompleted(true);
+    fileExportRepository_.update(fe);
+    return;
+  }
+
+  if (incremental_) {
+    closePatchExport();
+    return;
+  }
+
   LOG_ANALYTICS(0, "closing writers and exporting IAMF file");
   // close the output file, since rendering is completed
   for (auto& writer : iamfWavFileWriters_) {
     writer->close();
   }
 
-  // If muxing is enabled and audio export was successful, mux the audio and
-  // video files.
   const bool kIamfExported = iamfFileWriter_ ? iamfFileWriter_->close() : false;
-  if (kIamfExported && fileExportRepository_.get().getExportVideo()) {
-    const bool kMuxIamfSuccess =
-        IAMFExportHelper::muxIAMF(fileExportRepository_.get());
-
-    if (!kMuxIamfSuccess) {
-      LOG_WARNING(0,
-                  "IAMF Muxing: Failed to mux IAMF file with provided video.");
-    }
-  }
 
-  if (!config.getExportAudioElements()) {
-    // Delete the extraneuos audio element files
-    for (auto& writer : iamfWavFileWriters_) {
-      juce::File audioElementFile(writer->getFilePath());
-      audioElementFile.deleteFile();
-    }
-  }
   iamfWavFileWriters_.clear();
+  stemWriterThread_.stopThread(1000);
 
+  // If muxing is enabled and audio export was successful, mux the audio and
+  // video files in the background. The export completes once that is done.
   auto fe = fileExportRepository_.get();
+  if (kIamfExported && fe.getExportVideo()) {
+    fe.setMuxProgress(0.f);
+    fileExportRepository_.update(fe);
+    enqueueMuxJob(fe, iamfFileWriter_->hasWrittenMp4());
+    return;
+  }
+  if (kIamfExported) {
+    publishExportStats(*stats_, fe);
+  }
   fe.setExportCompleted(true);
   fileExportRepository_.update(fe);
 }
 
+void FileOutputProcessor::closePatchExport() {
+  LOG_ANALYTICS(0, "closing the re-exported range of the IAMF file");
+  incremental_ = false;
+  const bool kEncoded = iamfFileWriter_ ? iamfFileWriter_->close() : false;
+  iamfFileWriter_ = nullptr;
+
+  auto fe = fileExportRepository_.get();
+  if (!kEncoded || numPatchFrames_ == 0 || patchBroken_) {
+    LOG_WARNING(0,
+                "FileOutputProcessor: The dirty range was not re-exported in "
+                "one piece, so the previous export was kept.");
+    std::error_code ec;
+    std::filesystem::remove(getPatchFile(fe.getExportFile()), ec);
+    fe.setExportCompleted(true);
+    fileExportRepository_.update(fe);
+    return;
+  }
+
+  enqueueSpliceJob(fe);
+  if (fe.getExportVideo()) {
+    // Queued jobs run in turn, so this muxes the spliced file
+    fe.setMuxProgress(0.f);
+    fileExportRepository_.update(fe);
+    enqueueMuxJob(fe, false);
+  }
+}
+
+void FileOutputProcessor::enqueueSpliceJob(const FileExport& config) {
+  const juce::ValueTree kState = fileExportRepository_.getTree();
+  const std::filesystem::path kExportFile =
+      FileExport::expandTildePath(config.getExportFile()).toStdString();
+  const std::filesystem::path kPatchFile =
+      getPatchFile(config.getExportFile());
+  const size_t kFirstFrame = (size_t)firstPatchFrame_;
+  const std::shared_ptr<const std::atomic_bool> kSuperseded =
+      exportSuperseded_;
+
+  auto splice = [kExportFile, kPatchFile,
+                 kFirstFrame](const std::atomic_bool& cancelled) {
+    const bool kSpliced = IAMFSplicer::spliceFile(kExportFile, kPatchFile,
+                                                  kFirstFrame, cancelled);
+    std::error_code ec;
+    std::filesystem::remove(kPatchFile, ec);
+    return kSpliced;
+  };
+
+  // With video, the mux job queued after this one completes the export
+  auto complete = [kState, kSuperseded, kExportVideo = config.getExportVideo(),
+                   stats = stats_](const bool succeeded,
+                                   const bool cancelled) {
+    if (cancelled) {
+      return;
+    }
+    if (!succeeded) {
+      LOG_WARNING(0, "IAMF Splicer: Kept the previous export.");
+    }
+    if (kExportVideo) {
+      return;
+    }
+    postExportUpdate(kState, kSuperseded, [stats](FileExport& fe) {
+      publishExportStats(*stats, fe);
+      fe.setExportCompleted(true);
+    });
+  };
+
+  FileExportJobQueue::getInstance().enqueue(kState, std::move(splice),
+                                            std::move(complete));
+}
+
+void FileOutputProcessor::postExportUpdate(
+    const juce::ValueTree& state,
+    const std::shared_ptr<const std::atomic_bool>& superseded,
+    std::function<void(FileExport&)> update) {
+  auto apply = [state, superseded, update = std::move(update)] {
+    if (superseded != nullptr && superseded->load()) {
+      return;
+    }
+    FileExportRepository repository(state);
+    auto fe = repository.get();
+    update(fe);
+    repository.update(fe);
+  };
+  // Without a message loop, e.g. in tests, there is no listener to race with
+  if (juce::MessageManager::getInstanceWithoutCreating() == nullptr) {
+    apply();
+    return;
+  }
+  juce::MessageManager::callAsync(std::move(apply));
+}
+
+void FileOutputProcessor::enqueueMuxJob(const FileExport& config,
+                                        const bool audioMuxed) {
+  // Premiere Pro destroys this processor as soon as the render ends, so the
+  // job reports through its own handle on the repository's state.
+  const juce::ValueTree kState = fileExportRepository_.getTree();
+  const std::shared_ptr<const std::atomic_bool> kSuperseded =
+      exportSuperseded_;
+
+  auto mux = [kState, kSuperseded, config, audioMuxed,
+              stats = stats_](const std::atomic_bool& cancelled) {
+    ExportStats::ScopedTimer timer(stats.get(), ExportStats::kMux, 0);
+    float reported = 0.f;
+    const bool kMuxed = IAMFExportHelper::muxIAMF(
+        config, audioMuxed, [&](const float progress) {
+          // Each update notifies the repository's listeners, so only
+          // report whole percents
+          if (progress - reported >= 0.01f) {
+            reported = progress;
+            postExportUpdate(kState, kSuperseded, [progress](FileExport& fe) {
+              fe.setMuxProgress(progress);
+            });
+          }
+          return !cancelled.load();
+        });
+    if (kMuxed) {
+      std::error_code ec;
+      const auto kBytes = std::filesystem::file_size(
+          FileExport::expandTildePath(config.getVideoExportFolder())
+              .toStdString(),
+          ec);
+      timer.addBytes(ec ? 0 : (int64_t)kBytes);
+    }
+    return kMuxed;
+  };
+
+  auto complete = [kState, kSuperseded, stats = stats_](
+                      const bool succeeded, const bool cancelled) {
+    if (cancelled) {
+      // Superseded by a new export, which will complete in its place, or
+      // cancelled from the export screen, which completed the export
+      LOG_INFO(0, "IAMF Muxing: Cancelled.");
+      return;
+    }
+    if (!succeeded) {
+      LOG_WARNING(0,
+                  "IAMF Muxing: Failed to mux IAMF file with provided video.");
+    }
+    postExportUpdate(kState, kSuperseded, [stats](FileExport& fe) {
+      publishExportStats(*stats, fe);
+      fe.setMuxProgress(1.f);
+      fe.setExportCompleted(true);
+    });
+  };
+
+  stats_->recordQueueDepth(FileExportJobQueue::getInstance().getNumJobs());
+  FileExportJobQueue::getInstance().enqueue(kState, std::move(mux),
+                                            std::move(complete));
+}
+
 bool FileOutputProcessor::shouldBufferBeWritten(
     const juce::AudioBuffer<float>& buffer) {
   if (!performingRender_ || buffer.getNumSamples() < 1) {
@@ -27,10 +27,15 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 
+#include <atomic>
+#include <filesystem>
+#include <functional>
 #include <memory>
 
 #include "../processor_base/ProcessorBase.h"
 #include "AudioElementFileWriter.h"
+#include "ExportStats.h"
+#include "adm_export_utils/ADMFileWriter.h"
 #include "data_repository/implementation/MixPresentationLoudnessRepository.h"
 #include "iamf_export_utils/IAMFFileWriter.h"
 
@@ -60,6 +65,14 @@ class FileOutputProcessor : public ProcessorBase {
   //==============================================================================
   const juce::String getName() const override;
 
+  // Apply update to the export's repository on the message thread, where the
+  // export screen listens to it, unless a newer export has started since.
+  // superseded may be null for updates that always apply.
+  static void postExportUpdate(
+      const juce::ValueTree& state,
+      const std::shared_ptr<const std::atomic_bool>& superseded,
+      std::function<void(FileExport&)> update);
+
  protected:
   juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout() {
     juce::AudioProcessorValueTreeState::ParameterLayout params;
@@ -76,10 +89,43 @@ class FileOutputProcessor : public ProcessorBase {
         .withLabel(label);
   }
 
+  // Whether config asks for a file this processor writes.
+  static bool isExportedHere(const FileExport& config);
+
   void initializeFileExport(FileExport& config);
 
+  void initializeADMExport(FileExport& config);
+
+  // Whether the dirty range of config can be spliced into its previous
+  // export rather than exporting the whole file again.
+  static bool canExportIncrementally(const FileExport& config);
+
+  // Where the dirty range is encoded before it is spliced into exportFile.
+  static std::filesystem::path getPatchFile(const juce::String& exportFile);
+
+  void initializePatchExport(FileExport& config);
+
   void closeFileExport(FileExport& config);
 
+  void closePatchExport();
+
+  // Write the block to every file being exported.
+  void writeBlock(juce::AudioBuffer<float>& buffer);
+
+  // Gather the dirty range into frames lined up with the temporal units of
+  // the previous export, and encode them.
+  void writePatchBlock(const juce::AudioBuffer<float>& buffer);
+
+  // Write the stats report next to the exported file and show its summary.
+  static void publishExportStats(const ExportStats& stats, FileExport& config);
+
+  // Mux the finished export with its video on the export job queue.
+  void enqueueMuxJob(const FileExport& config, const bool audioMuxed);
+
+  // Splice the encoded dirty range into the previous export on the export
+  // job queue.
+  void enqueueSpliceJob(const FileExport& config);
+
   bool shouldBufferBeWritten(const juce::AudioBuffer<float>& buffer);
 
   bool performingRender_;  // True if we are rendering in offline mode
@@ -87,6 +133,9 @@ class FileOutputProcessor : public ProcessorBase {
   AudioElementRepository& audioElementRepository_;
   MixPresentationRepository& mixPresentationRepository_;
   MixPresentationLoudnessRepository& mixPresentationLoudnessRepository_;
+  // Writes the audio element files queued by iamfWavFileWriters_, so it must
+  // outlive them
+  juce::TimeSliceThread stemWriterThread_{"Audio element file writer"};
   std::vector<std::unique_ptr<AudioElementFileWriter>> iamfWavFileWriters_;
   int numSamples_;
   long sampleRate_;
@@ -94,6 +143,26 @@ class FileOutputProcessor : public ProcessorBase {
   int endTime_;
   long sampleTally_;
   std::unique_ptr<IAMFFileWriter> iamfFileWriter_;
+  std::unique_ptr<ADMFileWriter> admFileWriter_;
+  std::shared_ptr<ExportStats> stats_;
+  // Set once a newer export starts, so updates posted for the jobs of the
+  // previous one are dropped
+  std::shared_ptr<std::atomic_bool> exportSuperseded_ =
+      std::make_shared<std::atomic_bool>(false);
+  // Incremental export state, in samples of the host's timeline. Frames
+  // start frameOrigin_ plus a multiple of numSamples_, like the temporal
+  // units of the previous export.
+  bool incremental_ = false;
+  long frameOrigin_ = 0;
+  long firstDirtyFrame_ = 0;
+  long dirtyEnd_ = 0;
+  juce::AudioBuffer<float> patchFrame_;
+  int patchFill_ = 0;
+  long patchFrameStart_ = 0;
+  long firstPatchFrame_ = -1;
+  long numPatchFrames_ = 0;
+  // Set if the host skipped part of the dirty range
+  bool patchBroken_ = false;
   //==============================================================================
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FileOutputProcessor)
 };
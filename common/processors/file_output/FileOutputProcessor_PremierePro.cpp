@@ -69,8 +69,7 @@ void PremiereProFileOutputProcessor::setNonRealtime(
 
   // Initialize the writer if we are rendering in offline mode
   if (isNonRealtime && !performingRender_) {
-    if ((config.getAudioFileFormat() == AudioFileFormat::IAMF) &&
-        (config.getExportAudio())) {
+    if (isExportedHere(config)) {
       initializeFileExport(config);
     }
     return;
@@ -81,14 +80,14 @@ void PremiereProFileOutputProcessor::processBlock(
     juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
   juce::ignoreUnused(midiMessages);
 
-  if (!shouldBufferBeWritten(buffer)) {
+  if (incremental_) {
+    writePatchBlock(buffer);
     return;
   }
 
-  //  Write the audio data to the wav file writers
-  for (auto& writer : iamfWavFileWriters_) {
-    writer->write(buffer);
+  if (!shouldBufferBeWritten(buffer)) {
+    return;
   }
 
-  iamfFileWriter_->writeFrame(buffer);
+  writeBlock(buffer);
 }
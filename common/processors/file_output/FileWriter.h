@@ -15,21 +15,42 @@
  */
 
 #pragma once
+#include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 
+#include <memory>
+#include <vector>
+
 #include "data_structures/src/FileExport.h"
 
 class FileWriter {
  public:
+  // Seconds of audio buffered ahead of a background writer thread
+  static constexpr int kBackgroundBufferSeconds = 4;
+
+  // Writes a FLAC file, with a .flac extension, when codec is FLAC and FLAC
+  // can hold the channel count and bit depth, and a WAV file otherwise. When
+  // backgroundThread is given, blocks are queued and written on it.
   FileWriter(const juce::String& filename, double sampleRate, int numChannels,
-             int firstChannel, int bitDepth, AudioCodec codec)
+             int firstChannel, int bitDepth, AudioCodec codec,
+             juce::TimeSliceThread* backgroundThread = nullptr)
       : numChannels_(numChannels),
         firstChannel_(firstChannel),
         outputFile_(filename),
-        bitDepth_(bitDepth) {
+        bitDepth_(bitDepth),
+        channelPointers_(numChannels) {
+    const bool useFlac = codec == AudioCodec::FLAC && numChannels_ <= 8 &&
+                       (bitDepth_ == 16 || bitDepth_ == 24);
+    juce::WavAudioFormat wavFormat;
+    juce::FlacAudioFormat flacFormat;
+    juce::AudioFormat& format = useFlac ? (juce::AudioFormat&)flacFormat
+                                        : (juce::AudioFormat&)wavFormat;
+    if (useFlac) {
+      outputFile_ = outputFile_.withFileExtension(".flac");
+    }
+
     outputFile_.deleteFile();
-    juce::WavAudioFormat format;
     writer_ = format.createWriterFor(new juce::FileOutputStream(outputFile_),
                                      sampleRate,    // Sample Rate
                                      numChannels_,  // Number of channels
@@ -37,12 +58,31 @@ class FileWriter {
                                      {},
                                      0  // Quality option index
     );
+    if (writer_ != nullptr && backgroundThread != nullptr) {
+      threadedWriter_ =
+          std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(
+              writer_, *backgroundThread,
+              (int)sampleRate * kBackgroundBufferSeconds);
+      // Now owned by the threaded writer
+      writer_ = nullptr;
+    }
   }
 
   ~FileWriter() { close(); };
 
   void write(juce::AudioBuffer<float>& buffer) {
-    if (writer_ != nullptr) {
+    if (threadedWriter_ != nullptr) {
+      for (int ch = 0; ch < numChannels_; ++ch) {
+        channelPointers_[ch] = buffer.getReadPointer(firstChannel_ + ch);
+      }
+      // The queue only fills when rendering outpaces the disk. Wait for it
+      // rather than drop audio from the file.
+      while (!threadedWriter_->write(channelPointers_.data(),
+                                     buffer.getNumSamples())) {
+        juce::Thread::sleep(1);
+      }
+      framesWritten += buffer.getNumSamples();
+    } else if (writer_ != nullptr) {
       juce::AudioBuffer<float> toWrite;
       toWrite.setDataToReferTo(&buffer.getArrayOfWritePointers()[firstChannel_],
                                numChannels_, buffer.getNumSamples());
@@ -52,6 +92,8 @@ class FileWriter {
   }
 
   void close() {
+    // Blocks until the queued audio is written
+    threadedWriter_ = nullptr;
     if (writer_ != nullptr) {
       writer_->flush();
       delete writer_;
@@ -67,9 +109,11 @@ class FileWriter {
 
  private:
   juce::AudioFormatWriter* writer_;
+  std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> threadedWriter_;
   juce::File outputFile_;
-  int framesWritten;
+  int framesWritten = 0;
   int numChannels_;
   int firstChannel_;
   int bitDepth_;
-};
\ No newline at end of file
+  std::vector<const float*> channelPointers_;
+};
@@ -14,6 +14,9 @@
 
 #include "WavFileOutputProcessor.h"
 
+#include <logger/logger.h>
+
+#include "FileOutputProcessor.h"
 #include "data_repository/implementation/FileExportRepository.h"
 #include "data_repository/implementation/RoomSetupRepository.h"
 #include "data_structures/src/FileExport.h"
@@ -28,7 +31,7 @@ WavFileOutputProcessor::WavFileOutputProcessor(
       numSamples_(0),
       sampleRate_(0),
       performingRender_(false),
-      fileWriter_(nullptr) {
+      waitForDisk_(false) {
   fileExportRepository_.registerListener(this);
 }
 
@@ -64,41 +67,62 @@ void WavFileOutputProcessor::processBlock(juce::AudioBuffer<float>& buffer,
       auto position = getPlayHead()->getPosition();
       if ((endTime_ == 0) || (position->getTimeInSeconds() >= startTime_ &&
                               position->getTimeInSeconds() <= endTime_)) {
-        fileWriter_->write(buffer);
+        fileWriter_->write(buffer, waitForDisk_);
       }
     } else {
-      fileWriter_->write(buffer);
+      fileWriter_->write(buffer, waitForDisk_);
     }
   }
   lock_.exit();
 }
 
 void WavFileOutputProcessor::setNonRealtime(bool isNonRealtime) noexcept {
-  lock_.enter();
+  // The file is created and completed outside of the lock, so processBlock
+  // is only locked out for as long as it takes to swap the writer
   if (!performingRender_) {
     // Start Rendering
     FileExport configParams = fileExportRepository_.get();
     RoomSetup roomSetup = roomSetupRepository_.get();
-    startTime_ = configParams.getStartTime();
-    endTime_ = configParams.getEndTime();
     if ((configParams.getAudioFileFormat() == AudioFileFormat::WAV) &&
         configParams.getExportAudio()) {
-      fileWriter_ = new FileWriter(
-          configParams.getExportFile(), configParams.getSampleRate(),
+      auto writer = std::make_unique<AsyncWavFileWriter>(
           roomSetup.getSpeakerLayout().getRoomSpeakerLayout().getNumChannels(),
-          0, configParams.getBitDepth(), configParams.getAudioCodec());
+          configParams.getSampleRate(), configParams.getBitDepth());
+      const std::string kPath = configParams.getExportFile().toStdString();
+      if (!writer->open(kPath)) {
+        LOG_ERROR(0, "WAV Writer: Failed to open file for writing: " + kPath);
+        writer = nullptr;
+      }
+
+      const juce::SpinLock::ScopedLockType lock(lock_);
+      startTime_ = configParams.getStartTime();
+      endTime_ = configParams.getEndTime();
+      waitForDisk_ = !configParams.getManualExport();
+      fileWriter_ = std::move(writer);
       performingRender_ = true;
     }
   } else {
     // Complete Rendering
-    if (fileWriter_ != nullptr) {
-      fileWriter_->close();
-      delete fileWriter_;
-      fileWriter_ = nullptr;
+    std::unique_ptr<AsyncWavFileWriter> writer;
+    {
+      const juce::SpinLock::ScopedLockType lock(lock_);
+      writer = std::move(fileWriter_);
+      performingRender_ = false;
+    }
+    if (writer != nullptr) {
+      if (!writer->close()) {
+        LOG_WARNING(0, "WAV Writer: Failed to complete the file.");
+      }
+      reportDroppedSamples(writer->getDroppedSamples());
     }
-    performingRender_ = false;
   }
-  lock_.exit();
+}
+
+void WavFileOutputProcessor::reportDroppedSamples(const int64_t dropped) {
+  // Render end is signalled on the host's render thread
+  FileOutputProcessor::postExportUpdate(
+      fileExportRepository_.getTree(), nullptr,
+      [dropped](FileExport& config) { config.setDroppedSamples(dropped); });
 }
 
 void WavFileOutputProcessor::checkManualExportStartStop() {
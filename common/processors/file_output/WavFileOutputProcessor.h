@@ -22,8 +22,8 @@
 #include <memory>
 
 #include "../processor_base/ProcessorBase.h"
+#include "AsyncWavFileWriter.h"
 #include "AudioElementFileWriter.h"
-#include "FileWriter.h"
 #include "data_repository/implementation/RoomSetupRepository.h"
 #include "data_structures/src/RoomSetup.h"
 #include "user_metadata.pb.h"
@@ -59,10 +59,16 @@ class WavFileOutputProcessor final : public ProcessorBase,
   const juce::String getName() { return "WaveFileOutput"; }
 
  private:
+  // Publish how much audio the last export dropped, for the UI
+  void reportDroppedSamples(const int64_t dropped);
+
   bool performingRender_;  // True if we are rendering in offline mode
   FileExportRepository& fileExportRepository_;
   RoomSetupRepository& roomSetupRepository_;
-  FileWriter* fileWriter_;
+  std::unique_ptr<AsyncWavFileWriter> fileWriter_;
+  // Whether a full write queue should hold up processBlock rather than drop
+  // audio. Only offline renders by the host can afford to wait.
+  bool waitForDisk_;
   int numSamples_;
   int sampleRate_;
   int startTime_;
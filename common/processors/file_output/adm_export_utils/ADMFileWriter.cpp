@@ -0,0 +1,346 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ADMFileWriter.h"
+
+#include <logger/logger.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+// ADM typeLabel of each kind of pack
+constexpr int kTypeDirectSpeakers = 1;
+constexpr int kTypeHoa = 4;
+constexpr int kTypeBinaural = 5;
+// First ID of the range BS.2076 leaves for custom definitions
+constexpr int kFirstCustomId = 0x1001;
+
+struct SpeakerPosition {
+  const char* label;     // As returned by getSpeakerLabels()
+  const char* itu;       // BS.2051 speaker label
+  float azimuth;
+  float elevation;
+};
+
+const SpeakerPosition kSpeakerPositions[] = {
+    {"M", "M+000", 0.f, 0.f},       {"C", "M+000", 0.f, 0.f},
+    {"FC", "M+000", 0.f, 0.f},      {"L", "M+030", 30.f, 0.f},
+    {"R", "M-030", -30.f, 0.f},     {"FLc", "M+030", 30.f, 0.f},
+    {"FRc", "M-030", -30.f, 0.f},   {"FL", "M+060", 60.f, 0.f},
+    {"FR", "M-060", -60.f, 0.f},    {"LFE", "LFE1", 45.f, -30.f},
+    {"Ls", "M+110", 110.f, 0.f},    {"Rs", "M-110", -110.f, 0.f},
+    {"Lss", "M+090", 90.f, 0.f},    {"Rss", "M-090", -90.f, 0.f},
+    {"SiL", "M+090", 90.f, 0.f},    {"SiR", "M-090", -90.f, 0.f},
+    {"Lrs", "M+135", 135.f, 0.f},   {"Rrs", "M-135", -135.f, 0.f},
+    {"BL", "M+135", 135.f, 0.f},    {"BR", "M-135", -135.f, 0.f},
+    {"Ltf", "U+045", 45.f, 30.f},   {"Rtf", "U-045", -45.f, 30.f},
+    {"TpFL", "U+045", 45.f, 30.f},  {"TpFR", "U-045", -45.f, 30.f},
+    {"Ltr", "U+135", 135.f, 30.f},  {"Rtr", "U-135", -135.f, 30.f},
+    {"Ltb", "U+135", 135.f, 30.f},  {"Rtb", "U-135", -135.f, 30.f},
+    {"TpBL", "U+135", 135.f, 30.f}, {"TpBR", "U-135", -135.f, 30.f},
+    {"TpSiL", "U+090", 90.f, 30.f}, {"TpSiR", "U-090", -90.f, 30.f},
+};
+
+const SpeakerPosition* findSpeaker(const juce::String& label) {
+  for (const SpeakerPosition& speaker : kSpeakerPositions) {
+    if (label == speaker.label) {
+      return &speaker;
+    }
+  }
+  return nullptr;
+}
+
+// Element kinds of audioFormatExtended, in the order BS.2076 lists them
+enum AdmKind {
+  kProgramme,
+  kContent,
+  kObject,
+  kPackFormat,
+  kChannelFormat,
+  kStreamFormat,
+  kTrackFormat,
+  kTrackUid,
+  kNumKinds
+};
+
+juce::String formatId(const char* prefix, int id) {
+  char text[32];
+  std::snprintf(text, sizeof(text), "%s_%04X", prefix, id);
+  return text;
+}
+
+juce::String formatId(const char* prefix, int type, int id) {
+  char text[32];
+  std::snprintf(text, sizeof(text), "%s_%04X%04X", prefix, type, id);
+  return text;
+}
+
+juce::String formatTypeLabel(int type) {
+  char text[8];
+  std::snprintf(text, sizeof(text), "%04X", type);
+  return text;
+}
+
+juce::String formatTrackUid(int track) {
+  char text[16];
+  std::snprintf(text, sizeof(text), "ATU_%08X", track);
+  return text;
+}
+
+void addRef(juce::XmlElement& element, const char* name,
+            const juce::String& id) {
+  element.createNewChildElement(name)->addTextElement(id);
+}
+
+void addPosition(juce::XmlElement& block, const char* coordinate,
+                 float value) {
+  auto* position = block.createNewChildElement("position");
+  position->setAttribute("coordinate", coordinate);
+  position->addTextElement(juce::String(value, 1));
+}
+
+// Describe channel `index` of an audio element in its audioBlockFormat.
+void describeChannel(juce::XmlElement& block, int type, int index,
+                     const juce::String& speakerLabel) {
+  if (type == kTypeHoa) {
+    // ACN channel ordering with SN3D normalisation, as IAMF uses
+    const int order = (int)std::sqrt((double)index);
+    addRef(block, "order", juce::String(order));
+    addRef(block, "degree", juce::String(index - order * (order + 1)));
+    addRef(block, "normalization", "SN3D");
+    return;
+  }
+  if (type == kTypeBinaural) {
+    return;
+  }
+
+  const SpeakerPosition* speaker = findSpeaker(speakerLabel);
+  if (speaker == nullptr) {
+    LOG_WARNING(0, "ADM Export: No position for speaker " +
+                       speakerLabel.toStdString());
+  }
+  addRef(block, "speakerLabel",
+         speaker != nullptr ? juce::String(speaker->itu) : speakerLabel);
+  addPosition(block, "azimuth", speaker != nullptr ? speaker->azimuth : 0.f);
+  addPosition(block, "elevation",
+              speaker != nullptr ? speaker->elevation : 0.f);
+  addPosition(block, "distance", 1.f);
+  if (speakerLabel == "LFE") {
+    auto* frequency = block.createNewChildElement("frequency");
+    frequency->setAttribute("typeDefinition", "lowPass");
+    frequency->addTextElement("120");
+  }
+}
+
+void appendChnaEntry(std::vector<char>& chna, int track,
+                     const juce::String& trackFormatId,
+                     const juce::String& packId) {
+  // trackIndex, UID (12), trackRef (14), packRef (11) and a pad byte
+  char entry[40] = {};
+  entry[0] = (char)(track & 0xff);
+  entry[1] = (char)(track >> 8);
+  std::memcpy(entry + 2, formatTrackUid(track).toRawUTF8(), 12);
+  std::memcpy(entry + 14, trackFormatId.toRawUTF8(), 14);
+  std::memcpy(entry + 28, packId.toRawUTF8(), 11);
+  chna.insert(chna.end(), entry, entry + sizeof(entry));
+}
+}  // namespace
+
+ADMFileWriter::ADMFileWriter(
+    AudioElementRepository& audioElementRepository,
+    MixPresentationRepository& mixPresentationRepository, int sampleRate,
+    int bitDepth)
+    : audioElementRepository_(audioElementRepository),
+      mixPresentationRepository_(mixPresentationRepository),
+      sampleRate_(sampleRate),
+      bitDepth_(bitDepth) {}
+
+ADMFileWriter::~ADMFileWriter() { close(); }
+
+ADMMetadata ADMFileWriter::createMetadata(
+    const juce::OwnedArray<AudioElement>& audioElements,
+    const juce::OwnedArray<MixPresentation>& mixPresentations,
+    int sampleRate, int bitDepth) {
+  ADMMetadata metadata;
+  juce::XmlElement root("ebuCoreMain");
+  root.setAttribute("xmlns", "urn:ebu:metadata-schema:ebucore");
+  auto* format = root.createNewChildElement("coreMetadata")
+                     ->createNewChildElement("format");
+  auto* adm = format->createNewChildElement("audioFormatExtended");
+  adm->setAttribute("version", "ITU-R_BS.2076-2");
+  // Collects each kind of element, to be added to adm in order
+  std::vector<juce::XmlElement> kinds(kNumKinds, juce::XmlElement("kind"));
+
+  // The track count is written first, patched once it is known
+  metadata.chna.resize(4);
+  int track = 0;
+  int channelId = kFirstCustomId;
+  std::unordered_map<juce::Uuid, juce::String> contentIds;
+
+  for (int e = 0; e < audioElements.size(); ++e) {
+    const AudioElement& element = *audioElements[e];
+    const auto layout = element.getChannelConfig();
+    const int type = layout.isAmbisonics()        ? kTypeHoa
+                     : layout == Speakers::kBinaural ? kTypeBinaural
+                                                     : kTypeDirectSpeakers;
+    const char* typeDefinition = type == kTypeHoa        ? "HOA"
+                                 : type == kTypeBinaural ? "Binaural"
+                                                         : "DirectSpeakers";
+    const juce::String packId = formatId("AP", type, kFirstCustomId + e);
+    const juce::String objectId = formatId("AO", kFirstCustomId + e);
+    const juce::String contentId = formatId("ACO", kFirstCustomId + e);
+    contentIds[element.getId()] = contentId;
+
+    auto* content = kinds[kContent].createNewChildElement("audioContent");
+    content->setAttribute("audioContentID", contentId);
+    content->setAttribute("audioContentName", element.getName());
+    addRef(*content, "audioObjectIDRef", objectId);
+
+    auto* object = kinds[kObject].createNewChildElement("audioObject");
+    object->setAttribute("audioObjectID", objectId);
+    object->setAttribute("audioObjectName", element.getName());
+    addRef(*object, "audioPackFormatIDRef", packId);
+
+    auto* pack = kinds[kPackFormat].createNewChildElement("audioPackFormat");
+    pack->setAttribute("audioPackFormatID", packId);
+    pack->setAttribute("audioPackFormatName", layout.toString());
+    pack->setAttribute("typeLabel", formatTypeLabel(type));
+    pack->setAttribute("typeDefinition", typeDefinition);
+
+    const std::vector<juce::String> labels = layout.getSpeakerLabels();
+    for (int ch = 0; ch < element.getChannelCount(); ++ch, ++channelId) {
+      const juce::String channelFormatId = formatId("AC", type, channelId);
+      const juce::String streamId = formatId("AS", type, channelId);
+      const juce::String trackFormatId = formatId("AT", type, channelId) + "_01";
+      const juce::String label =
+          ch < (int)labels.size() ? labels[ch] : juce::String(ch + 1);
+      addRef(*pack, "audioChannelFormatIDRef", channelFormatId);
+
+      auto* channel =
+          kinds[kChannelFormat].createNewChildElement("audioChannelFormat");
+      channel->setAttribute("audioChannelFormatID", channelFormatId);
+      channel->setAttribute("audioChannelFormatName",
+                            type == kTypeHoa ? "ACN" + juce::String(ch) : label);
+      channel->setAttribute("typeLabel", formatTypeLabel(type));
+      channel->setAttribute("typeDefinition", typeDefinition);
+      auto* block = channel->createNewChildElement("audioBlockFormat");
+      block->setAttribute("audioBlockFormatID",
+                          channelFormatId.replace("AC_", "AB_") + "_00000001");
+      describeChannel(*block, type, ch, label);
+
+      auto* stream =
+          kinds[kStreamFormat].createNewChildElement("audioStreamFormat");
+      stream->setAttribute("audioStreamFormatID", streamId);
+      stream->setAttribute("audioStreamFormatName", "PCM_" + label);
+      stream->setAttribute("formatLabel", "0001");
+      stream->setAttribute("formatDefinition", "PCM");
+      addRef(*stream, "audioChannelFormatIDRef", channelFormatId);
+      addRef(*stream, "audioTrackFormatIDRef", trackFormatId);
+
+      auto* trackFormat =
+          kinds[kTrackFormat].createNewChildElement("audioTrackFormat");
+      trackFormat->setAttribute("audioTrackFormatID", trackFormatId);
+      trackFormat->setAttribute("audioTrackFormatName", "PCM_" + label);
+      trackFormat->setAttribute("formatLabel", "0001");
+      trackFormat->setAttribute("formatDefinition", "PCM");
+      addRef(*trackFormat, "audioStreamFormatIDRef", streamId);
+
+      ++track;
+      const juce::String uid = formatTrackUid(track);
+      addRef(*object, "audioTrackUIDRef", uid);
+      auto* trackUid = kinds[kTrackUid].createNewChildElement("audioTrackUID");
+      trackUid->setAttribute("UID", uid);
+      trackUid->setAttribute("sampleRate", sampleRate);
+      trackUid->setAttribute("bitDepth", bitDepth);
+      addRef(*trackUid, "audioTrackFormatIDRef", trackFormatId);
+      addRef(*trackUid, "audioPackFormatIDRef", packId);
+
+      appendChnaEntry(metadata.chna, track, trackFormatId, packId);
+      metadata.sourceChannels.push_back(element.getFirstChannel() + ch);
+    }
+  }
+
+  for (int m = 0; m < mixPresentations.size(); ++m) {
+    auto* programme =
+        kinds[kProgramme].createNewChildElement("audioProgramme");
+    programme->setAttribute("audioProgrammeID",
+                            formatId("APR", kFirstCustomId + m));
+    programme->setAttribute("audioProgrammeName",
+                            mixPresentations[m]->getName());
+    for (const auto& mixElement : mixPresentations[m]->getAudioElements()) {
+      auto found = contentIds.find(mixElement.getId());
+      if (found != contentIds.end()) {
+        addRef(*programme, "audioContentIDRef", found->second);
+      }
+    }
+  }
+
+  for (juce::XmlElement& kind : kinds) {
+    while (juce::XmlElement* child = kind.getFirstChildElement()) {
+      kind.removeChildElement(child, false);
+      adm->addChildElement(child);
+    }
+  }
+
+  metadata.chna[0] = metadata.chna[2] = (char)(track & 0xff);
+  metadata.chna[1] = metadata.chna[3] = (char)(track >> 8);
+  metadata.axml = root.toString().toStdString();
+  return metadata;
+}
+
+bool ADMFileWriter::open(const std::string& filename) {
+  juce::OwnedArray<AudioElement> audioElements;
+  audioElementRepository_.getAll(audioElements);
+  juce::OwnedArray<MixPresentation> mixPresentations;
+  mixPresentationRepository_.getAll(mixPresentations);
+
+  const ADMMetadata kMetadata =
+      createMetadata(audioElements, mixPresentations, sampleRate_, bitDepth_);
+  sourceChannels_ = kMetadata.sourceChannels;
+  channelPointers_.resize(sourceChannels_.size());
+
+  writer_ = std::make_unique<BW64Writer>((int)sourceChannels_.size(),
+                                         sampleRate_, bitDepth_);
+  if (sourceChannels_.empty() ||
+      !writer_->open(filename, kMetadata.chna, kMetadata.axml)) {
+    writer_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool ADMFileWriter::writeFrame(const juce::AudioBuffer<float>& buffer) {
+  if (writer_ == nullptr) {
+    return false;
+  }
+  for (size_t i = 0; i < sourceChannels_.size(); ++i) {
+    if (sourceChannels_[i] >= buffer.getNumChannels()) {
+      return false;
+    }
+    channelPointers_[i] = buffer.getReadPointer(sourceChannels_[i]);
+  }
+  return writer_->write(channelPointers_.data(), buffer.getNumSamples());
+}
+
+bool ADMFileWriter::close() {
+  if (writer_ == nullptr) {
+    return false;
+  }
+  const bool kClosed = writer_->close();
+  writer_ = nullptr;
+  return kClosed;
+}
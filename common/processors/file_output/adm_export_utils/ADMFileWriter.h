@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BW64Writer.h"
+#include "data_repository/implementation/AudioElementRepository.h"
+#include "data_repository/implementation/MixPresentationRepository.h"
+
+// ADM (ITU-R BS.2076) description of a set of audio elements, as BW64 chunks.
+struct ADMMetadata {
+  std::vector<char> chna;
+  std::string axml;
+  // Input channel feeding each track of the file, in track order.
+  std::vector<int> sourceChannels;
+};
+
+/**
+ * @brief Exports audio elements as an ADM Broadcast WAV file.
+ *
+ * Each audio element becomes an audioObject with a DirectSpeakers, HOA or
+ * Binaural pack, and each mix presentation an audioProgramme of the audio
+ * elements it mixes. Audio is streamed into the file as it is rendered.
+ */
+class ADMFileWriter {
+ public:
+  ADMFileWriter(AudioElementRepository& audioElementRepository,
+                MixPresentationRepository& mixPresentationRepository,
+                int sampleRate, int bitDepth);
+  ~ADMFileWriter();
+
+  bool open(const std::string& filename);
+  bool writeFrame(const juce::AudioBuffer<float>& buffer);
+  bool close();
+
+  static ADMMetadata createMetadata(
+      const juce::OwnedArray<AudioElement>& audioElements,
+      const juce::OwnedArray<MixPresentation>& mixPresentations,
+      int sampleRate, int bitDepth);
+
+ private:
+  AudioElementRepository& audioElementRepository_;
+  MixPresentationRepository& mixPresentationRepository_;
+  const int sampleRate_;
+  const int bitDepth_;
+  std::unique_ptr<BW64Writer> writer_;
+  std::vector<int> sourceChannels_;
+  std::vector<const float*> channelPointers_;
+};
@@ -0,0 +1,193 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "BW64Writer.h"
+
+#include <logger/logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+// Large enough that writes run at disk speed
+constexpr size_t kBufferBytes = 4 << 20;
+constexpr uint16_t kFormatPcm = 1;
+constexpr uint16_t kFormatFloat = 3;
+constexpr uint32_t kDs64Size = 28;
+// Largest size a 32-bit RIFF field can hold; sizes above it go in ds64
+constexpr uint64_t kMaxRiffSize = 0xFFFFFFFF;
+
+void putLE(char* dst, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    dst[i] = (char)((value >> (8 * i)) & 0xff);
+  }
+}
+
+void writeLE(std::ofstream& file, uint64_t value, int bytes) {
+  char data[8];
+  putLE(data, value, bytes);
+  file.write(data, bytes);
+}
+}  // namespace
+
+BW64Writer::BW64Writer(int numChannels, int sampleRate, int bitDepth)
+    : numChannels_(numChannels),
+      sampleRate_(sampleRate),
+      bytesPerSample_(bitDepth == 32 ? 4 : bitDepth == 24 ? 3 : 2) {}
+
+BW64Writer::~BW64Writer() { close(); }
+
+void BW64Writer::writeChunk(const char* id, const char* data, uint32_t size) {
+  file_.write(id, 4);
+  writeLE(file_, size, 4);
+  file_.write(data, size);
+  if (size % 2 != 0) {
+    file_.put(0);
+  }
+}
+
+bool BW64Writer::open(const std::string& filename,
+                      const std::vector<char>& chna, const std::string& axml) {
+  close();
+  file_.open(filename, std::ios::binary | std::ios::trunc);
+  if (!file_) {
+    LOG_ERROR(0, "BW64 Writer: Failed to create " + filename);
+    return false;
+  }
+
+  // RIFF size is patched by close()
+  file_.write("RIFF", 4);
+  writeLE(file_, 0, 4);
+  file_.write("WAVE", 4);
+
+  // Becomes ds64 if the file outgrows 32-bit sizes
+  junkPos_ = file_.tellp();
+  const char kJunk[kDs64Size] = {};
+  writeChunk("JUNK", kJunk, kDs64Size);
+
+  const bool kFloat = bytesPerSample_ == 4;
+  char fmt[18] = {};
+  putLE(fmt, kFloat ? kFormatFloat : kFormatPcm, 2);
+  putLE(fmt + 2, numChannels_, 2);
+  putLE(fmt + 4, sampleRate_, 4);
+  putLE(fmt + 8, (uint64_t)sampleRate_ * numChannels_ * bytesPerSample_, 4);
+  putLE(fmt + 12, numChannels_ * bytesPerSample_, 2);
+  putLE(fmt + 14, bytesPerSample_ * 8, 2);
+  // Non-PCM formats carry an empty extension size
+  writeChunk("fmt ", fmt, kFloat ? 18 : 16);
+
+  if (!chna.empty()) {
+    writeChunk("chna", chna.data(), (uint32_t)chna.size());
+  }
+  if (!axml.empty()) {
+    writeChunk("axml", axml.data(), (uint32_t)axml.size());
+  }
+
+  file_.write("data", 4);
+  dataSizePos_ = file_.tellp();
+  writeLE(file_, 0, 4);
+
+  dataBytes_ = 0;
+  framesWritten_ = 0;
+  buffer_.resize(kBufferBytes);
+  bufferUsed_ = 0;
+  if (!file_) {
+    LOG_ERROR(0, "BW64 Writer: Failed to write the header of " + filename);
+    file_.close();
+    return false;
+  }
+  return true;
+}
+
+bool BW64Writer::write(const float* const* channels, int numSamples) {
+  if (!file_.is_open()) {
+    return false;
+  }
+
+  const size_t kFrameBytes = (size_t)numChannels_ * bytesPerSample_;
+  for (int i = 0; i < numSamples; ++i) {
+    if (bufferUsed_ + kFrameBytes > buffer_.size() && !flush()) {
+      return false;
+    }
+    char* dst = buffer_.data() + bufferUsed_;
+    for (int ch = 0; ch < numChannels_; ++ch) {
+      const float sample = channels[ch][i];
+      if (bytesPerSample_ == 4) {
+        std::memcpy(dst, &sample, 4);
+      } else {
+        const double scale = bytesPerSample_ == 3 ? 8388608.0 : 32768.0;
+        const int32_t value = (int32_t)std::clamp(
+            std::lround(sample * scale), -(long)scale, (long)scale - 1);
+        putLE(dst, (uint32_t)value, bytesPerSample_);
+      }
+      dst += bytesPerSample_;
+    }
+    bufferUsed_ += kFrameBytes;
+  }
+  framesWritten_ += numSamples;
+  return true;
+}
+
+bool BW64Writer::flush() {
+  file_.write(buffer_.data(), (std::streamsize)bufferUsed_);
+  dataBytes_ += bufferUsed_;
+  bufferUsed_ = 0;
+  if (!file_) {
+    LOG_ERROR(0, "BW64 Writer: Failed to write audio data.");
+    return false;
+  }
+  return true;
+}
+
+bool BW64Writer::close() {
+  if (!file_.is_open()) {
+    return false;
+  }
+  bool ok = flush();
+  if (dataBytes_ % 2 != 0) {
+    file_.put(0);
+  }
+  const uint64_t kRiffSize = (uint64_t)file_.tellp() - 8;
+
+  if (kRiffSize <= kMaxRiffSize) {
+    file_.seekp(4);
+    writeLE(file_, kRiffSize, 4);
+    file_.seekp(dataSizePos_);
+    writeLE(file_, dataBytes_, 4);
+  } else {
+    file_.seekp(0);
+    file_.write("RF64", 4);
+    writeLE(file_, kMaxRiffSize, 4);
+    file_.seekp(junkPos_);
+    file_.write("ds64", 4);
+    writeLE(file_, kDs64Size, 4);
+    writeLE(file_, kRiffSize, 8);
+    writeLE(file_, dataBytes_, 8);
+    writeLE(file_, framesWritten_, 8);
+    // No table of other oversized chunks
+    writeLE(file_, 0, 4);
+    file_.seekp(dataSizePos_);
+    writeLE(file_, kMaxRiffSize, 4);
+  }
+
+  ok = ok && (bool)file_;
+  file_.close();
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  if (!ok) {
+    LOG_ERROR(0, "BW64 Writer: Failed to complete the file.");
+  }
+  return ok;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Streams interleaved PCM into a BW64 (ITU-R BS.2088) file.
+ *
+ * Samples are interleaved into a large buffer and written out in few, large
+ * writes, so memory use does not grow with the length of the file. The file
+ * starts as plain RIFF with a JUNK chunk reserving room for a ds64 chunk. If
+ * it outgrows 4 GiB, close() turns it into RF64 with 64-bit sizes in ds64.
+ */
+class BW64Writer {
+ public:
+  // bitDepth 16 and 24 are integer PCM, 32 is IEEE float.
+  BW64Writer(int numChannels, int sampleRate, int bitDepth);
+  ~BW64Writer();
+
+  // Write the header. The chna and axml chunks are placed before the audio
+  // data. Either may be empty to leave it out.
+  bool open(const std::string& filename, const std::vector<char>& chna,
+            const std::string& axml);
+
+  // Append numSamples of every channel, one pointer per channel.
+  bool write(const float* const* channels, int numSamples);
+
+  // Flush, back-patch the chunk sizes and close the file.
+  bool close();
+
+  bool isOpen() const { return file_.is_open(); }
+  uint64_t getFramesWritten() const { return framesWritten_; }
+
+ private:
+  void writeChunk(const char* id, const char* data, uint32_t size);
+  bool flush();
+
+  const int numChannels_;
+  const int sampleRate_;
+  const int bytesPerSample_;
+  std::ofstream file_;
+  std::streamoff junkPos_ = 0;
+  std::streamoff dataSizePos_ = 0;
+  uint64_t dataBytes_ = 0;
+  uint64_t framesWritten_ = 0;
+  std::vector<char> buffer_;
+  size_t bufferUsed_ = 0;
+};
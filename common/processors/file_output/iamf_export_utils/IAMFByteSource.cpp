@@ -0,0 +1,170 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "IAMFByteSource.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+namespace {
+// How far ahead of the read position a sequential read asks for pages
+constexpr uint64_t kReadAheadBytes = 8 << 20;
+}  // namespace
+
+//==============================================================================
+std::unique_ptr<IAMFByteSource> IAMFByteSource::open(
+    const std::filesystem::path& path) {
+  if (auto mapped = MappedFileByteSource::open(path)) {
+    return mapped;
+  }
+  auto stream = std::make_unique<StreamByteSource>(path);
+  if (!stream->isOpen()) {
+    return nullptr;
+  }
+  return stream;
+}
+
+//==============================================================================
+MemoryByteSource::MemoryByteSource(std::vector<uint8_t> bytes)
+    : storage_(std::move(bytes)), bytes_(storage_) {}
+
+std::span<const uint8_t> MemoryByteSource::read(const size_t maxBytes) {
+  const uint64_t kCount = std::min<uint64_t>(maxBytes, getSize() - position_);
+  const std::span<const uint8_t> kView = bytes_.subspan(position_, kCount);
+  position_ += kCount;
+  return kView;
+}
+
+bool MemoryByteSource::seek(const uint64_t position) {
+  if (position > getSize()) {
+    return false;
+  }
+  position_ = position;
+  return true;
+}
+
+//==============================================================================
+std::unique_ptr<MappedFileByteSource> MappedFileByteSource::open(
+    const std::filesystem::path& path) {
+#ifdef _WIN32
+  HANDLE file = CreateFileW(
+      path.c_str(), GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+      OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  LARGE_INTEGER size;
+  HANDLE mapping = nullptr;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  }
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == nullptr) {
+    CloseHandle(mapping);
+    return nullptr;
+  }
+  const size_t kSize = (size_t)size.QuadPart;
+  void* handle = mapping;
+#else
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  // Empty files cannot be mapped
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    ::close(fd);
+    return nullptr;
+  }
+  const size_t kSize = (size_t)info.st_size;
+  void* data = mmap(nullptr, kSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  void* handle = nullptr;
+#endif
+  return std::unique_ptr<MappedFileByteSource>(new MappedFileByteSource(
+      std::span<const uint8_t>((const uint8_t*)data, kSize), handle));
+}
+
+MappedFileByteSource::~MappedFileByteSource() {
+#ifdef _WIN32
+  UnmapViewOfFile(mapping_.data());
+  CloseHandle((HANDLE)handle_);
+#else
+  munmap((void*)mapping_.data(), mapping_.size());
+#endif
+}
+
+void MappedFileByteSource::willReadSequentially() {
+#ifndef _WIN32
+  // Ask for the pages just ahead rather than the whole file, which may be
+  // far larger than what is about to be played
+  const uint64_t kPageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+  const uint64_t kStart = getPosition() / kPageSize * kPageSize;
+  const uint64_t kLength =
+      std::min<uint64_t>(kReadAheadBytes, mapping_.size() - kStart);
+  uint8_t* data = (uint8_t*)mapping_.data();
+  madvise(data, mapping_.size(), MADV_SEQUENTIAL);
+  madvise(data + kStart, (size_t)kLength, MADV_WILLNEED);
+#endif
+}
+
+//==============================================================================
+StreamByteSource::StreamByteSource(const std::filesystem::path& path)
+    : stream_(path, std::ios::binary) {
+  if (stream_.is_open()) {
+    stream_.seekg(0, std::ios::end);
+    size_ = (uint64_t)stream_.tellg();
+    stream_.seekg(0);
+  }
+}
+
+std::span<const uint8_t> StreamByteSource::read(const size_t maxBytes) {
+  const uint64_t kCount = std::min<uint64_t>(maxBytes, size_ - position_);
+  if (buffer_.size() < kCount) {
+    buffer_.resize(kCount);
+  }
+  stream_.read((char*)buffer_.data(), (std::streamsize)kCount);
+  const uint64_t kRead = (uint64_t)stream_.gcount();
+  position_ += kRead;
+  return std::span<const uint8_t>(buffer_.data(), kRead);
+}
+
+bool StreamByteSource::seek(const uint64_t position) {
+  if (position > size_) {
+    return false;
+  }
+  stream_.clear();
+  stream_.seekg((std::streamoff)position);
+  position_ = position;
+  return (bool)stream_;
+}
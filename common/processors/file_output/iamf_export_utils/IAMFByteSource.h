@@ -0,0 +1,111 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Bytes of an IAMF sequence for IAMFFileReader to decode.
+ *
+ * Sources hand out views of their bytes instead of copying them into the
+ * caller's buffer, so that mapped files reach the decoder straight from the
+ * page cache.
+ */
+class IAMFByteSource {
+ public:
+  virtual ~IAMFByteSource() = default;
+
+  // Map the file, or stream it where it cannot be mapped. Returns nullptr if
+  // the file cannot be opened. Only for files nothing writes to while they
+  // are read, see MappedFileByteSource.
+  static std::unique_ptr<IAMFByteSource> open(
+      const std::filesystem::path& path);
+
+  // View up to maxBytes from the read position, and move past them. The view
+  // is valid until the next call to read() or seek(). Empty at the end.
+  virtual std::span<const uint8_t> read(const size_t maxBytes) = 0;
+
+  virtual bool seek(const uint64_t position) = 0;
+  virtual uint64_t getPosition() const = 0;
+  virtual uint64_t getSize() const = 0;
+
+  // Hint that the bytes from the read position on are about to be read in
+  // order.
+  virtual void willReadSequentially() {}
+};
+
+// Bytes already in memory, e.g. for tests.
+class MemoryByteSource : public IAMFByteSource {
+ public:
+  explicit MemoryByteSource(std::vector<uint8_t> bytes);
+
+  std::span<const uint8_t> read(const size_t maxBytes) override;
+  bool seek(const uint64_t position) override;
+  uint64_t getPosition() const override { return position_; }
+  uint64_t getSize() const override { return bytes_.size(); }
+
+ protected:
+  explicit MemoryByteSource(std::span<const uint8_t> bytes) : bytes_(bytes) {}
+
+ private:
+  std::vector<uint8_t> storage_;
+  std::span<const uint8_t> bytes_;
+  uint64_t position_ = 0;
+};
+
+// A read-only mapping of a whole file. The file must not be truncated or
+// rewritten while it is mapped: on POSIX, reading pages past its new end
+// raises SIGBUS, and on Windows the mapping stops writers truncating it. Files
+// that may be exported over while open are streamed instead.
+class MappedFileByteSource : public MemoryByteSource {
+ public:
+  static std::unique_ptr<MappedFileByteSource> open(
+      const std::filesystem::path& path);
+  ~MappedFileByteSource() override;
+
+  void willReadSequentially() override;
+
+ private:
+  MappedFileByteSource(std::span<const uint8_t> bytes, void* handle)
+      : MemoryByteSource(bytes), mapping_(bytes), handle_(handle) {}
+
+  const std::span<const uint8_t> mapping_;
+  void* handle_;  // The file mapping object on Windows
+};
+
+// Reads a file through a stream, for files that cannot be mapped.
+class StreamByteSource : public IAMFByteSource {
+ public:
+  explicit StreamByteSource(const std::filesystem::path& path);
+
+  bool isOpen() const { return stream_.is_open(); }
+
+  std::span<const uint8_t> read(const size_t maxBytes) override;
+  bool seek(const uint64_t position) override;
+  uint64_t getPosition() const override { return position_; }
+  uint64_t getSize() const override { return size_; }
+
+ private:
+  std::ifstream stream_;
+  std::vector<uint8_t> buffer_;
+  uint64_t size_ = 0;
+  uint64_t position_ = 0;
+};
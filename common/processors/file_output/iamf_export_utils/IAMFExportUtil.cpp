@@ -19,6 +19,10 @@
 #include <gpac/tools.h>
 #include <logger/logger.h>
 
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
 #include "gpac/tools.h"
 
 namespace IAMFExportHelper {
@@ -161,15 +165,8 @@ void writeOPUSConfigMD(const int sampleRate, const int bitratePerChannel,
   opusConfig->set_allocated_opus_encoder_metadata(opusMD);
 }
 
-static bool validateMuxingPaths(const juce::String& inputAudioFile,
-                                const juce::String& inputVideoFile,
-                                const juce::String& outputMuxdFile) {
-  if (!FileExport::validateFilePath(
-          std::filesystem::path(inputAudioFile.toStdString()), true)) {
-    LOG_ERROR(0, std::string("IAMFMuxing: Invalid input audio file path ") +
-                     inputAudioFile.toStdString());
-    return false;
-  }
+static bool validateVideoMuxingPaths(const juce::String& inputVideoFile,
+                                     const juce::String& outputMuxdFile) {
   if (!FileExport::validateFilePath(
           std::filesystem::path(inputVideoFile.toStdString()), true)) {
     LOG_ERROR(0, std::string("IAMFMuxing: Invalid input video file path ") +
@@ -185,6 +182,18 @@ static bool validateMuxingPaths(const juce::String& inputAudioFile,
   return true;
 }
 
+static bool validateMuxingPaths(const juce::String& inputAudioFile,
+                                const juce::String& inputVideoFile,
+                                const juce::String& outputMuxdFile) {
+  if (!FileExport::validateFilePath(
+          std::filesystem::path(inputAudioFile.toStdString()), true)) {
+    LOG_ERROR(0, std::string("IAMFMuxing: Invalid input audio file path ") +
+                     inputAudioFile.toStdString());
+    return false;
+  }
+  return validateVideoMuxingPaths(inputVideoFile, outputMuxdFile);
+}
+
 // Writes IAMF audio to an MP4 file using a GPAC filter session
 static bool muxIAMFAudio(const juce::String& inputAudioFile,
                          const juce::String& outputMp4File) {
@@ -251,9 +260,131 @@ static bool muxIAMFAudio(const juce::String& inputAudioFile,
   return true;
 }
 
+// Copies the samples of a track sample by sample, for sources whose media
+// data cannot be read directly (fragmented or externally referenced).
+static bool copySamples(GF_ISOFile* src, const u32 srcTrack, GF_ISOFile* dst,
+                        const u32 dstTrack,
+                        const MuxProgressCallback& progress) {
+  const u32 sampleCount = gf_isom_get_sample_count(src, srcTrack);
+  for (u32 i = 1; i <= sampleCount; i++) {
+    u32 sampleDescIndex = 0;
+    GF_ISOSample* sample =
+        gf_isom_get_sample(src, srcTrack, i, &sampleDescIndex);
+    if (!sample) {
+      LOG_ERROR(0, "Video Muxing: Failed to get sample " + std::to_string(i) +
+                       " from source track");
+      return false;
+    }
+    const GF_Err err =
+        gf_isom_add_sample(dst, dstTrack, sampleDescIndex, sample);
+    gf_isom_sample_del(&sample);
+    if (err != GF_OK) {
+      LOG_ERROR(0, "Video Muxing: Failed to add sample " + std::to_string(i) +
+                       " to destination track: " +
+                       std::string(gf_error_to_string(err)));
+      return false;
+    }
+    if (progress && i % 1024 == 0 && !progress((float)i / sampleCount)) {
+      LOG_INFO(0, "Video Muxing: Stopped.");
+      return false;
+    }
+  }
+  return true;
+}
+
+// Copies the samples of a self-contained track by reading runs of samples
+// that are contiguous in the source file with one large read each, rather
+// than having GPAC allocate and read every sample on its own.
+static bool copySampleRuns(GF_ISOFile* src, const u32 srcTrack,
+                           const juce::String& srcPath, GF_ISOFile* dst,
+                           const u32 dstTrack,
+                           const MuxProgressCallback& progress) {
+  // Large enough for sequential reads to run at disk speed
+  constexpr size_t kRunBytes = 8 << 20;
+
+  std::ifstream input(srcPath.toStdString(), std::ios::binary);
+  if (!input) {
+    LOG_ERROR(0, "Video Muxing: Failed to open " + srcPath.toStdString() +
+                     " for reading.");
+    return false;
+  }
+
+  struct SampleInfo {
+    GF_ISOSample sample;
+    u32 descIndex;
+  };
+  std::vector<SampleInfo> run;
+  std::vector<u8> runData;
+  runData.reserve(kRunBytes);
+  u64 runOffset = 0;
+  size_t runSize = 0;
+
+  auto writeRun = [&]() {
+    if (run.empty()) {
+      return true;
+    }
+    runData.resize(runSize);
+    input.seekg((std::streamoff)runOffset);
+    if (!input.read((char*)runData.data(), (std::streamsize)runSize)) {
+      LOG_ERROR(0, "Video Muxing: Failed to read source media data.");
+      return false;
+    }
+    u8* data = runData.data();
+    for (SampleInfo& info : run) {
+      info.sample.data = data;
+      data += info.sample.dataLength;
+      const GF_Err err =
+          gf_isom_add_sample(dst, dstTrack, info.descIndex, &info.sample);
+      if (err != GF_OK) {
+        LOG_ERROR(0, "Video Muxing: Failed to add sample to destination "
+                     "track: " +
+                         std::string(gf_error_to_string(err)));
+        return false;
+      }
+    }
+    run.clear();
+    runSize = 0;
+    return true;
+  };
+
+  const u32 sampleCount = gf_isom_get_sample_count(src, srcTrack);
+  for (u32 i = 1; i <= sampleCount; i++) {
+    SampleInfo info = {};
+    u64 offset = 0;
+    if (!gf_isom_get_sample_info_ex(src, srcTrack, i, &info.descIndex, &offset,
+                                    &info.sample)) {
+      LOG_ERROR(0, "Video Muxing: Failed to get sample " + std::to_string(i) +
+                       " from source track");
+      return false;
+    }
+    info.sample.dataLength = gf_isom_get_sample_size(src, srcTrack, i);
+    info.sample.data = nullptr;
+
+    // Start a new run when this sample does not follow on from the last one
+    // (a chunk of another track sits between them) or the run is full
+    if (!run.empty() && (offset != runOffset + runSize ||
+                         runSize + info.sample.dataLength > kRunBytes)) {
+      if (!writeRun()) {
+        return false;
+      }
+      if (progress && !progress((float)(i - 1) / sampleCount)) {
+        LOG_INFO(0, "Video Muxing: Stopped.");
+        return false;
+      }
+    }
+    if (run.empty()) {
+      runOffset = offset;
+    }
+    runSize += info.sample.dataLength;
+    run.push_back(info);
+  }
+  return writeRun();
+}
+
 // Writes video to an existing MP4 file using GPAC ISO media APIs
 static bool muxVideo(const juce::String& inputVideoFile,
-                     const juce::String& outputMuxedFile) {
+                     const juce::String& outputMuxedFile,
+                     const MuxProgressCallback& progress) {
 #ifdef DEBUG
   gf_log_set_tool_level(GF_LOG_CORE, GF_LOG_INFO);
   gf_log_set_tool_level(GF_LOG_CONTAINER, GF_LOG_INFO);
@@ -312,33 +443,24 @@ static bool muxVideo(const juce::String& inputVideoFile,
     return false;
   }
 
-  // Now manually copy all samples from the source track to the destination
-  // track
-  u32 sample_count = gf_isom_get_sample_count(src_video, src_video_track);
-  for (u32 i = 1; i <= sample_count; i++) {
-    u32 sample_desc_index = 0;
-    GF_ISOSample* sample =
-        gf_isom_get_sample(src_video, src_video_track, i, &sample_desc_index);
-    if (!sample) {
-      LOG_ERROR(0, "Video Muxing: Failed to get sample " + std::to_string(i) +
-                       " from source track");
-      gf_isom_close(dst_file);
-      gf_isom_close(src_video);
-      return false;
-    }
-
-    // Add the sample to the destination track
-    gf_err = gf_isom_add_sample(dst_file, dst_track, sample_desc_index, sample);
-    gf_isom_sample_del(&sample);
-
-    if (gf_err != GF_OK) {
-      LOG_ERROR(0, "Video Muxing: Failed to add sample " + std::to_string(i) +
-                       " to destination track: " +
-                       std::string(gf_error_to_string(gf_err)));
-      gf_isom_close(dst_file);
-      gf_isom_close(src_video);
-      return false;
-    }
+  // Now copy all samples from the source track to the destination track.
+  // Media data in the source file itself is read in bulk.
+  bool self_contained = !gf_isom_is_fragmented(src_video);
+  const u32 desc_count =
+      gf_isom_get_sample_description_count(src_video, src_video_track);
+  for (u32 i = 1; i <= desc_count && self_contained; i++) {
+    self_contained = gf_isom_is_self_contained(src_video, src_video_track, i);
+  }
+  const bool samples_copied =
+      self_contained
+          ? copySampleRuns(src_video, src_video_track, inputVideoFile,
+                           dst_file, dst_track, progress)
+          : copySamples(src_video, src_video_track, dst_file, dst_track,
+                        progress);
+  if (!samples_copied) {
+    gf_isom_close(dst_file);
+    gf_isom_close(src_video);
+    return false;
   }
 
   // Close source file
@@ -403,12 +525,22 @@ static bool muxVideo(const juce::String& inputVideoFile,
   return true;
 }
 
-bool muxIAMF(const FileExport& exportData) {
+bool canMuxVideo(const FileExport& exportData) {
+  return validateVideoMuxingPaths(exportData.getVideoSource(),
+                                  exportData.getVideoExportFolder());
+}
+
+bool muxIAMF(const FileExport& exportData, const bool audioMuxed,
+             const MuxProgressCallback& progress) {
   const juce::String inputAudioFile = exportData.getExportFile();
   const juce::String inputVideoFile = exportData.getVideoSource();
   const juce::String outputMuxdFile = exportData.getVideoExportFolder();
 
-  if (!validateMuxingPaths(inputAudioFile, inputVideoFile, outputMuxdFile)) {
+  const bool kPathsValid =
+      audioMuxed ? validateVideoMuxingPaths(inputVideoFile, outputMuxdFile)
+                 : validateMuxingPaths(inputAudioFile, inputVideoFile,
+                                       outputMuxdFile);
+  if (!kPathsValid) {
     LOG_ERROR(0, "IAMF Muxing: One or more file paths are invalid.");
     return false;
   }
@@ -420,18 +552,31 @@ bool muxIAMF(const FileExport& exportData) {
     return false;
   }
 
-  if (!muxIAMFAudio(inputAudioFile, outputMuxdFile)) {
+  // Remember whether progress asked to stop, so as to remove the output
+  bool stopped = false;
+  const MuxProgressCallback kProgress = [&](float fraction) {
+    stopped = progress && !progress(fraction);
+    return !stopped;
+  };
+
+  if (!audioMuxed && !muxIAMFAudio(inputAudioFile, outputMuxdFile)) {
     LOG_ERROR(0, "IAMF Muxing: Failed to mux IAMF audio into MP4.");
     gf_sys_close();
     return false;
   }
-  if (!muxVideo(inputVideoFile, outputMuxdFile)) {
-    LOG_ERROR(0, "IAMF Muxing: Failed to mux video into MP4.");
+  if (!kProgress(0.f) || !muxVideo(inputVideoFile, outputMuxdFile, kProgress)) {
+    if (stopped) {
+      std::error_code ec;
+      std::filesystem::remove(outputMuxdFile.toStdString(), ec);
+    } else {
+      LOG_ERROR(0, "IAMF Muxing: Failed to mux video into MP4.");
+    }
     gf_sys_close();
     return false;
   }
 
   gf_sys_close();
+  kProgress(1.f);
   return true;
 }
 }  // namespace IAMFExportHelper
\ No newline at end of file
@@ -17,6 +17,8 @@
 #pragma once
 #include <data_structures/src/AudioElement.h>
 
+#include <functional>
+
 #include "data_structures/src/FileExport.h"
 #include "user_metadata.pb.h"
 
@@ -32,5 +34,15 @@ void writeFLACConfigMD(const int samplesPerBlock, const int samplesProcessed,
                        iamf_tools_cli_proto::UserMetadata& user_metadata);
 void writeOPUSConfigMD(const int sampleRate, const int bitratePerChannel,
                        iamf_tools_cli_proto::UserMetadata& user_metadata);
-bool muxIAMF(const FileExport& exportData);
+// Called with the fraction of the video copied so far, from 0 to 1. Muxing
+// stops if it returns false.
+using MuxProgressCallback = std::function<bool(float)>;
+
+// Whether the export's video source and muxed output paths are usable.
+bool canMuxVideo(const FileExport& exportData);
+// Mux the exported IAMF and the video source into the video export file. If
+// audioMuxed, the file already holds the IAMF track and only video is added.
+// A mux stopped through progress leaves no output file.
+bool muxIAMF(const FileExport& exportData, const bool audioMuxed = false,
+             const MuxProgressCallback& progress = {});
 }  // namespace IAMFExportHelper
\ No newline at end of file
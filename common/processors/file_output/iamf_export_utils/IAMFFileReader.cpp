@@ -14,13 +14,16 @@
 
 #include "IAMFFileReader.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>
-#include <fstream>
 #include <memory>
+#include <span>
+#include <vector>
 
+#include "IAMFObu.h"
 #include "iamf_tools_api_types.h"
 #include "logger/logger.h"
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
@@ -28,15 +31,17 @@
 // Parse descriptors to determine audio stream params for the selected mix
 // presentation
 static IAMFFileReader::StreamData parseOBUs(
-    std::unique_ptr<IAMFFileReader::Decoder>& decoder,
-    std::unique_ptr<std::ifstream>& fileStream) {
-  const size_t kBufferSize = 4096;
+    std::unique_ptr<IAMFFileReader::Decoder>& decoder, IAMFByteSource& source,
+    IAMFObu::TemporalUnitIndex* index) {
+  const size_t kReadSize = 4096;
   IAMFFileReader::StreamData streamData;
 
-  char buffer[kBufferSize];
-  while (fileStream->read(buffer, kBufferSize) || fileStream->gcount() > 0) {
-    decoder->Decode(reinterpret_cast<const uint8_t*>(buffer),
-                    fileStream->gcount());
+  for (std::span<const uint8_t> bytes = source.read(kReadSize);
+       !bytes.empty(); bytes = source.read(kReadSize)) {
+    decoder->Decode(bytes.data(), bytes.size());
+    if (index != nullptr) {
+      index->append(bytes.data(), bytes.size());
+    }
 
     if (decoder->IsDescriptorProcessingComplete()) {
       streamData.valid = true;
@@ -56,21 +61,15 @@ static IAMFFileReader::StreamData parseOBUs(
 }
 
 static IAMFFileReader::StreamData parseStreamData(
-    std::unique_ptr<IAMFFileReader::Decoder>& decoder,
-    std::unique_ptr<std::ifstream>& fileStream) {
-  return parseOBUs(decoder, fileStream);
+    std::unique_ptr<IAMFFileReader::Decoder>& decoder, IAMFByteSource& source,
+    IAMFObu::TemporalUnitIndex* index = nullptr) {
+  return parseOBUs(decoder, source, index);
 }
 
-IAMFFileReader::IAMFFileReader(const std::filesystem::path& iamfFilePath,
-                               std::atomic_bool& abortConstruction)
-    : IAMFFileReader(iamfFilePath, kDefaultReaderSettings, abortConstruction) {}
-
-IAMFFileReader::IAMFFileReader(const std::filesystem::path& iamfFilePath,
+IAMFFileReader::IAMFFileReader(std::unique_ptr<IAMFByteSource> source,
                                const Settings& settings,
                                std::atomic_bool& abortConstruction)
-    : kFilePath_(iamfFilePath),
-      settings_(settings),
-      tpuBuffer_(std::make_unique<char[]>(kBufferSize_)) {
+    : settings_(settings), source_(std::move(source)) {
   // Create an initial decoder to parse Descriptor OBUs
   iamfDecoder_ = iamf_tools::api::IamfDecoderFactory::Create(settings_);
   if (!iamfDecoder_) {
@@ -78,13 +77,10 @@ IAMFFileReader::IAMFFileReader(const std::filesystem::path& iamfFilePath,
     return;
   }
 
-  fileStream_ = std::make_unique<std::ifstream>(kFilePath_, std::ios::binary);
-  if (!fileStream_->is_open()) {
-    LOG_ERROR(0, "IAMFFileReader: Failed to open IAMF file");
-    return;
-  }
-
-  streamData_ = parseStreamData(iamfDecoder_, fileStream_);
+  source_->willReadSequentially();
+  // The temporal units are found in the bytes read for the indexing pass
+  unitIndex_ = std::make_unique<IAMFObu::TemporalUnitIndex>();
+  streamData_ = parseStreamData(iamfDecoder_, *source_, unitIndex_.get());
   if (!streamData_.valid) {
     LOG_ERROR(0, "IAMFFileReader: Failed to parse IAMF file");
     return;
@@ -103,11 +99,7 @@ IAMFFileReader::IAMFFileReader(const std::filesystem::path& iamfFilePath,
   }
 }
 
-IAMFFileReader::~IAMFFileReader() {
-  if (fileStream_ && fileStream_->is_open()) {
-    fileStream_->close();
-  }
-}
+IAMFFileReader::~IAMFFileReader() = default;
 
 std::unique_ptr<IAMFFileReader> IAMFFileReader::createIamfReader(
     const std::filesystem::path& iamfFilePath) {
@@ -124,8 +116,22 @@ std::unique_ptr<IAMFFileReader> IAMFFileReader::createIamfReader(
     return nullptr;
   }
 
+  std::unique_ptr<IAMFByteSource> source = IAMFByteSource::open(iamfFilePath);
+  if (!source) {
+    LOG_ERROR(0, "IAMFFileReader: Failed to open IAMF file");
+    return nullptr;
+  }
+  return createIamfReader(std::move(source), settings, abortConstruction);
+}
+
+std::unique_ptr<IAMFFileReader> IAMFFileReader::createIamfReader(
+    std::unique_ptr<IAMFByteSource> source, const Settings& settings,
+    std::atomic_bool& abortConstruction) {
+  if (!source) {
+    return nullptr;
+  }
   auto reader = std::unique_ptr<IAMFFileReader>(
-      new IAMFFileReader(iamfFilePath, settings, abortConstruction));
+      new IAMFFileReader(std::move(source), settings, abortConstruction));
 
   // Check if initialization was successful by verifying streamData is valid
   if (!reader->streamData_.valid) {
@@ -137,10 +143,12 @@ std::unique_ptr<IAMFFileReader> IAMFFileReader::createIamfReader(
 
 bool IAMFFileReader::prepareTemporalUnit(std::unique_ptr<Decoder>& decoder) {
   while (!iamfDecoder_->IsTemporalUnitAvailable()) {
-    if (fileStream_->read(tpuBuffer_.get(), kBufferSize_) ||
-        fileStream_->gcount() > 0) {
-      iamfDecoder_->Decode(reinterpret_cast<const uint8_t*>(tpuBuffer_.get()),
-                           fileStream_->gcount());
+    const std::span<const uint8_t> kBytes = source_->read(kReadSize_);
+    if (!kBytes.empty()) {
+      iamfDecoder_->Decode(kBytes.data(), kBytes.size());
+      if (unitIndex_ != nullptr) {
+        unitIndex_->append(kBytes.data(), kBytes.size());
+      }
     } else {
       // End of file reached, signal decoder to flush remaining temporal units
       iamfDecoder_->SignalEndOfDecoding();
@@ -223,15 +231,31 @@ size_t IAMFFileReader::indexFile(std::atomic_bool& haltIndexing) {
     frameCount++;
   }
 
+  // Everything the decoder read has been through the index
+  const std::unique_ptr<IAMFObu::TemporalUnitIndex> kUnitIndex =
+      std::move(unitIndex_);
   if (haltIndexing) {
     return -1;
   }
 
   streamData_.numFrames = frameCount;
 
+  if (kUnitIndex != nullptr) {
+    if (kUnitIndex->isComplete() &&
+        kUnitIndex->getEndOffset() == source_->getSize() &&
+        kUnitIndex->getTemporalUnitOffsets().size() == frameCount) {
+      temporalUnitOffsets_ = kUnitIndex->getTemporalUnitOffsets();
+    } else {
+      LOG_WARNING(0,
+                  "IAMFFileReader: Could not find the temporal units, seeks "
+                  "will decode from the start");
+      temporalUnitOffsets_.clear();
+    }
+  }
+
   // Reset file and decoder state for normal playback
-  fileStream_->clear();
-  fileStream_->seekg(0, std::ios::beg);
+  source_->seek(0);
+  source_->willReadSequentially();
   iamfDecoder_ = iamf_tools::api::IamfDecoderFactory::Create(settings_);
   if (!iamfDecoder_) {
     LOG_ERROR(0,
@@ -239,7 +263,7 @@ size_t IAMFFileReader::indexFile(std::atomic_bool& haltIndexing) {
     streamData_.valid = false;
     return 0;
   }
-  parseStreamData(iamfDecoder_, fileStream_);
+  parseStreamData(iamfDecoder_, *source_);
   streamData_.currentFrameIdx = 0;
 
   return frameCount;
@@ -251,11 +275,20 @@ bool IAMFFileReader::seekFrame(const size_t frameIdx) {
     return false;
   }
 
-  // If seeking backward, reset decoder and file position, then advance
-  if (frameIdx < streamData_.currentFrameIdx) {
-    // Reset file position
-    fileStream_->clear();
-    fileStream_->seekg(0, std::ios::beg);
+  // Jump to a little before the frame rather than decode every unit on the
+  // way, unless the frame is only a few units ahead
+  const size_t kFirstUnit =
+      frameIdx > kSeekPreRoll_ ? frameIdx - kSeekPreRoll_ : 0;
+  if (!temporalUnitOffsets_.empty() &&
+      (frameIdx < streamData_.currentFrameIdx ||
+       kFirstUnit > streamData_.currentFrameIdx)) {
+    if (!restartAt(kFirstUnit)) {
+      return false;
+    }
+  } else if (frameIdx < streamData_.currentFrameIdx) {
+    // Without the unit offsets, reset decoder and file position, then advance
+    source_->seek(0);
+    source_->willReadSequentially();
 
     // Recreate decoder
     iamfDecoder_ = iamf_tools::api::IamfDecoderFactory::Create(settings_);
@@ -265,7 +298,7 @@ bool IAMFFileReader::seekFrame(const size_t frameIdx) {
     }
 
     // Reposition decoder to start of temporal units after
-    const StreamData kStreamData = parseStreamData(iamfDecoder_, fileStream_);
+    const StreamData kStreamData = parseStreamData(iamfDecoder_, *source_);
     if (!kStreamData.valid) {
       LOG_ERROR(0, "IAMFFileReader: Failed to reparse stream data during seek");
       return false;
@@ -284,14 +317,40 @@ bool IAMFFileReader::seekFrame(const size_t frameIdx) {
   return true;
 }
 
+bool IAMFFileReader::restartAt(const size_t temporalUnit) {
+  iamfDecoder_ = iamf_tools::api::IamfDecoderFactory::Create(settings_);
+  if (!iamfDecoder_) {
+    LOG_ERROR(0, "IAMFFileReader: Failed to recreate decoder during seek");
+    return false;
+  }
+
+  // The descriptors followed by any run of temporal units decode as a whole
+  // sequence would
+  source_->seek(0);
+  for (uint64_t left = temporalUnitOffsets_.front(); left > 0;) {
+    const std::span<const uint8_t> kBytes =
+        source_->read(std::min<uint64_t>(left, kReadSize_));
+    if (kBytes.empty()) {
+      LOG_ERROR(0, "IAMFFileReader: Failed to reread descriptors during seek");
+      return false;
+    }
+    iamfDecoder_->Decode(kBytes.data(), kBytes.size());
+    left -= kBytes.size();
+  }
+  source_->seek(temporalUnitOffsets_[temporalUnit]);
+  source_->willReadSequentially();
+  streamData_.currentFrameIdx = temporalUnit;
+  return true;
+}
+
 bool IAMFFileReader::resetLayout(
     const Speakers::AudioElementSpeakerLayout& layout) {
   // Update settings with new layout
   settings_.requested_mix.output_layout = layout.getIamfOutputLayout();
 
   // Reset file position
-  fileStream_->clear();
-  fileStream_->seekg(0, std::ios::beg);
+  source_->seek(0);
+  source_->willReadSequentially();
 
   // Recreate decoder with new settings
   iamfDecoder_ = iamf_tools::api::IamfDecoderFactory::Create(settings_);
@@ -303,7 +362,7 @@ bool IAMFFileReader::resetLayout(
   }
 
   // Reparse stream data with new layout
-  const StreamData kNewStreamData = parseStreamData(iamfDecoder_, fileStream_);
+  const StreamData kNewStreamData = parseStreamData(iamfDecoder_, *source_);
   if (!kNewStreamData.valid) {
     LOG_ERROR(
         0, "IAMFFileReader: Failed to parse stream data during layout reset");
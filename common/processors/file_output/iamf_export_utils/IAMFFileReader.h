@@ -17,9 +17,11 @@
 
 #include <atomic>
 #include <filesystem>
-#include <iosfwd>
 #include <memory>
+#include <vector>
 
+#include "IAMFByteSource.h"
+#include "IAMFObu.h"
 #include "iamf/include/iamf_tools/iamf_decoder_factory.h"
 #include "iamf/include/iamf_tools/iamf_decoder_interface.h"
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
@@ -54,6 +56,10 @@ class IAMFFileReader {
   static std::unique_ptr<IAMFFileReader> createIamfReader(
       const std::filesystem::path& iamfFilePath, const Settings& settings,
       std::atomic_bool& abortConstruction);
+  // Create a decoder reading from any byte source, e.g. a buffer in memory
+  static std::unique_ptr<IAMFFileReader> createIamfReader(
+      std::unique_ptr<IAMFByteSource> source, const Settings& settings,
+      std::atomic_bool& abortConstruction);
 
   IAMFFileReader(const IAMFFileReader&) = delete;
   IAMFFileReader& operator=(const IAMFFileReader&) = delete;
@@ -69,24 +75,36 @@ class IAMFFileReader {
 
   // Method to be called via a valid reader instance to index the file.
   // Takes a reference to an flag that can be set to halt indexing prematurely.
-  // Returns the number of frames valid frames or -1 if halted.
+  // Returns the number of frames valid frames or -1 if halted. Also records
+  // where each temporal unit starts, so seeks jump straight to it.
   size_t indexFile(std::atomic_bool& haltIndexing);
 
  private:
-  IAMFFileReader(const std::filesystem::path& iamfFilePath,
-                 std::atomic_bool& abortConstruction);
-  IAMFFileReader(const std::filesystem::path& iamfFilePath,
+  IAMFFileReader(std::unique_ptr<IAMFByteSource> source,
                  const Settings& settings, std::atomic_bool& abortConstruction);
 
-  static constexpr size_t kBufferSize_ = 4096;
+  // Bytes handed to the decoder at a time. The decoder decodes every complete
+  // temporal unit it is given up front, so larger views only queue more PCM.
+  static constexpr size_t kReadSize_ = 4096;
+  // Temporal units decoded and dropped before the one seeked to. Lossy codecs
+  // need a few units of history before their output settles.
+  static constexpr size_t kSeekPreRoll_ = 4;
 
   bool prepareTemporalUnit(std::unique_ptr<Decoder>& decoder);
   size_t parseFrame(juce::AudioBuffer<float>* buffer = nullptr);
+  // Recreate the decoder, feed it the descriptors and carry on from the start
+  // of a temporal unit.
+  bool restartAt(const size_t temporalUnit);
 
-  const std::filesystem::path kFilePath_;
   Settings settings_;
-  std::unique_ptr<std::ifstream> fileStream_;
-  std::unique_ptr<char[]> tpuBuffer_, sampleBuffer_;
+  std::unique_ptr<IAMFByteSource> source_;
+  std::unique_ptr<char[]> sampleBuffer_;
   std::unique_ptr<Decoder> iamfDecoder_;
   StreamData streamData_;
+  // Where each temporal unit starts, the first also being where the
+  // descriptors end. Empty if the units could not be found, in which case
+  // seeks decode from the start.
+  std::vector<uint64_t> temporalUnitOffsets_;
+  // Finds the temporal units in the bytes decoded while indexing.
+  std::unique_ptr<IAMFObu::TemporalUnitIndex> unitIndex_;
 };
\ No newline at end of file
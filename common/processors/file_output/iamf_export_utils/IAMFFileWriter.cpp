@@ -28,7 +28,8 @@ IAMFFileWriter::IAMFFileWriter(
       mixPresentationRepository_(mixPresentationRepository),
       mixPresentationLoudnessRepository_(mixPresentationLoudnessRepository),
       samplesPerFrame_(samplesPerFrame),
-      sampleRate_(sampleRate) {}
+      sampleRate_(sampleRate),
+      stats_(ExportStats::forExport(fileExportRepository)) {}
 
 void IAMFFileWriter::populateCodecInformationFromRepository(
     FileExportRepository& fileExportRepository,
@@ -127,7 +128,8 @@ void IAMFFileWriter::populateMixPresentationMetadataFromRepository(
   }
 }
 
-bool IAMFFileWriter::open(const std::string& filename) {
+bool IAMFFileWriter::open(const std::string& filename,
+                          const std::string& mp4Filename) {
   // Create a new instance of the user metadata to use
   userMetadata_ = std::make_unique<iamf_tools_cli_proto::UserMetadata>();
 
@@ -151,6 +153,21 @@ bool IAMFFileWriter::open(const std::string& filename) {
   // Globalize it for other methods after validating the absl return
   iamfEncoder_ = std::move(localIamfEncoder.value());
 
+  // The MP4 sample entry needs descriptors up front. They are replaced by the
+  // finalized ones when the encode is closed.
+  mp4Writer_ = nullptr;
+  if (!mp4Filename.empty()) {
+    bool finalized = false;
+    std::vector<uint8_t> descriptorObus;
+    auto res =
+        iamfEncoder_->GetDescriptorObus(false, descriptorObus, finalized);
+    mp4Writer_ = std::make_unique<IAMFMp4Writer>(samplesPerFrame_, sampleRate_);
+    if (!res.ok() || !mp4Writer_->open(mp4Filename, descriptorObus)) {
+      LOG_WARNING(0, "Failed to start streaming to " + mp4Filename);
+      mp4Writer_ = nullptr;
+    }
+  }
+
   // Configure the temporal unit data structure for later use
   temporalUnitData_ = iamf_tools::api::IamfTemporalUnitData();
 
@@ -188,14 +205,16 @@ bool IAMFFileWriter::finalizeWriting() {
     }
 
     // Step 2: Flush all remaining temporal units
+    ExportStats::ScopedTimer timer(stats_.get(), ExportStats::kEncode, 0);
     while (iamfEncoder_->GeneratingTemporalUnits()) {
-      std::vector<uint8_t> unused_temporal_unit_obus;
-      auto res = iamfEncoder_->OutputTemporalUnit(unused_temporal_unit_obus);
+      auto res = iamfEncoder_->OutputTemporalUnit(temporalUnitObus_);
       if (!res.ok()) {
         LOG_WARNING(
             1, "Failed to flush remaining temporal units: " + res.ToString());
         return false;
       }
+      timer.addBytes(temporalUnitObus_.size());
+      writeTemporalUnitToMp4();
     }
 
     // Step 3: Get final descriptors (these contain loudness info, etc)
@@ -220,12 +239,36 @@ bool IAMFFileWriter::finalizeWriting() {
                   "Encoder still generating temporal units after finalization");
       return false;
     }
+
+    // Step 5: Close the MP4 with the finalized descriptors in its sample entry
+    if (mp4Writer_ != nullptr && !mp4Writer_->finalize(descriptor_obus)) {
+      LOG_WARNING(1, "Failed to finalize the IAMF track of the MP4");
+      mp4Writer_ = nullptr;
+    }
   }
   return true;
 }
 
+void IAMFFileWriter::writeTemporalUnitToMp4() {
+  if (mp4Writer_ == nullptr || temporalUnitObus_.empty()) {
+    return;
+  }
+  if (!mp4Writer_->writeTemporalUnit(temporalUnitObus_)) {
+    // The .iamf is unaffected, and the MP4 can still be muxed from it
+    LOG_WARNING(0, "Failed to stream temporal unit to MP4");
+    mp4Writer_->abort();
+    mp4Writer_ = nullptr;
+  }
+}
+
 bool IAMFFileWriter::close() {
   bool result = finalizeWriting();
+  if (mp4Writer_ != nullptr && mp4Writer_->isOpen()) {
+    mp4Writer_->abort();
+  }
+  if (!result) {
+    mp4Writer_ = nullptr;
+  }
   // Always clear the encoder in order to release the file
   iamfEncoder_ = nullptr;
   return result;
@@ -252,6 +295,8 @@ bool IAMFFileWriter::writeFrame(const juce::AudioBuffer<float>& buffer) {
   if (!iamfEncoder_->GeneratingTemporalUnits()) {
     return false;
   }
+  ExportStats::ScopedTimer timer(stats_.get(), ExportStats::kEncode,
+                                 buffer.getNumSamples());
 
   convertFloatToDouble(buffer, doubleBuffer_);
 
@@ -276,11 +321,12 @@ bool IAMFFileWriter::writeFrame(const juce::AudioBuffer<float>& buffer) {
   }
 
   // Output the temporal units
-  std::vector<uint8_t> unused_temporal_unit_obus;
-  res = iamfEncoder_->OutputTemporalUnit(unused_temporal_unit_obus);
+  res = iamfEncoder_->OutputTemporalUnit(temporalUnitObus_);
   if (!res.ok()) {
     LOG_WARNING(0, "Failed to output temporal unit " + res.ToString());
     return false;
   }
+  timer.addBytes(temporalUnitObus_.size());
+  writeTemporalUnitToMp4();
   return true;
 }
\ No newline at end of file
@@ -19,10 +19,12 @@
 
 #include <string>
 
+#include "../ExportStats.h"
 #include "data_repository/implementation/AudioElementRepository.h"
 #include "data_repository/implementation/FileExportRepository.h"
 #include "data_repository/implementation/MixPresentationLoudnessRepository.h"
 #include "data_repository/implementation/MixPresentationRepository.h"
+#include "IAMFMp4Writer.h"
 #include "iamf/include/iamf_tools/iamf_encoder_interface.h"
 
 struct AudioElementMetadata {
@@ -50,10 +52,16 @@ class IAMFFileWriter {
       int samplesPerFrame, int sampleRate);
   ~IAMFFileWriter() {};
 
-  bool open(const std::string& filename);
+  // Encode to filename. Temporal units are also streamed into the IAMF
+  // track of mp4Filename when one is given, which is complete once close()
+  // returns true.
+  bool open(const std::string& filename, const std::string& mp4Filename = {});
   bool close();
   bool writeFrame(const juce::AudioBuffer<float>& buffer);
 
+  // After a successful close(), whether the MP4 audio track was written.
+  bool hasWrittenMp4() const { return mp4Writer_ != nullptr; }
+
  protected:
   bool finalizeWriting();
   void populateCodecInformationFromRepository(
@@ -81,4 +89,7 @@ class IAMFFileWriter {
   std::vector<AudioElementMetadata> audioElementInformation_;
   iamf_tools::api::IamfTemporalUnitData temporalUnitData_;
   juce::AudioBuffer<double> doubleBuffer_;
+  std::unique_ptr<IAMFMp4Writer> mp4Writer_;
+  std::vector<uint8_t> temporalUnitObus_;
+  std::shared_ptr<ExportStats> stats_;
 };
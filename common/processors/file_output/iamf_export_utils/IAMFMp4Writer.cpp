@@ -0,0 +1,182 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "IAMFMp4Writer.h"
+
+#include <gpac/isomedia.h>
+#include <gpac/mpeg4_odf.h>
+#include <logger/logger.h>
+
+#include <cstring>
+#include <filesystem>
+
+#include "IAMFObu.h"
+
+IAMFMp4Writer::IAMFMp4Writer(int samplesPerFrame, int sampleRate)
+    : samplesPerFrame_(samplesPerFrame), sampleRate_(sampleRate) {}
+
+IAMFMp4Writer::~IAMFMp4Writer() { abort(); }
+
+bool IAMFMp4Writer::open(const std::string& filename,
+                         const std::vector<uint8_t>& descriptorObus) {
+  abort();
+  if (gf_sys_init(GF_MemTrackerNone, NULL) != GF_OK) {
+    LOG_ERROR(0, "IAMF MP4 Writer: Failed to initialize GPAC system.");
+    return false;
+  }
+
+  // Write mode captures media data as it is added and writes the movie box
+  // on close.
+  filename_ = filename;
+  file_ = gf_isom_open(filename_.c_str(), GF_ISOM_OPEN_WRITE, NULL);
+  if (file_ == nullptr) {
+    LOG_ERROR(0, "IAMF MP4 Writer: Failed to create " + filename_);
+    gf_sys_close();
+    return false;
+  }
+  gf_isom_set_brand_info(file_, GF_ISOM_BRAND_ISO6, 0);
+  gf_isom_modify_alternate_brand(file_, GF_ISOM_SUBTYPE_IAMF, GF_TRUE);
+
+  track_ = gf_isom_new_track(file_, 0, GF_ISOM_MEDIA_AUDIO, sampleRate_);
+  if (track_ == 0 || gf_isom_set_track_enabled(file_, track_, GF_TRUE) !=
+                         GF_OK) {
+    LOG_ERROR(0, "IAMF MP4 Writer: Failed to create the audio track.");
+    abort();
+    return false;
+  }
+
+  descriptionIndex_ = 0;
+  decodeTime_ = 0;
+  if (!setDescriptorObus(descriptorObus)) {
+    abort();
+    return false;
+  }
+  return true;
+}
+
+bool IAMFMp4Writer::setDescriptorObus(
+    const std::vector<uint8_t>& descriptorObus) {
+  GF_IAConfig* config = gf_odf_iamf_cfg_new();
+  config->configurationVersion = 1;
+  const bool parsed =
+      IAMFObu::forEach(descriptorObus, [&](const IAMFObu::View& obu) {
+        GF_IamfObu* configObu = (GF_IamfObu*)gf_malloc(sizeof(GF_IamfObu));
+        configObu->obu_length = obu.length;
+        configObu->obu_type = obu.type;
+        configObu->raw_obu_bytes = (u8*)gf_malloc((u32)obu.length);
+        std::memcpy(configObu->raw_obu_bytes, obu.data, obu.length);
+        gf_list_add(config->configOBUs, configObu);
+        config->configOBUs_size += (u32)obu.length;
+      });
+  if (!parsed) {
+    LOG_ERROR(0, "IAMF MP4 Writer: Descriptor OBUs are truncated.");
+    gf_odf_iamf_cfg_del(config);
+    return false;
+  }
+
+  // Samples keep pointing at the description index, so the description can
+  // be swapped for a new one without touching the sample tables.
+  if (descriptionIndex_ != 0) {
+    gf_isom_remove_stream_description(file_, track_, descriptionIndex_);
+  }
+  const u32 previousIndex = descriptionIndex_;
+  u32 newIndex = 0;
+  const GF_Err err =
+      gf_isom_iamf_config_new(file_, track_, config, NULL, NULL, &newIndex);
+  gf_odf_iamf_cfg_del(config);
+  if (err != GF_OK ||
+      (previousIndex != 0 && newIndex != previousIndex)) {
+    LOG_ERROR(0, "IAMF MP4 Writer: Failed to write the IAMF configuration: " +
+                     std::string(gf_error_to_string(err)));
+    return false;
+  }
+  descriptionIndex_ = newIndex;
+  return true;
+}
+
+bool IAMFMp4Writer::writeTemporalUnit(
+    const std::vector<uint8_t>& temporalUnitObus) {
+  if (file_ == nullptr) {
+    return false;
+  }
+
+  sampleData_.clear();
+  const bool parsed =
+      IAMFObu::forEach(temporalUnitObus, [&](const IAMFObu::View& obu) {
+        // Descriptors and delimiters may appear in encoder output but do not
+        // belong in MP4 samples, which carry only the audio frames and
+        // parameter blocks.
+        if (IAMFObu::isDescriptor(obu.type) ||
+            obu.type == IAMFObu::kTypeTemporalDelimiter) {
+          return;
+        }
+        sampleData_.insert(sampleData_.end(), obu.data, obu.data + obu.length);
+      });
+  if (!parsed) {
+    LOG_ERROR(0, "IAMF MP4 Writer: Temporal unit OBUs are truncated.");
+    return false;
+  }
+  if (sampleData_.empty()) {
+    return true;
+  }
+
+  GF_ISOSample sample = {};
+  sample.data = sampleData_.data();
+  sample.dataLength = (u32)sampleData_.size();
+  sample.DTS = decodeTime_;
+  sample.IsRAP = SAP_TYPE_1;
+  const GF_Err err =
+      gf_isom_add_sample(file_, track_, descriptionIndex_, &sample);
+  if (err != GF_OK) {
+    LOG_ERROR(0, "IAMF MP4 Writer: Failed to add sample: " +
+                     std::string(gf_error_to_string(err)));
+    return false;
+  }
+  decodeTime_ += samplesPerFrame_;
+  return true;
+}
+
+bool IAMFMp4Writer::finalize(const std::vector<uint8_t>& descriptorObus) {
+  if (file_ == nullptr) {
+    return false;
+  }
+  if (!setDescriptorObus(descriptorObus)) {
+    abort();
+    return false;
+  }
+  gf_isom_set_last_sample_duration(file_, track_, samplesPerFrame_);
+
+  const GF_Err err = gf_isom_close(file_);
+  file_ = nullptr;
+  gf_sys_close();
+  if (err != GF_OK) {
+    LOG_ERROR(0, "IAMF MP4 Writer: Failed to close " + filename_ + ": " +
+                     std::string(gf_error_to_string(err)));
+    std::error_code ec;
+    std::filesystem::remove(filename_, ec);
+    return false;
+  }
+  return true;
+}
+
+void IAMFMp4Writer::abort() {
+  if (file_ == nullptr) {
+    return;
+  }
+  gf_isom_delete(file_);
+  file_ = nullptr;
+  gf_sys_close();
+  std::error_code ec;
+  std::filesystem::remove(filename_, ec);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+typedef struct __tag_isom GF_ISOFile;
+
+/**
+ * @brief Streams IAMF temporal units into the 'iamf' audio track of an MP4
+ * file as they are encoded.
+ *
+ * Samples go straight to the file's media data. The descriptor OBUs are kept
+ * in the track's sample entry ('iacb' box). They are rewritten by finalize()
+ * once the encoder has patched them, and the movie box is then written at
+ * the end of the file.
+ */
+class IAMFMp4Writer {
+ public:
+  IAMFMp4Writer(int samplesPerFrame, int sampleRate);
+  ~IAMFMp4Writer();
+
+  // Create the file with an 'iamf' track described by the descriptor OBUs
+  // known so far.
+  bool open(const std::string& filename,
+            const std::vector<uint8_t>& descriptorObus);
+
+  // Append the OBUs of one temporal unit as the next sample.
+  bool writeTemporalUnit(const std::vector<uint8_t>& temporalUnitObus);
+
+  // Replace the descriptor OBUs with their final version and complete the
+  // file.
+  bool finalize(const std::vector<uint8_t>& descriptorObus);
+
+  // Close and delete a file that will not be finalized.
+  void abort();
+
+  bool isOpen() const { return file_ != nullptr; }
+
+ private:
+  bool setDescriptorObus(const std::vector<uint8_t>& descriptorObus);
+
+  const int samplesPerFrame_;
+  const int sampleRate_;
+  std::string filename_;
+  GF_ISOFile* file_ = nullptr;
+  uint32_t track_ = 0;
+  uint32_t descriptionIndex_ = 0;
+  uint64_t decodeTime_ = 0;
+  // Reused for each sample.
+  std::vector<uint8_t> sampleData_;
+};
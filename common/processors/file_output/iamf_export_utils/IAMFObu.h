@@ -0,0 +1,248 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Minimal parsing of IAMF OBUs, enough to split a sequence into OBUs and
+// find fields at known positions without decoding any audio.
+namespace IAMFObu {
+constexpr int kTypeCodecConfig = 0;
+constexpr int kTypeAudioElement = 1;
+constexpr int kTypeMixPresentation = 2;
+constexpr int kTypeParameterBlock = 3;
+constexpr int kTypeTemporalDelimiter = 4;
+constexpr int kTypeAudioFrame = 5;
+constexpr int kTypeAudioFrameId21 = 27;
+constexpr int kTypeSequenceHeader = 31;
+
+inline bool isDescriptor(const int type) {
+  return type == kTypeSequenceHeader || type == kTypeCodecConfig ||
+         type == kTypeAudioElement || type == kTypeMixPresentation;
+}
+
+// Audio frames with an explicit substream ID and those with an implicit one.
+inline bool isAudioFrame(const int type) {
+  return type >= kTypeAudioFrame && type <= kTypeAudioFrameId21;
+}
+
+struct View {
+  int type;
+  const uint8_t* data;
+  size_t length;  // Header and payload
+};
+
+// Reads the fields of an OBU, failing rather than reading past its end.
+class Reader {
+ public:
+  Reader(const uint8_t* data, const size_t size) : data_(data), size_(size) {}
+  explicit Reader(const View& obu) : Reader(obu.data, obu.length) {}
+
+  bool readByte(uint8_t& value) {
+    if (pos_ >= size_) {
+      return false;
+    }
+    value = data_[pos_++];
+    return true;
+  }
+
+  bool readLeb128(uint64_t& value) {
+    value = 0;
+    for (int i = 0; i < 8; ++i) {
+      uint8_t byte;
+      if (!readByte(byte)) {
+        return false;
+      }
+      value |= (uint64_t)(byte & 0x7f) << (7 * i);
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return true;
+  }
+
+  bool skip(const uint64_t count) {
+    if (count > size_ - pos_) {
+      return false;
+    }
+    pos_ += count;
+    return true;
+  }
+
+  // Skip a null terminated string.
+  bool skipString() {
+    while (pos_ < size_) {
+      if (data_[pos_++] == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Read the OBU header, leaving the reader at the start of the payload.
+  bool readHeader(int& type) {
+    uint8_t flags;
+    uint64_t size, unused;
+    if (!readByte(flags) || !readLeb128(size)) {
+      return false;
+    }
+    type = flags >> 3;
+    // Trimming status and extension header, which obu_size includes
+    if ((flags & 0x2) != 0 && !(readLeb128(unused) && readLeb128(unused))) {
+      return false;
+    }
+    if ((flags & 0x1) != 0 && !(readLeb128(size) && skip(size))) {
+      return false;
+    }
+    return true;
+  }
+
+  size_t getPosition() const { return pos_; }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t pos_ = 0;
+};
+
+// Split a sequence of OBUs, returning false if it is truncated.
+template <typename Callback>
+bool forEach(const uint8_t* obus, const size_t size, Callback callback) {
+  Reader reader(obus, size);
+  while (reader.getPosition() < size) {
+    const size_t start = reader.getPosition();
+    uint8_t flags;
+    uint64_t obuSize;
+    // obu_size is leb128 coded and counts the bytes after itself
+    if (!reader.readByte(flags) || !reader.readLeb128(obuSize) ||
+        !reader.skip(obuSize)) {
+      return false;
+    }
+    callback(View{flags >> 3, obus + start, reader.getPosition() - start});
+  }
+  return true;
+}
+
+template <typename Callback>
+bool forEach(const std::vector<uint8_t>& obus, Callback callback) {
+  return forEach(obus.data(), obus.size(), callback);
+}
+
+// Finds where each temporal unit of a sequence starts. Temporal units end
+// with their last audio frame, or at the next temporal delimiter if the
+// encoder writes them.
+//
+// OBUs are either added one at a time, or the sequence's bytes are appended
+// in chunks of any size as they are read.
+class TemporalUnitIndex {
+ public:
+  // Whether add() needs the payload of an OBU of this type, rather than only
+  // its header.
+  bool needsPayload(const int type) const {
+    return inDescriptors() && type == kTypeAudioElement;
+  }
+
+  // Add the next OBU, which starts at offset. obu holds its header, and its
+  // payload where needsPayload(). Returns false if it cannot be read.
+  bool add(const View& obu, const uint64_t offset) {
+    if (inDescriptors() && isDescriptor(obu.type)) {
+      if (obu.type == kTypeAudioElement) {
+        Reader reader(obu);
+        int type;
+        uint64_t id, codecConfigId, substreams;
+        uint8_t byte;
+        if (!(reader.readHeader(type) && reader.readLeb128(id) &&
+              reader.readByte(byte) && reader.readLeb128(codecConfigId) &&
+              reader.readLeb128(substreams))) {
+          return false;
+        }
+        numSubstreams_ += substreams;
+      }
+      return true;
+    }
+    if (!inUnit_ ||
+        (obu.type == kTypeTemporalDelimiter && framesInUnit_ > 0)) {
+      offsets_.push_back(offset);
+      inUnit_ = true;
+      framesInUnit_ = 0;
+    }
+    if (isAudioFrame(obu.type) && ++framesInUnit_ == numSubstreams_) {
+      inUnit_ = false;
+    }
+    return true;
+  }
+
+  // Add the OBUs in the next bytes of the sequence. Returns false once the
+  // sequence cannot be read.
+  bool append(const uint8_t* data, size_t size) {
+    while (size > 0 && !failed_) {
+      if (length_ == 0) {
+        // obu_size is leb128 coded and counts the bytes after itself
+        obu_.push_back(*data++);
+        --size;
+        if (obu_.size() < 2 || ((obu_.back() & 0x80) != 0 && obu_.size() < 9)) {
+          continue;
+        }
+        uint64_t payloadSize = 0;
+        for (size_t i = 1; i < obu_.size(); ++i) {
+          payloadSize |= (uint64_t)(obu_[i] & 0x7f) << (7 * (i - 1));
+        }
+        length_ = obu_.size() + payloadSize;
+        keepPayload_ = needsPayload(obu_[0] >> 3);
+        read_ = obu_.size();
+      } else {
+        const size_t kCount = (size_t)std::min<uint64_t>(size, length_ - read_);
+        if (keepPayload_) {
+          obu_.insert(obu_.end(), data, data + kCount);
+        }
+        data += kCount;
+        size -= kCount;
+        read_ += kCount;
+      }
+      if (read_ == length_) {
+        failed_ = !add(View{obu_[0] >> 3, obu_.data(), obu_.size()}, end_);
+        end_ += length_;
+        obu_.clear();
+        length_ = read_ = 0;
+      }
+    }
+    return !failed_;
+  }
+
+  bool inDescriptors() const { return offsets_.empty(); }
+  const std::vector<uint64_t>& getTemporalUnitOffsets() const {
+    return offsets_;
+  }
+  // The end of the last whole OBU appended.
+  uint64_t getEndOffset() const { return end_; }
+  // Whether everything appended was read as whole OBUs.
+  bool isComplete() const { return !failed_ && obu_.empty(); }
+
+ private:
+  std::vector<uint64_t> offsets_;
+  uint64_t numSubstreams_ = 0, framesInUnit_ = 0;
+  bool inUnit_ = false;
+
+  // The OBU being appended, of length_ bytes once its header is read
+  std::vector<uint8_t> obu_;
+  uint64_t length_ = 0, read_ = 0, end_ = 0;
+  bool keepPayload_ = false;
+  bool failed_ = false;
+};
+}  // namespace IAMFObu
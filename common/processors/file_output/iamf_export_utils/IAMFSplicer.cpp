@@ -0,0 +1,472 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "IAMFSplicer.h"
+
+#include <logger/logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <istream>
+#include <optional>
+#include <ostream>
+
+#include "IAMFFileReader.h"
+#include "IAMFObu.h"
+#include "processors/mix_monitoring/loudness_standards/MeasureEBU128.h"
+
+namespace {
+constexpr uint32_t fourCc(const char (&id)[5]) {
+  return (uint32_t)id[0] << 24 | (uint32_t)id[1] << 16 |
+         (uint32_t)id[2] << 8 | (uint32_t)id[3];
+}
+
+// Codecs whose temporal units decode independently of each other
+constexpr uint32_t kSpliceableCodecIds[] = {fourCc("ipcm"), fourCc("fLaC")};
+
+// Floor of the loudness values written by the loudness export
+constexpr float kMinSplicedLoudness = -80.f;
+
+// Read the next OBU, keeping its payload only if keepPayload says so.
+// Returns false at the end of the stream or if the OBU is truncated.
+template <typename KeepPayload>
+bool readSplicedObu(std::istream& in, const uint64_t remaining,
+                    std::vector<uint8_t>& obu, uint64_t& length,
+                    KeepPayload keepPayload) {
+  obu.clear();
+  int byte = in.get();
+  if (byte == std::char_traits<char>::eof()) {
+    return false;
+  }
+  obu.push_back((uint8_t)byte);
+  uint64_t payloadSize = 0;
+  for (int i = 0; i < 8; ++i) {
+    if ((byte = in.get()) == std::char_traits<char>::eof()) {
+      return false;
+    }
+    obu.push_back((uint8_t)byte);
+    payloadSize |= (uint64_t)(byte & 0x7f) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      break;
+    }
+  }
+  length = obu.size() + payloadSize;
+  if (length > remaining) {
+    return false;
+  }
+  if (keepPayload(obu[0] >> 3)) {
+    obu.resize(length);
+    in.read((char*)obu.data() + obu.size() - payloadSize,
+            (std::streamsize)payloadSize);
+  } else {
+    in.seekg((std::streamoff)payloadSize, std::ios::cur);
+  }
+  return (bool)in;
+}
+
+bool copySplicedRange(std::istream& in, const uint64_t begin,
+                      const uint64_t end, std::ostream& out) {
+  std::vector<char> buffer(1 << 20);
+  in.clear();
+  in.seekg((std::streamoff)begin);
+  for (uint64_t pos = begin; pos < end;) {
+    const size_t kCount = (size_t)std::min<uint64_t>(buffer.size(), end - pos);
+    if (!in.read(buffer.data(), (std::streamsize)kCount) ||
+        !out.write(buffer.data(), (std::streamsize)kCount)) {
+      return false;
+    }
+    pos += kCount;
+  }
+  return true;
+}
+
+uint64_t getTemporalUnitOffset(const IAMFSplicer::Sequence& sequence,
+                               const size_t temporalUnit) {
+  return temporalUnit < sequence.getNumTemporalUnits()
+             ? sequence.temporalUnitOffsets[temporalUnit]
+             : sequence.endOffset;
+}
+
+// Descriptor OBUs that must match for temporal units to be interchangeable,
+// which is all of them but the mix presentations.
+std::vector<uint8_t> getCodedDescriptors(const std::vector<uint8_t>& obus) {
+  std::vector<uint8_t> coded;
+  IAMFObu::forEach(obus, [&](const IAMFObu::View& obu) {
+    if (obu.type != IAMFObu::kTypeMixPresentation) {
+      coded.insert(coded.end(), obu.data, obu.data + obu.length);
+    }
+  });
+  return coded;
+}
+
+bool skipMixGainParamDefinition(IAMFObu::Reader& reader) {
+  uint64_t unused, constantSubblockDuration, numSubblocks;
+  uint8_t mode;
+  if (!reader.readLeb128(unused) || !reader.readLeb128(unused) ||
+      !reader.readByte(mode)) {
+    return false;
+  }
+  // Durations are only coded when they are not left to the parameter blocks
+  if ((mode & 0x80) == 0) {
+    if (!reader.readLeb128(unused) ||
+        !reader.readLeb128(constantSubblockDuration)) {
+      return false;
+    }
+    if (constantSubblockDuration == 0) {
+      if (!reader.readLeb128(numSubblocks)) {
+        return false;
+      }
+      for (uint64_t i = 0; i < numSubblocks; ++i) {
+        if (!reader.readLeb128(unused)) {
+          return false;
+        }
+      }
+    }
+  }
+  // default_mix_gain
+  return reader.skip(2);
+}
+
+bool readMixPresentationLoudness(
+    IAMFObu::Reader& reader, const size_t obuOffset,
+    std::vector<IAMFSplicer::LoudnessField>& fields) {
+  uint64_t id, countLabel, numSubMixes;
+  if (!reader.readLeb128(id) || !reader.readLeb128(countLabel)) {
+    return false;
+  }
+  // Languages then presentation annotations
+  for (uint64_t i = 0; i < 2 * countLabel; ++i) {
+    if (!reader.skipString()) {
+      return false;
+    }
+  }
+  if (!reader.readLeb128(numSubMixes)) {
+    return false;
+  }
+  for (uint64_t subMix = 0; subMix < numSubMixes; ++subMix) {
+    uint64_t numAudioElements, numLayouts, unused;
+    if (!reader.readLeb128(numAudioElements)) {
+      return false;
+    }
+    for (uint64_t element = 0; element < numAudioElements; ++element) {
+      if (!reader.readLeb128(unused)) {
+        return false;
+      }
+      for (uint64_t i = 0; i < countLabel; ++i) {
+        if (!reader.skipString()) {
+          return false;
+        }
+      }
+      // Rendering config and its extension, then the element mix gain
+      uint8_t renderingConfig;
+      uint64_t extensionSize;
+      if (!reader.readByte(renderingConfig) ||
+          !reader.readLeb128(extensionSize) || !reader.skip(extensionSize) ||
+          !skipMixGainParamDefinition(reader)) {
+        return false;
+      }
+    }
+    if (!skipMixGainParamDefinition(reader) ||
+        !reader.readLeb128(numLayouts)) {
+      return false;
+    }
+    for (uint64_t layout = 0; layout < numLayouts; ++layout) {
+      uint8_t layoutByte, infoType;
+      if (!reader.readByte(layoutByte) || !reader.readByte(infoType)) {
+        return false;
+      }
+      IAMFSplicer::LoudnessField field;
+      field.mixPresentationId = (uint32_t)id;
+      // Layout type 2 is the loudspeaker sound system convention
+      field.soundSystem = (layoutByte >> 6) == 2 ? (layoutByte >> 2) & 0xf : -1;
+      field.integratedLoudness = obuOffset + reader.getPosition();
+      field.digitalPeak = field.integratedLoudness + 2;
+      field.truePeak = 0;
+      if (!reader.skip(4)) {
+        return false;
+      }
+      if ((infoType & 0x1) != 0) {
+        field.truePeak = obuOffset + reader.getPosition();
+        if (!reader.skip(2)) {
+          return false;
+        }
+      }
+      if ((infoType & 0x2) != 0) {
+        uint8_t numAnchors;
+        if (!reader.readByte(numAnchors) || !reader.skip(3 * numAnchors)) {
+          return false;
+        }
+      }
+      if ((infoType & 0xfc) != 0) {
+        uint64_t extensionSize;
+        if (!reader.readLeb128(extensionSize) || !reader.skip(extensionSize)) {
+          return false;
+        }
+      }
+      fields.push_back(field);
+    }
+  }
+  return true;
+}
+
+// The decoder's name for the sound systems mix presentations are written
+// with, see MixPresentation::writeLayout().
+std::optional<iamf_tools::api::OutputLayout> getSplicedOutputLayout(
+    const int soundSystem) {
+  using OutputLayout = iamf_tools::api::OutputLayout;
+  switch (soundSystem) {
+    case 0:
+      return OutputLayout::kItu2051_SoundSystemA_0_2_0;
+    case 1:
+      return OutputLayout::kItu2051_SoundSystemB_0_5_0;
+    case 2:
+      return OutputLayout::kItu2051_SoundSystemC_2_5_0;
+    case 3:
+      return OutputLayout::kItu2051_SoundSystemD_4_5_0;
+    case 7:
+      return OutputLayout::kItu2051_SoundSystemH_9_10_3;
+    case 8:
+      return OutputLayout::kItu2051_SoundSystemI_0_7_0;
+    case 9:
+      return OutputLayout::kItu2051_SoundSystemJ_4_7_0;
+    case 10:
+      return OutputLayout::kIAMF_SoundSystemExtension_2_7_0;
+    case 11:
+      return OutputLayout::kIAMF_SoundSystemExtension_2_3_0;
+    case 13:
+      return OutputLayout::kIAMF_SoundSystemExtension_6_9_0;
+    default:
+      return std::nullopt;
+  }
+}
+
+void writeQ7Point8(std::vector<uint8_t>& obus, const size_t offset,
+                   const float value) {
+  const long kValue =
+      std::clamp(std::lround(std::max(kMinSplicedLoudness, value) * 256.f),
+                 -32768L, 32767L);
+  obus[offset] = (uint8_t)((kValue >> 8) & 0xff);
+  obus[offset + 1] = (uint8_t)(kValue & 0xff);
+}
+
+// Decode every layout whose loudness the mix presentations carry and
+// rewrite the loudness in place, as its values have a fixed size.
+bool remeasureSplicedLoudness(const std::filesystem::path& file,
+                              const std::atomic_bool& cancelled) {
+  IAMFSplicer::Sequence sequence;
+  {
+    std::ifstream in(file, std::ios::binary);
+    if (!IAMFSplicer::parse(in, sequence)) {
+      return false;
+    }
+  }
+  std::vector<uint8_t>& descriptors = sequence.descriptorObus;
+
+  for (const auto& field : IAMFSplicer::findLoudnessFields(descriptors)) {
+    const auto kOutputLayout = getSplicedOutputLayout(field.soundSystem);
+    if (!kOutputLayout.has_value()) {
+      LOG_WARNING(0, "IAMF Splicer: Keeping the loudness of sound system " +
+                         std::to_string(field.soundSystem));
+      continue;
+    }
+
+    IAMFFileReader::Settings settings = IAMFFileReader::kDefaultReaderSettings;
+    settings.requested_mix.mix_presentation_id = field.mixPresentationId;
+    settings.requested_mix.output_layout = *kOutputLayout;
+    std::atomic_bool abortConstruction(false);
+    auto reader =
+        IAMFFileReader::createIamfReader(file, settings, abortConstruction);
+    if (reader == nullptr) {
+      LOG_ERROR(0, "IAMF Splicer: Failed to decode the spliced file.");
+      return false;
+    }
+
+    const IAMFFileReader::StreamData kStream = reader->getStreamData();
+    const juce::AudioChannelSet kChannelSet =
+        kStream.playbackLayout.getChannelSet();
+    MeasureEBU128 loudness(kStream.sampleRate, kChannelSet);
+    MeasureEBU128::LoudnessStats stats = loudness.loudnessStats_;
+    juce::AudioBuffer<float> buffer(kStream.numChannels, kStream.frameSize);
+    while (reader->readFrame(buffer) > 0) {
+      if (cancelled) {
+        return false;
+      }
+      stats = loudness.measureLoudness(kChannelSet, buffer);
+    }
+
+    writeQ7Point8(descriptors, field.integratedLoudness,
+                  stats.loudnessIntegrated);
+    writeQ7Point8(descriptors, field.digitalPeak, stats.loudnessDigitalPeak);
+    if (field.truePeak != 0) {
+      writeQ7Point8(descriptors, field.truePeak, stats.loudnessTruePeak);
+    }
+  }
+
+  std::fstream out(file, std::ios::in | std::ios::out | std::ios::binary);
+  out.write((const char*)descriptors.data(),
+            (std::streamsize)descriptors.size());
+  return (bool)out;
+}
+}  // namespace
+
+namespace IAMFSplicer {
+bool parse(std::istream& in, Sequence& sequence) {
+  sequence = Sequence();
+  in.clear();
+  in.seekg(0, std::ios::end);
+  const uint64_t kSize = (uint64_t)in.tellg();
+  in.seekg(0);
+
+  IAMFObu::TemporalUnitIndex index;
+  std::vector<uint8_t> obu;
+  uint64_t offset = 0, length = 0;
+  while (offset < kSize) {
+    const bool kInDescriptors = index.inDescriptors();
+    if (!readSplicedObu(in, kSize - offset, obu, length, [&](const int type) {
+          return kInDescriptors && IAMFObu::isDescriptor(type);
+        })) {
+      LOG_ERROR(0, "IAMF Splicer: OBUs are truncated.");
+      return false;
+    }
+    const int kType = obu[0] >> 3;
+    if (!index.add(IAMFObu::View{kType, obu.data(), obu.size()}, offset)) {
+      return false;
+    }
+
+    if (kInDescriptors && IAMFObu::isDescriptor(kType)) {
+      sequence.descriptorObus.insert(sequence.descriptorObus.end(),
+                                     obu.begin(), obu.end());
+      if (kType == IAMFObu::kTypeCodecConfig) {
+        IAMFObu::Reader reader(obu.data(), obu.size());
+        int type;
+        uint64_t id;
+        uint8_t byte;
+        uint32_t codecId = 0;
+        bool read = reader.readHeader(type) && reader.readLeb128(id);
+        for (int i = 0; read && i < 4; ++i) {
+          read = reader.readByte(byte);
+          codecId = codecId << 8 | byte;
+        }
+        if (!read) {
+          return false;
+        }
+        sequence.codecIds.push_back(codecId);
+      }
+    }
+    offset += length;
+  }
+  sequence.temporalUnitOffsets = index.getTemporalUnitOffsets();
+  sequence.endOffset = offset;
+  return true;
+}
+
+bool canSplice(const Sequence& base, const Sequence& patch,
+               const size_t firstTemporalUnit) {
+  for (const uint32_t kCodecId : base.codecIds) {
+    if (std::find(std::begin(kSpliceableCodecIds),
+                  std::end(kSpliceableCodecIds),
+                  kCodecId) == std::end(kSpliceableCodecIds)) {
+      LOG_WARNING(0, "IAMF Splicer: Only LPCM and FLAC can be spliced.");
+      return false;
+    }
+  }
+  if (getCodedDescriptors(base.descriptorObus) !=
+      getCodedDescriptors(patch.descriptorObus)) {
+    LOG_WARNING(0,
+                "IAMF Splicer: Audio elements or codec settings have changed "
+                "since the file was exported.");
+    return false;
+  }
+  if (patch.getNumTemporalUnits() == 0 ||
+      firstTemporalUnit + patch.getNumTemporalUnits() >
+          base.getNumTemporalUnits()) {
+    LOG_WARNING(0, "IAMF Splicer: The patch does not fit in the file.");
+    return false;
+  }
+  return true;
+}
+
+bool splice(std::istream& base, std::istream& patch,
+            const size_t firstTemporalUnit, std::ostream& out) {
+  Sequence baseSequence, patchSequence;
+  if (!parse(base, baseSequence) || !parse(patch, patchSequence) ||
+      !canSplice(baseSequence, patchSequence, firstTemporalUnit)) {
+    return false;
+  }
+
+  const size_t kEndTemporalUnit =
+      firstTemporalUnit + patchSequence.getNumTemporalUnits();
+  out.write((const char*)patchSequence.descriptorObus.data(),
+            (std::streamsize)patchSequence.descriptorObus.size());
+  return copySplicedRange(base, getTemporalUnitOffset(baseSequence, 0),
+                          getTemporalUnitOffset(baseSequence,
+                                                firstTemporalUnit),
+                          out) &&
+         copySplicedRange(patch, getTemporalUnitOffset(patchSequence, 0),
+                          patchSequence.endOffset, out) &&
+         copySplicedRange(base,
+                          getTemporalUnitOffset(baseSequence,
+                                                kEndTemporalUnit),
+                          baseSequence.endOffset, out);
+}
+
+std::vector<LoudnessField> findLoudnessFields(
+    const std::vector<uint8_t>& descriptorObus) {
+  std::vector<LoudnessField> fields;
+  IAMFObu::forEach(descriptorObus, [&](const IAMFObu::View& obu) {
+    if (obu.type != IAMFObu::kTypeMixPresentation) {
+      return;
+    }
+    IAMFObu::Reader reader(obu);
+    int type;
+    if (!reader.readHeader(type) ||
+        !readMixPresentationLoudness(
+            reader, (size_t)(obu.data - descriptorObus.data()), fields)) {
+      LOG_WARNING(0, "IAMF Splicer: Failed to parse a mix presentation.");
+    }
+  });
+  return fields;
+}
+
+bool spliceFile(const std::filesystem::path& exportFile,
+                const std::filesystem::path& patchFile,
+                const size_t firstTemporalUnit,
+                const std::atomic_bool& cancelled) {
+  std::filesystem::path splicedFile = exportFile;
+  splicedFile += ".splice";
+  bool spliced;
+  {
+    std::ifstream base(exportFile, std::ios::binary);
+    std::ifstream patch(patchFile, std::ios::binary);
+    std::ofstream out(splicedFile, std::ios::binary | std::ios::trunc);
+    spliced = base && patch && out &&
+              splice(base, patch, firstTemporalUnit, out) && out.flush();
+  }
+  spliced = spliced && !cancelled &&
+            remeasureSplicedLoudness(splicedFile, cancelled);
+
+  std::error_code ec;
+  if (spliced) {
+    std::filesystem::rename(splicedFile, exportFile, ec);
+  }
+  if (!spliced || ec) {
+    LOG_ERROR(0, "IAMF Splicer: Failed to splice " + patchFile.string() +
+                     " into " + exportFile.string());
+    std::filesystem::remove(splicedFile, ec);
+    return false;
+  }
+  return true;
+}
+}  // namespace IAMFSplicer
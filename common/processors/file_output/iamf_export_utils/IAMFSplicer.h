@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <vector>
+
+/**
+ * @brief Replaces a run of temporal units of an IAMF file with those of a
+ * shorter file encoded from the same audio elements, so that a changed part
+ * of a mix can be re-exported without encoding the rest of it again.
+ *
+ * Only LPCM and FLAC can be spliced, as each of their temporal units decodes
+ * on its own. Temporal units around the patch are copied byte for byte. The
+ * descriptors are taken from the patch, which was encoded with the current
+ * mix presentations, and their loudness is measured again by decoding the
+ * spliced file.
+ */
+namespace IAMFSplicer {
+// Descriptor OBUs of an IAMF sequence, and where each of its temporal units
+// starts.
+struct Sequence {
+  std::vector<uint8_t> descriptorObus;
+  std::vector<uint64_t> temporalUnitOffsets;
+  uint64_t endOffset = 0;
+  // Codec IDs of the codec config OBUs, e.g. 'ipcm'
+  std::vector<uint32_t> codecIds;
+
+  size_t getNumTemporalUnits() const { return temporalUnitOffsets.size(); }
+};
+
+// Where the loudness of a mix presentation layout is coded in the descriptor
+// OBUs. Offsets point at big-endian Q7.8 values.
+struct LoudnessField {
+  uint32_t mixPresentationId;
+  // ITU-R BS.2051 sound system, or -1 for layouts that are not loudspeakers
+  int soundSystem;
+  size_t integratedLoudness, digitalPeak;
+  // 0 when the true peak is not coded
+  size_t truePeak;
+};
+
+bool parse(std::istream& in, Sequence& sequence);
+
+// Whether patch may replace the temporal units of base from
+// firstTemporalUnit on. Logs why not.
+bool canSplice(const Sequence& base, const Sequence& patch,
+               const size_t firstTemporalUnit);
+
+// Write patch over base from firstTemporalUnit on. Returns false if the
+// patch does not fit or either stream is truncated.
+bool splice(std::istream& base, std::istream& patch,
+            const size_t firstTemporalUnit, std::ostream& out);
+
+std::vector<LoudnessField> findLoudnessFields(
+    const std::vector<uint8_t>& descriptorObus);
+
+// Splice patchFile into exportFile and measure its loudness again. The
+// export is left untouched if anything fails or the work is cancelled.
+bool spliceFile(const std::filesystem::path& exportFile,
+                const std::filesystem::path& patchFile,
+                const size_t firstTemporalUnit,
+                const std::atomic_bool& cancelled);
+}  // namespace IAMFSplicer
@@ -28,7 +28,8 @@ LoudnessExportProcessor::LoudnessExportProcessor(
       loudnessRepo_(loudnessRepo),
       audioElementRepository_(audioElementRepo),
       currentSamplesPerBlock_(1),
-      sampleTally_(0) {
+      sampleTally_(0),
+      stats_(ExportStats::forExport(fileExportRepo)) {
   mixPresentationRepository_.registerListener(this);
 }
 
@@ -77,6 +78,8 @@ void LoudnessExportProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     return;
   }
 
+  ExportStats::ScopedTimer timer(stats_.get(), ExportStats::kLoudness,
+                                 buffer.getNumSamples());
   for (auto& exportContainer : exportContainers_) {
     exportContainer.process(buffer);
   }
@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include "../file_output/ExportStats.h"
 #include "MixPresentationLoudnessExportContainer.h"
 
 class LoudnessExportProcessor : public ProcessorBase,
@@ -83,4 +84,5 @@ class LoudnessExportProcessor : public ProcessorBase,
   int endTime_;
 
   std::vector<MixPresentationLoudnessExportContainer> exportContainers_;
+  std::shared_ptr<ExportStats> stats_;
 };
\ No newline at end of file
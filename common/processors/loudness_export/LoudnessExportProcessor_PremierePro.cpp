@@ -77,6 +77,8 @@ void PremiereProLoudnessExportProcessor::processBlock(
     return;
   }
 
+  ExportStats::ScopedTimer timer(stats_.get(), ExportStats::kLoudness,
+                                 buffer.getNumSamples());
   for (auto& exportContainer : exportContainers_) {
     exportContainer.process(buffer);
   }
@@ -0,0 +1,131 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ChannelMeter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+// Number of independent accumulators per channel. Splitting the reduction
+// into lanes removes the loop-carried dependency so the compiler can keep
+// the whole inner loop in vector registers.
+constexpr int kMeterLanes = 8;
+
+void measureChannelLevels(const float* data, const int numSamples,
+                          float& peak, float& sumOfSquares) {
+  float lanePeak[kMeterLanes] = {};
+  float laneSquares[kMeterLanes] = {};
+
+  int i = 0;
+  for (; i + kMeterLanes <= numSamples; i += kMeterLanes) {
+    for (int l = 0; l < kMeterLanes; ++l) {
+      const float sample = data[i + l];
+      laneSquares[l] += sample * sample;
+      lanePeak[l] = std::max(lanePeak[l], std::abs(sample));
+    }
+  }
+  for (int l = 0; i < numSamples; ++i, ++l) {
+    const float sample = data[i];
+    laneSquares[l] += sample * sample;
+    lanePeak[l] = std::max(lanePeak[l], std::abs(sample));
+  }
+
+  peak = 0.f;
+  sumOfSquares = 0.f;
+  for (int l = 0; l < kMeterLanes; ++l) {
+    peak = std::max(peak, lanePeak[l]);
+    sumOfSquares += laneSquares[l];
+  }
+}
+}  // namespace
+
+ChannelMeter::ChannelMeter(int maxChannels) { prepare(maxChannels); }
+
+void ChannelMeter::prepare(int maxChannels) {
+  if (maxChannels <= (int)peaks_.size()) {
+    return;
+  }
+  peaks_.resize(maxChannels, 0.f);
+  sumsOfSquares_.resize(maxChannels, 0.f);
+  rmsdB_.resize(maxChannels, 0.f);
+  rmsdBGeneration_.resize(maxChannels, 0);
+}
+
+void ChannelMeter::process(const juce::AudioBuffer<float>& buffer,
+                           int numChannels) {
+  if (numChannels < 0 || numChannels > buffer.getNumChannels()) {
+    numChannels = buffer.getNumChannels();
+  }
+  // Only grows when the channel count exceeds what was prepared.
+  prepare(numChannels);
+
+  numChannels_ = numChannels;
+  numSamples_ = buffer.getNumSamples();
+  for (int ch = 0; ch < numChannels_; ++ch) {
+    measureChannelLevels(buffer.getReadPointer(ch), numSamples_, peaks_[ch],
+                         sumsOfSquares_[ch]);
+  }
+
+  // Invalidate all cached dB conversions. Zero is never a valid generation.
+  if (++generation_ == 0) {
+    generation_ = 1;
+    std::fill(rmsdBGeneration_.begin(), rmsdBGeneration_.end(), 0);
+  }
+}
+
+float ChannelMeter::getPeak(int channel) const {
+  if (channel < 0 || channel >= numChannels_) {
+    return 0.f;
+  }
+  return peaks_[channel];
+}
+
+float ChannelMeter::getSumOfSquares(int channel) const {
+  if (channel < 0 || channel >= numChannels_) {
+    return 0.f;
+  }
+  return sumsOfSquares_[channel];
+}
+
+float ChannelMeter::getRMS(int channel) const {
+  if (numSamples_ == 0) {
+    return 0.f;
+  }
+  return std::sqrt(getSumOfSquares(channel) / numSamples_);
+}
+
+float ChannelMeter::getMaxPeak(int numChannels) const {
+  if (numChannels < 0 || numChannels > numChannels_) {
+    numChannels = numChannels_;
+  }
+  float maxPeak = 0.f;
+  for (int ch = 0; ch < numChannels; ++ch) {
+    maxPeak = std::max(maxPeak, peaks_[ch]);
+  }
+  return maxPeak;
+}
+
+float ChannelMeter::getRMSdB(int channel) const {
+  if (channel < 0 || channel >= numChannels_ || numSamples_ == 0) {
+    return -std::numeric_limits<float>::infinity();
+  }
+  if (rmsdBGeneration_[channel] != generation_) {
+    // 20 * log10(sqrt(x)) == 10 * log10(x), avoiding the square root.
+    rmsdB_[channel] = 10.0f * std::log10(sumsOfSquares_[channel] / numSamples_);
+    rmsdBGeneration_[channel] = generation_;
+  }
+  return rmsdB_[channel];
+}
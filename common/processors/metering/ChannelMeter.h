@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Per-channel block levels gathered in a single pass over a buffer.
+ *
+ * Peak and sum-of-squares are accumulated together so that each sample is
+ * read exactly once per block. RMS and dB values are derived from these on
+ * request and cached until the next call to process().
+ */
+class ChannelMeter {
+ public:
+  ChannelMeter(int maxChannels = 0);
+
+  // Preallocate storage for up to maxChannels so process() does not allocate.
+  void prepare(int maxChannels);
+
+  /**
+   * @brief Measure the first numChannels channels of the buffer. A negative
+   * channel count measures every channel in the buffer.
+   */
+  void process(const juce::AudioBuffer<float>& buffer, int numChannels = -1);
+
+  int getNumChannels() const { return numChannels_; }
+  int getNumSamples() const { return numSamples_; }
+
+  // Linear levels. Channels outside the measured range read as silence.
+  float getPeak(int channel) const;
+  float getSumOfSquares(int channel) const;
+  float getRMS(int channel) const;
+
+  // Largest linear peak across the first numChannels measured channels.
+  float getMaxPeak(int numChannels = -1) const;
+
+  // RMS level in dB. Converted lazily and cached for the current block.
+  float getRMSdB(int channel) const;
+
+ private:
+  int numChannels_ = 0;
+  int numSamples_ = 0;
+  std::vector<float> peaks_;
+  std::vector<float> sumsOfSquares_;
+
+  // A cached dB value is valid when its generation matches the current block.
+  uint32_t generation_ = 1;
+  mutable std::vector<float> rmsdB_;
+  mutable std::vector<uint32_t> rmsdBGeneration_;
+};
+
+/**
+ * @brief Resolves the levels a metering consumer should read.
+ *
+ * When an upstream MeteringProcessor publishes a shared meter, its results are
+ * returned directly. Otherwise the buffer is metered locally, which keeps
+ * consumers usable on their own.
+ */
+class ChannelMeterSource {
+ public:
+  ChannelMeterSource(const ChannelMeter* sharedMeter = nullptr)
+      : sharedMeter_(sharedMeter) {}
+
+  void prepare(int maxChannels) {
+    if (sharedMeter_ == nullptr) {
+      localMeter_.prepare(maxChannels);
+    }
+  }
+
+  const ChannelMeter& measure(const juce::AudioBuffer<float>& buffer,
+                              int numChannels = -1) {
+    if (sharedMeter_ != nullptr) {
+      return *sharedMeter_;
+    }
+    localMeter_.process(buffer, numChannels);
+    return localMeter_;
+  }
+
+ private:
+  const ChannelMeter* sharedMeter_;
+  ChannelMeter localMeter_;
+};
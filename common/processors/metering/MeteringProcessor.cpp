@@ -0,0 +1,29 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MeteringProcessor.h"
+
+MeteringProcessor::MeteringProcessor(ChannelMeter& meter, int numChannels)
+    : meter_(meter), numChannels_(numChannels) {}
+
+void MeteringProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+  juce::ignoreUnused(sampleRate, samplesPerBlock);
+  meter_.prepare(getHostWideLayout().size());
+}
+
+void MeteringProcessor::processBlock(juce::AudioBuffer<float>& buffer,
+                                     juce::MidiBuffer& midiMessages) {
+  juce::ignoreUnused(midiMessages);
+  meter_.process(buffer, numChannels_.load());
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "../processor_base/ProcessorBase.h"
+#include "ChannelMeter.h"
+
+//==============================================================================
+// Meters the buffer once per block and publishes the levels through a shared
+// ChannelMeter. Processors placed after this stage in the chain read the
+// meter instead of sweeping the buffer themselves.
+class MeteringProcessor final : public ProcessorBase {
+ public:
+  MeteringProcessor(ChannelMeter& meter, int numChannels = -1);
+
+  void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+  void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+  using AudioProcessor::processBlock;
+
+  const juce::String getName() const override { return {"Metering"}; }
+
+  // Limit metering to the first numChannels channels. A negative count
+  // meters every channel in the buffer.
+  void setNumChannels(int numChannels) { numChannels_.store(numChannels); }
+
+ private:
+  ChannelMeter& meter_;
+  std::atomic_int numChannels_;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeteringProcessor)
+};
@@ -17,9 +17,11 @@
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
 
 MixMonitorProcessor::MixMonitorProcessor(RoomSetupRepository& repo,
-                                         SpeakerMonitorData& data)
+                                         SpeakerMonitorData& data,
+                                         LoudnessTimeline& timeline)
     : roomSetupRepo_(repo),
       rtData_(data),
+      timeline_(timeline),
       playbackLayout_(juce::AudioChannelSet::mono()) {
   // Register as a listener to the room setup repository.
   roomSetupRepo_.registerListener(this);
@@ -44,6 +46,12 @@ void MixMonitorProcessor::prepareToPlay(double sampleRate,
     loudnessImpl_ = std::make_unique<MeasureEBU128>(sampleRate);
   }
 
+  samplesPerTimelinePoint_ = std::max(
+      1, (int)std::round(sampleRate * LoudnessTimeline::kIntervalSeconds));
+
+  playbackMeter_.prepare(getHostWideLayout().size());
+  loudnesses_.reserve(getHostWideLayout().size());
+
   // Reset stats on playback start.
   rtData_.resetStats = true;
   rtData_.loudnessEBU128.update({});
@@ -51,33 +59,58 @@ void MixMonitorProcessor::prepareToPlay(double sampleRate,
 
 void MixMonitorProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                        juce::MidiBuffer& midiMessages) {
-  // Get portion of buffer containing rendered channels.
-  rdrBuffer_ = getRenderedBuffer(buffer);
+  // Refer to the portion of buffer containing rendered channels in place.
+  // Playback layouts are speaker layouts of at most 24 channels, so this
+  // never has to fall back to a copy.
+  if (!referToChannels(
+          rdrBuffer_, buffer, 0,
+          juce::jmin(playbackLayout_.size(), buffer.getNumChannels()))) {
+    jassertfalse;
+    return;
+  }
 
   // UI triggered a stats update (rare).
   if (rtData_.resetStats.load()) {
     loudnessImpl_->reset(playbackLayout_, rdrBuffer_);
+    timeline_.restart();
+    samplesSinceTimelinePoint_ = 0;
+    timelineTruePeak_ = -std::numeric_limits<float>::infinity();
     rtData_.resetStats.store(false);
   }
+  // Measure per-channel peak and RMS in a single pass.
+  playbackMeter_.process(rdrBuffer_);
+
   // Measure EBU128 loudness statistics.
-  loudnessStats_ = loudnessImpl_->measureLoudness(playbackLayout_, rdrBuffer_);
+  loudnessStats_ = loudnessImpl_->measureLoudness(
+      playbackLayout_, rdrBuffer_, playbackMeter_.getMaxPeak());
   rtData_.loudnessEBU128.update(loudnessStats_);
+  updateTimeline(rdrBuffer_.getNumSamples());
 
-  // Measure per-channel loudness in dB.
-  std::vector<float> loudnesses(rdrBuffer_.getNumChannels());
-  for (int i = 0; i < rdrBuffer_.getNumChannels(); ++i) {
-    float loudness = 20.0f * std::log10(rdrBuffer_.getRMSLevel(
-                                 i, 0, rdrBuffer_.getNumSamples()));
-    loudnesses[i] = loudness;
+  // Publish per-channel loudness in dB.
+  loudnesses_.resize(playbackMeter_.getNumChannels());
+  for (int i = 0; i < playbackMeter_.getNumChannels(); ++i) {
+    loudnesses_[i] = playbackMeter_.getRMSdB(i);
   }
-  rtData_.playbackLoudness.update(loudnesses);
+  rtData_.playbackLoudness.update(loudnesses_);
 }
 
-const juce::AudioBuffer<float> MixMonitorProcessor::getRenderedBuffer(
-    juce::AudioBuffer<float>& busBuff) {
-  auto dataPtrs = busBuff.getArrayOfWritePointers();
-  int numRdrCh = playbackLayout_.size();
-  return juce::AudioBuffer<float>(dataPtrs, numRdrCh, busBuff.getNumSamples());
+void MixMonitorProcessor::updateTimeline(const int numSamples) {
+  timelineTruePeak_ =
+      std::max(timelineTruePeak_, loudnessImpl_->getBlockTruePeak());
+  samplesSinceTimelinePoint_ += numSamples;
+
+  // Blocks longer than the interval repeat the point so the timeline stays
+  // aligned with program time.
+  bool pushed = false;
+  while (samplesSinceTimelinePoint_ >= samplesPerTimelinePoint_) {
+    timeline_.push({loudnessStats_.loudnessMomentary,
+                    loudnessStats_.loudnessShortTerm, timelineTruePeak_});
+    samplesSinceTimelinePoint_ -= samplesPerTimelinePoint_;
+    pushed = true;
+  }
+  if (pushed) {
+    timelineTruePeak_ = -std::numeric_limits<float>::infinity();
+  }
 }
 
 void MixMonitorProcessor::valueTreePropertyChanged(
@@ -15,9 +15,11 @@
  */
 
 #pragma once
+#include <data_structures/src/LoudnessTimeline.h>
 #include <data_structures/src/SpeakerMonitorData.h>
 #include <processors/processor_base/ProcessorBase.h>
 
+#include "../metering/ChannelMeter.h"
 #include "data_repository/implementation/RoomSetupRepository.h"
 #include "loudness_standards/MeasureEBU128.h"
 
@@ -26,7 +28,8 @@ class MixMonitorProcessor : public ProcessorBase,
  public:
   using EBU128Stats = MeasureEBU128::LoudnessStats;
 
-  MixMonitorProcessor(RoomSetupRepository& repo, SpeakerMonitorData& data);
+  MixMonitorProcessor(RoomSetupRepository& repo, SpeakerMonitorData& data,
+                      LoudnessTimeline& timeline);
 
   ~MixMonitorProcessor() { roomSetupRepo_.deregisterListener(this); }
 
@@ -38,9 +41,8 @@ class MixMonitorProcessor : public ProcessorBase,
   EBU128Stats getEBU128Stats() { return loudnessStats_; }
 
  private:
-  // Create a buffer of rendered channels from the renderer processor buffer.
-  const juce::AudioBuffer<float> getRenderedBuffer(
-      juce::AudioBuffer<float>& busBuff);
+  // Push a loudness timeline point for every 100 ms of audio measured.
+  void updateTimeline(const int numSamples);
 
   void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged,
                                 const juce::Identifier& property) override;
@@ -50,13 +52,25 @@ class MixMonitorProcessor : public ProcessorBase,
   RoomSetupRepository& roomSetupRepo_;
 
   SpeakerMonitorData& rtData_;
+  // Loudness history of the playback mix, shown by the renderer's editor.
+  LoudnessTimeline& timeline_;
 
   // Recent copy of the current playback layout.
   juce::AudioChannelSet playbackLayout_;
 
-  // Buffer containing playback rendered audio.
+  // View of the playback rendered channels of the processed buffer.
   juce::AudioBuffer<float> rdrBuffer_;
 
+  // Per-channel levels of the rendered buffer, measured in a single pass.
+  ChannelMeter playbackMeter_;
+  std::vector<float> loudnesses_;
+
   std::unique_ptr<MeasureEBU128> loudnessImpl_;
   EBU128Stats loudnessStats_{};
+
+  // Timeline points are taken every samplesPerTimelinePoint_ samples, with
+  // the true peak held over the interval.
+  int samplesPerTimelinePoint_ = 4800;
+  int samplesSinceTimelinePoint_ = 0;
+  float timelineTruePeak_ = -std::numeric_limits<float>::infinity();
 };
\ No newline at end of file
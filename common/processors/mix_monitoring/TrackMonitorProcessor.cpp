@@ -17,13 +17,15 @@
 #include "data_structures/src/AudioElementSpatialLayout.h"
 
 TrackMonitorProcessor::TrackMonitorProcessor(
-    SpeakerMonitorData& data, AudioElementSpatialLayoutRepository* repo)
+    SpeakerMonitorData& data, AudioElementSpatialLayoutRepository* repo,
+    const ChannelMeter* sharedMeter)
     : audioElementSpatialLayoutRepository_(repo),
       rtData_(data),
       playbackLayout_(juce::AudioChannelSet::mono()),
       inputLayout_(Speakers::kMono),
       samplesPerBlock_(1),
-      sampleRate_(48000) {
+      sampleRate_(48000),
+      meterSource_(sharedMeter) {
   audioElementSpatialLayoutRepository_->registerListener(this);
 }
 
@@ -37,59 +39,85 @@ void TrackMonitorProcessor::prepareToPlay(double sampleRate,
     loudnessImpl_ = std::make_unique<MeasureEBU128>(sampleRate);
   }
 
-  // Construct a binaural renderer
-  binauralRendererLock_.enter();
-  binauralLoudnessRenderer_ = createRenderer(inputLayout_, Speakers::kBinaural,
-                                             samplesPerBlock, sampleRate);
-  binauralBuffer_ = juce::AudioBuffer<float>(
-      Speakers::kBinaural.getNumChannels(), samplesPerBlock);
-  binauralRendererLock_.exit();
+  meterSource_.prepare(getHostWideLayout().size());
+  loudnesses_.reserve(getHostWideLayout().size());
+  meanSquares_.reserve(getHostWideLayout().size());
+
+  updateBinauralEstimator();
 }
 
 void TrackMonitorProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                          juce::MidiBuffer& midiMessages) {
-  // Get portion of buffer containing rendered channels.
-  rdrBuffer_ = getRenderedBuffer(buffer);
+  // Everything measured here only feeds meters, so idle while none are shown.
+  if (!rtData_.consumers.isWatched()) {
+    idle_ = true;
+    return;
+  }
 
-  // UI triggered a stats update (rare).
-  if (rtData_.resetStats.load()) {
+  // Refer to the portion of buffer containing rendered channels in place.
+  // Playback layouts are speaker layouts of at most 24 channels, so this
+  // never has to fall back to a copy.
+  if (!referToChannels(
+          rdrBuffer_, buffer, 0,
+          juce::jmin(playbackLayout_.size(), buffer.getNumChannels()))) {
+    jassertfalse;
+    return;
+  }
+
+  // UI triggered a stats update (rare). Statistics gathered before idling
+  // would mix in audio from before the gap, so start them over on resume.
+  if (idle_ || rtData_.resetStats.load()) {
+    idle_ = false;
     loudnessImpl_->reset(playbackLayout_, rdrBuffer_);
     rtData_.resetStats.store(false);
   }
+  // Per-channel peak and RMS, shared with other consumers in the chain.
+  const ChannelMeter& levels =
+      meterSource_.measure(buffer, rdrBuffer_.getNumChannels());
+
   // Measure EBU128 loudness statistics.
-  loudnessStats_ = loudnessImpl_->measureLoudness(playbackLayout_, rdrBuffer_);
+  loudnessStats_ = loudnessImpl_->measureLoudness(
+      playbackLayout_, rdrBuffer_,
+      levels.getMaxPeak(rdrBuffer_.getNumChannels()));
   rtData_.loudnessEBU128.update(loudnessStats_);
 
-  // Measure per-channel loudness in dB.
-  std::vector<float> loudnesses(rdrBuffer_.getNumChannels());
+  // Publish per-channel loudness in dB.
+  loudnesses_.resize(rdrBuffer_.getNumChannels());
   for (int i = 0; i < rdrBuffer_.getNumChannels(); ++i) {
-    float loudness = 20.0f * std::log10(rdrBuffer_.getRMSLevel(
-                                 i, 0, rdrBuffer_.getNumSamples()));
-    loudnesses[i] = loudness;
+    loudnesses_[i] = levels.getRMSdB(i);
   }
-  rtData_.playbackLoudness.update(loudnesses);
-
-  // Measure binaural loudness by performing a binaural render
-  if (binauralLoudnessRenderer_ != nullptr) {
-    binauralRendererLock_.enter();
-    // Create a buffer to render the binaural audio to
-    binauralLoudnessRenderer_->render(rdrBuffer_, binauralBuffer_);
-    binauralRendererLock_.exit();
+  rtData_.playbackLoudness.update(loudnesses_);
+
+  // Estimate binaural loudness from the channel levels rather than rendering.
+  const juce::SpinLock::ScopedLockType lock(binauralEstimatorLock_);
+  if (binauralEstimator_ != nullptr) {
+    std::array<float, 2> meanSquares;
+    if (binauralEstimator_->isCoherent()) {
+      meanSquares = binauralEstimator_->estimate(rdrBuffer_);
+    } else {
+      const int numSamples = juce::jmax(1, rdrBuffer_.getNumSamples());
+      meanSquares_.resize(binauralEstimator_->getNumChannels());
+      for (int i = 0; i < (int)meanSquares_.size(); ++i) {
+        meanSquares_[i] = levels.getSumOfSquares(i) / numSamples;
+      }
+      meanSquares = binauralEstimator_->estimateFromMeanSquares(
+          meanSquares_.data());
+    }
 
-    std::array<float, 2> loudnesses = {-10, -10};
+    std::array<float, 2> loudnesses;
     for (int i = 0; i < 2; ++i) {
-      loudnesses[i] = 20.0f * std::log10(binauralBuffer_.getRMSLevel(
-                                  i, 0, binauralBuffer_.getNumSamples()));
+      loudnesses[i] = 10.f * std::log10(meanSquares[i]);
     }
     rtData_.binauralLoudness.update(loudnesses);
   }
 }
 
-const juce::AudioBuffer<float> TrackMonitorProcessor::getRenderedBuffer(
-    juce::AudioBuffer<float>& busBuff) {
-  auto dataPtrs = busBuff.getArrayOfWritePointers();
-  int numRdrCh = playbackLayout_.size();
-  return juce::AudioBuffer<float>(dataPtrs, numRdrCh, busBuff.getNumSamples());
+void TrackMonitorProcessor::updateBinauralEstimator() {
+  // Calibrating is slow the first time a layout is seen, so do it unlocked.
+  std::shared_ptr<const BinauralLoudnessEstimator> estimator =
+      BinauralLoudnessEstimator::getShared(inputLayout_, sampleRate_);
+  const juce::SpinLock::ScopedLockType lock(binauralEstimatorLock_);
+  binauralEstimator_.swap(estimator);
 }
 
 void TrackMonitorProcessor::valueTreePropertyChanged(
@@ -109,8 +137,5 @@ void TrackMonitorProcessor::valueTreePropertyChanged(
   playbackLayout_ =
       audioElementSpatialLayout.getChannelLayout().getChannelSet();
   inputLayout_ = audioElementSpatialLayout.getChannelLayout();
-  binauralRendererLock_.enter();
-  binauralLoudnessRenderer_ = createRenderer(inputLayout_, Speakers::kBinaural,
-                                             samplesPerBlock_, sampleRate_);
-  binauralRendererLock_.exit();
+  updateBinauralEstimator();
 }
@@ -18,17 +18,18 @@
 #include <data_structures/src/SpeakerMonitorData.h>
 #include <processors/processor_base/ProcessorBase.h>
 
+#include "../metering/ChannelMeter.h"
 #include "data_repository/implementation/AudioElementSpatialLayoutRepository.h"
 #include "loudness_standards/MeasureEBU128.h"
-#include "substream_rdr/rdr_factory/Renderer.h"
-#include "substream_rdr/rdr_factory/RendererFactory.h"
+#include "substream_rdr/bin_rdr/BinauralLoudnessEstimator.h"
 
 class TrackMonitorProcessor : public ProcessorBase, juce::ValueTree::Listener {
  public:
   using EBU128Stats = MeasureEBU128::LoudnessStats;
 
   TrackMonitorProcessor(SpeakerMonitorData& data,
-                        AudioElementSpatialLayoutRepository* repo);
+                        AudioElementSpatialLayoutRepository* repo,
+                        const ChannelMeter* sharedMeter = nullptr);
 
   ~TrackMonitorProcessor() = default;
 
@@ -40,27 +41,32 @@ class TrackMonitorProcessor : public ProcessorBase, juce::ValueTree::Listener {
   EBU128Stats getEBU128Stats() { return loudnessStats_; }
 
  private:
-  // Create a buffer of rendered channels from the renderer processor buffer.
-  const juce::AudioBuffer<float> getRenderedBuffer(
-      juce::AudioBuffer<float>& busBuff);
-
   void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged,
                                 const juce::Identifier& property) override;
   AudioElementSpatialLayoutRepository* audioElementSpatialLayoutRepository_;
   SpeakerMonitorData& rtData_;
 
-  juce::SpinLock binauralRendererLock_;
+  // Swap the binaural estimator for the current input layout and sample rate.
+  void updateBinauralEstimator();
+
+  juce::SpinLock binauralEstimatorLock_;
   Speakers::AudioElementSpeakerLayout inputLayout_;
-  std::unique_ptr<Renderer> binauralLoudnessRenderer_;
+  std::shared_ptr<const BinauralLoudnessEstimator> binauralEstimator_;
   int samplesPerBlock_, sampleRate_;
 
   // Recent copy of the current playback layout.
   juce::AudioChannelSet playbackLayout_;
 
-  // Buffer containing playback rendered audio.
+  // View of the playback rendered channels of the processed buffer.
   juce::AudioBuffer<float> rdrBuffer_;
-  juce::AudioBuffer<float> binauralBuffer_;
+
+  // Per-channel levels, either published upstream or measured here.
+  ChannelMeterSource meterSource_;
+  std::vector<float> loudnesses_;
+  std::vector<float> meanSquares_;
 
   std::unique_ptr<MeasureEBU128> loudnessImpl_;
   EBU128Stats loudnessStats_{};
+  // True while measurement is paused because no meters are shown.
+  bool idle_ = true;
 };
\ No newline at end of file
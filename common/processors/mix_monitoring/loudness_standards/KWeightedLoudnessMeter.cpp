@@ -0,0 +1,360 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "KWeightedLoudnessMeter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Gating block lengths expressed in 100 ms bins.
+constexpr int kMomentaryBins = 4;
+constexpr int kShortTermBins = 30;
+
+// Relative gates for integrated loudness (BS.1770) and LRA (EBU Tech 3342).
+constexpr double kIntegratedRelativeGate = -10.0;
+constexpr double kRangeRelativeGate = -20.0;
+
+double meanSquareToLoudness(const double meanSquare) {
+  return -0.691 + 10.0 * std::log10(meanSquare);
+}
+
+float toReportedLoudness(const double meanSquare) {
+  if (meanSquare <= 0.0) {
+    return KWeightedLoudnessMeter::kMinimalLoudness;
+  }
+  return std::max((float)meanSquareToLoudness(meanSquare),
+                  KWeightedLoudnessMeter::kMinimalLoudness);
+}
+}  // namespace
+
+//==============================================================================
+// Filter design follows the analogue prototypes fitted to the BS.1770 48 kHz
+// coefficients, re-discretised with the bilinear transform at sampleRate.
+KWeightedLoudnessMeter::BiquadCoefficients
+KWeightedLoudnessMeter::designPreFilter(const double sampleRate) {
+  const double f0 = 1681.974450955533;
+  const double gaindB = 3.999843853973347;
+  const double q = 0.7071752369554196;
+
+  const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+  const double vh = std::pow(10.0, gaindB / 20.0);
+  const double vb = std::pow(vh, 0.4996667741545416);
+  const double a0 = 1.0 + k / q + k * k;
+
+  return {(vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0,
+          (vh - vb * k / q + k * k) / a0, 2.0 * (k * k - 1.0) / a0,
+          (1.0 - k / q + k * k) / a0};
+}
+
+KWeightedLoudnessMeter::BiquadCoefficients
+KWeightedLoudnessMeter::designRLBFilter(const double sampleRate) {
+  const double f0 = 38.13547087602444;
+  const double q = 0.5003270373238773;
+
+  const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+  const double a0 = 1.0 + k / q + k * k;
+
+  return {1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0,
+          (1.0 - k / q + k * k) / a0};
+}
+
+float KWeightedLoudnessMeter::getChannelWeight(
+    const juce::AudioChannelSet::ChannelType type) {
+  switch (type) {
+    case juce::AudioChannelSet::LFE:
+    case juce::AudioChannelSet::LFE2:
+      return 0.f;
+    // Ear-level channels between 60 and 120 degrees azimuth.
+    case juce::AudioChannelSet::leftSurround:
+    case juce::AudioChannelSet::rightSurround:
+    case juce::AudioChannelSet::leftSurroundSide:
+    case juce::AudioChannelSet::rightSurroundSide:
+      return 1.41f;
+    default:
+      return 1.f;
+  }
+}
+
+//==============================================================================
+KWeightedLoudnessMeter::KWeightedLoudnessMeter() {
+  prepare(sampleRate_, juce::AudioChannelSet::mono());
+}
+
+void KWeightedLoudnessMeter::prepare(const double sampleRate,
+                                     const juce::AudioChannelSet& channelSet) {
+  sampleRate_ = sampleRate;
+  samplesPerBin_ = std::max(1, juce::roundToInt(sampleRate_ / 10.0));
+
+  const BiquadCoefficients pre = designPreFilter(sampleRate_);
+  preB0_ = Vec::expand((float)pre.b0);
+  preB1_ = Vec::expand((float)pre.b1);
+  preB2_ = Vec::expand((float)pre.b2);
+  preA1_ = Vec::expand((float)pre.a1);
+  preA2_ = Vec::expand((float)pre.a2);
+
+  const BiquadCoefficients rlb = designRLBFilter(sampleRate_);
+  rlbB0_ = Vec::expand((float)rlb.b0);
+  rlbB1_ = Vec::expand((float)rlb.b1);
+  rlbB2_ = Vec::expand((float)rlb.b2);
+  rlbA1_ = Vec::expand((float)rlb.a1);
+  rlbA2_ = Vec::expand((float)rlb.a2);
+
+  // Pack the layout's channels into groups of kLanes.
+  groups_.clear();
+  for (int first = 0; first < channelSet.size(); first += kLanes) {
+    ChannelGroup group{};
+    group.firstChannel = first;
+    group.numChannels = std::min(kLanes, channelSet.size() - first);
+    group.weights = Vec::expand(0.f);
+    for (int lane = 0; lane < group.numChannels; ++lane) {
+      group.weights.set(
+          lane, getChannelWeight(channelSet.getTypeOfChannel(first + lane)));
+    }
+    groups_.push_back(group);
+  }
+
+  // A chunk never spans more than one bin.
+  interleaved_.assign(samplesPerBin_, Vec::expand(0.f));
+
+  reset();
+}
+
+void KWeightedLoudnessMeter::reset() {
+  for (ChannelGroup& group : groups_) {
+    group.preS1 = group.preS2 = Vec::expand(0.f);
+    group.rlbS1 = group.rlbS2 = Vec::expand(0.f);
+  }
+  bins_.fill(0.0);
+  currentBin_ = 0;
+  numCompletedBins_ = 0;
+  samplesInBin_ = 0;
+  currentBinEnergy_ = 0.0;
+
+  momentaryBlocks_.reset();
+  shortTermBlocks_.reset();
+
+  momentaryLoudness_ = kMinimalLoudness;
+  shortTermLoudness_ = kMinimalLoudness;
+  integratedLoudness_ = kMinimalLoudness;
+  loudnessRange_ = 0.f;
+}
+
+void KWeightedLoudnessMeter::process(const juce::AudioBuffer<float>& buffer) {
+  juce::ScopedNoDenormals noDenormals;
+
+  int position = 0;
+  while (position < buffer.getNumSamples()) {
+    const int chunk = std::min(buffer.getNumSamples() - position,
+                               samplesPerBin_ - samplesInBin_);
+    filterChunk(buffer, position, chunk);
+    position += chunk;
+    samplesInBin_ += chunk;
+
+    if (samplesInBin_ == samplesPerBin_) {
+      completeBin();
+    }
+  }
+}
+
+void KWeightedLoudnessMeter::filterChunk(const juce::AudioBuffer<float>& buffer,
+                                         const int start,
+                                         const int numSamples) {
+  float* lanes = reinterpret_cast<float*>(interleaved_.data());
+
+  for (ChannelGroup& group : groups_) {
+    // Transpose the group's channels into one register per sample. Lanes
+    // without a channel (or missing from the buffer) are fed silence.
+    for (int lane = 0; lane < kLanes; ++lane) {
+      const int channel = group.firstChannel + lane;
+      if (lane < group.numChannels && channel < buffer.getNumChannels()) {
+        const float* src = buffer.getReadPointer(channel, start);
+        for (int i = 0; i < numSamples; ++i) {
+          lanes[i * kLanes + lane] = src[i];
+        }
+      } else {
+        for (int i = 0; i < numSamples; ++i) {
+          lanes[i * kLanes + lane] = 0.f;
+        }
+      }
+    }
+
+    Vec preS1 = group.preS1, preS2 = group.preS2;
+    Vec rlbS1 = group.rlbS1, rlbS2 = group.rlbS2;
+    Vec sumOfSquares = Vec::expand(0.f);
+    for (int i = 0; i < numSamples; ++i) {
+      const Vec x = interleaved_[i];
+
+      const Vec y = x * preB0_ + preS1;
+      preS1 = x * preB1_ - y * preA1_ + preS2;
+      preS2 = x * preB2_ - y * preA2_;
+
+      const Vec z = y * rlbB0_ + rlbS1;
+      rlbS1 = y * rlbB1_ - z * rlbA1_ + rlbS2;
+      rlbS2 = y * rlbB2_ - z * rlbA2_;
+
+      sumOfSquares += z * z;
+    }
+    group.preS1 = preS1;
+    group.preS2 = preS2;
+    group.rlbS1 = rlbS1;
+    group.rlbS2 = rlbS2;
+
+    currentBinEnergy_ += (sumOfSquares * group.weights).sum();
+  }
+}
+
+void KWeightedLoudnessMeter::completeBin() {
+  bins_[currentBin_] = currentBinEnergy_;
+  currentBin_ = (currentBin_ + 1) % kShortTermBins;
+  numCompletedBins_ = std::min(numCompletedBins_ + 1, kShortTermBins);
+  currentBinEnergy_ = 0.0;
+  samplesInBin_ = 0;
+
+  // Sum the most recent bins for the 400 ms and 3 s windows.
+  double momentaryEnergy = 0.0;
+  double shortTermEnergy = 0.0;
+  for (int i = 0; i < kShortTermBins; ++i) {
+    const int bin = (currentBin_ - 1 - i + kShortTermBins) % kShortTermBins;
+    if (i < kMomentaryBins) {
+      momentaryEnergy += bins_[bin];
+    }
+    shortTermEnergy += bins_[bin];
+  }
+  const double momentaryMeanSquare =
+      momentaryEnergy / ((double)kMomentaryBins * samplesPerBin_);
+  const double shortTermMeanSquare =
+      shortTermEnergy / ((double)kShortTermBins * samplesPerBin_);
+
+  momentaryLoudness_ = toReportedLoudness(momentaryMeanSquare);
+  shortTermLoudness_ = toReportedLoudness(shortTermMeanSquare);
+
+  // Gating blocks overlap by 75% for integrated loudness and are taken every
+  // 100 ms for LRA. Only complete blocks take part in gating.
+  if (numCompletedBins_ >= kMomentaryBins) {
+    momentaryBlocks_.addBlock(momentaryMeanSquare);
+    integratedLoudness_ =
+        momentaryBlocks_.getGatedLoudness(kIntegratedRelativeGate);
+  }
+  if (numCompletedBins_ >= kShortTermBins) {
+    shortTermBlocks_.addBlock(shortTermMeanSquare);
+    loudnessRange_ = shortTermBlocks_.getLoudnessRange(kRangeRelativeGate);
+  }
+}
+
+//==============================================================================
+void KWeightedLoudnessMeter::GatingHistogram::reset() {
+  countTree_.fill(0);
+  energyTree_.fill(0.0);
+  numBlocks_ = 0;
+  totalEnergy_ = 0.0;
+}
+
+void KWeightedLoudnessMeter::GatingHistogram::addBlock(
+    const double meanSquare) {
+  if (meanSquare <= 0.0) {
+    return;
+  }
+  const double loudness = meanSquareToLoudness(meanSquare);
+  if (loudness <= kAbsoluteGate) {
+    return;
+  }
+  for (int i = getBin(loudness) + 1; i <= kNumBins; i += i & -i) {
+    ++countTree_[i];
+    energyTree_[i] += meanSquare;
+  }
+  ++numBlocks_;
+  totalEnergy_ += meanSquare;
+}
+
+int KWeightedLoudnessMeter::GatingHistogram::getBin(
+    const double loudness) const {
+  const int bin = (int)std::floor((loudness - kAbsoluteGate) * kBinsPerLU);
+  return std::clamp(bin, 0, kNumBins - 1);
+}
+
+double KWeightedLoudnessMeter::GatingHistogram::getBinLoudness(
+    const int bin) const {
+  return kAbsoluteGate + (bin + 0.5) / kBinsPerLU;
+}
+
+int KWeightedLoudnessMeter::GatingHistogram::getRelativeGateBin(
+    const double relativeGateLU) const {
+  // The relative gate sits below the mean of all absolute-gated blocks.
+  const double gate =
+      meanSquareToLoudness(totalEnergy_ / numBlocks_) + relativeGateLU;
+  return gate <= kAbsoluteGate ? 0 : getBin(gate);
+}
+
+void KWeightedLoudnessMeter::GatingHistogram::getSumsBelow(
+    const int firstBin, uint64_t& count, double& energy) const {
+  count = 0;
+  energy = 0.0;
+  for (int i = firstBin; i > 0; i -= i & -i) {
+    count += countTree_[i];
+    energy += energyTree_[i];
+  }
+}
+
+int KWeightedLoudnessMeter::GatingHistogram::findBinAboveRank(
+    const double rank) const {
+  int step = 1;
+  while (step * 2 <= kNumBins) {
+    step *= 2;
+  }
+  // Descend to the last position whose cumulative count is within rank.
+  int position = 0;
+  uint64_t seen = 0;
+  for (; step > 0; step /= 2) {
+    const int next = position + step;
+    if (next <= kNumBins && seen + countTree_[next] <= rank) {
+      position = next;
+      seen += countTree_[next];
+    }
+  }
+  return std::min(position, kNumBins - 1);
+}
+
+float KWeightedLoudnessMeter::GatingHistogram::getGatedLoudness(
+    const double relativeGateLU) const {
+  if (numBlocks_ == 0) {
+    return kMinimalLoudness;
+  }
+  uint64_t countBelow;
+  double energyBelow;
+  getSumsBelow(getRelativeGateBin(relativeGateLU), countBelow, energyBelow);
+  const uint64_t count = numBlocks_ - countBelow;
+  const double energy = totalEnergy_ - energyBelow;
+  return count > 0 ? toReportedLoudness(energy / count) : kMinimalLoudness;
+}
+
+float KWeightedLoudnessMeter::GatingHistogram::getLoudnessRange(
+    const double relativeGateLU) const {
+  if (numBlocks_ == 0) {
+    return 0.f;
+  }
+  uint64_t countBelow;
+  double energyBelow;
+  getSumsBelow(getRelativeGateBin(relativeGateLU), countBelow, energyBelow);
+  const uint64_t count = numBlocks_ - countBelow;
+  if (count == 0) {
+    return 0.f;
+  }
+
+  // Locate the 10th and 95th percentiles of the gated blocks.
+  const double lowRank = countBelow + 0.10 * (count - 1);
+  const double highRank = countBelow + 0.95 * (count - 1);
+  return (float)(getBinLoudness(findBinAboveRank(highRank)) -
+                 getBinLoudness(findBinAboveRank(lowRank)));
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief ITU-R BS.1770 / EBU R128 loudness meter.
+ *
+ * Channels are packed into the lanes of a SIMD register so the K-weighting
+ * pre-filter and RLB high-pass run for several channels per instruction.
+ * Filter coefficients are derived from the analogue prototypes for any sample
+ * rate. Gating blocks are accumulated in fixed-size histograms indexed by
+ * Fenwick trees, so integrated loudness and loudness range are refreshed in
+ * O(log n) per 100 ms bin on the audio thread rather than by a full scan.
+ */
+class KWeightedLoudnessMeter {
+ public:
+  // Returned for loudness values when no signal has been measured.
+  static constexpr float kMinimalLoudness = -300.f;
+
+  struct BiquadCoefficients {
+    double b0, b1, b2, a1, a2;
+  };
+
+  // K-weighting stage 1: high-shelf modelling the acoustic effect of the head.
+  static BiquadCoefficients designPreFilter(const double sampleRate);
+  // K-weighting stage 2: revised low-frequency B-curve high-pass.
+  static BiquadCoefficients designRLBFilter(const double sampleRate);
+  // Channel weighting from ITU-R BS.1770-4 Table 3. LFE channels are ignored.
+  static float getChannelWeight(const juce::AudioChannelSet::ChannelType type);
+
+  KWeightedLoudnessMeter();
+
+  // Configure for a sample rate and channel layout. Clears all measurements.
+  void prepare(const double sampleRate, const juce::AudioChannelSet& channelSet);
+
+  // Clear all measurements, keeping the current configuration.
+  void reset();
+
+  // Filter and accumulate a block of audio. Does not allocate.
+  void process(const juce::AudioBuffer<float>& buffer);
+
+  float getMomentaryLoudness() const { return momentaryLoudness_; }
+  float getShortTermLoudness() const { return shortTermLoudness_; }
+  float getIntegratedLoudness() const { return integratedLoudness_; }
+  float getLoudnessRange() const { return loudnessRange_; }
+
+ private:
+  using Vec = juce::dsp::SIMDRegister<float>;
+  static constexpr int kLanes = (int)Vec::SIMDNumElements;
+
+  // A group of up to kLanes channels filtered together.
+  struct ChannelGroup {
+    int firstChannel, numChannels;
+    Vec weights;
+    // Transposed direct form II state for each filter stage.
+    Vec preS1, preS2, rlbS1, rlbS2;
+  };
+
+  /**
+   * @brief Histogram of gating block loudnesses at 0.1 LU resolution.
+   *
+   * Each bin keeps the block count and the summed mean-square energy of its
+   * blocks, so gated means are exact apart from the bin containing the
+   * relative threshold. Bins are stored as Fenwick trees so the sums above a
+   * gate and the percentile bins are found without walking every bin.
+   */
+  class GatingHistogram {
+   public:
+    void reset();
+    void addBlock(const double meanSquare);
+
+    // Mean loudness of the blocks above the relative gate.
+    float getGatedLoudness(const double relativeGateLU) const;
+    // Spread between the 10th and 95th percentile after relative gating.
+    float getLoudnessRange(const double relativeGateLU) const;
+
+   private:
+    static constexpr double kAbsoluteGate = -70.0;
+    static constexpr double kMaxLoudness = 30.0;
+    static constexpr double kBinsPerLU = 10.0;
+    static constexpr int kNumBins =
+        (int)((kMaxLoudness - kAbsoluteGate) * kBinsPerLU);
+
+    int getBin(const double loudness) const;
+    double getBinLoudness(const int bin) const;
+    int getRelativeGateBin(const double relativeGateLU) const;
+    // Block count and energy of the bins below firstBin.
+    void getSumsBelow(const int firstBin, uint64_t& count,
+                      double& energy) const;
+    // First bin at which the cumulative block count exceeds rank.
+    int findBinAboveRank(const double rank) const;
+
+    // 1-based Fenwick trees over the bins.
+    std::array<uint64_t, kNumBins + 1> countTree_{};
+    std::array<double, kNumBins + 1> energyTree_{};
+    uint64_t numBlocks_ = 0;
+    double totalEnergy_ = 0.0;
+  };
+
+  void filterChunk(const juce::AudioBuffer<float>& buffer, const int start,
+                   const int numSamples);
+  void completeBin();
+
+  double sampleRate_ = 48e3;
+  int samplesPerBin_ = 4800;
+  int samplesInBin_ = 0;
+
+  Vec preB0_, preB1_, preB2_, preA1_, preA2_;
+  Vec rlbB0_, rlbB1_, rlbB2_, rlbA1_, rlbA2_;
+  std::vector<ChannelGroup> groups_;
+  // Samples of the channel group being filtered, one register per sample.
+  std::vector<Vec> interleaved_;
+
+  // Weighted sum of squares of the 100 ms bins covering the last 3 seconds.
+  std::array<double, 30> bins_{};
+  int currentBin_ = 0;
+  int numCompletedBins_ = 0;
+  double currentBinEnergy_ = 0.0;
+
+  GatingHistogram momentaryBlocks_;
+  GatingHistogram shortTermBlocks_;
+
+  float momentaryLoudness_ = kMinimalLoudness;
+  float shortTermLoudness_ = kMinimalLoudness;
+  float integratedLoudness_ = kMinimalLoudness;
+  float loudnessRange_ = 0.f;
+};
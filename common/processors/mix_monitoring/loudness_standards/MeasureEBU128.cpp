@@ -28,6 +28,13 @@ MeasureEBU128::MeasureEBU128(const double sampleRate,
 MeasureEBU128::LoudnessStats MeasureEBU128::measureLoudness(
     const juce::AudioChannelSet& currPlaybackLayout,
     const juce::AudioBuffer<float>& buffer) {
+  return measureLoudness(currPlaybackLayout, buffer,
+                         buffer.getMagnitude(0, buffer.getNumSamples()));
+}
+
+MeasureEBU128::LoudnessStats MeasureEBU128::measureLoudness(
+    const juce::AudioChannelSet& currPlaybackLayout,
+    const juce::AudioBuffer<float>& buffer, const float bufferPeak) {
   // If the playback layout has changed or the buffer isn't sized as expected
   // reconfigure, reset internal loudness stats.
   if (buffer.getNumChannels() != currPlaybackLayout.size() ||
@@ -40,15 +47,16 @@ MeasureEBU128::LoudnessStats MeasureEBU128::measureLoudness(
   }
 
   // Update max permitted true peak level.
+  blockTruePeak_ = calculateTruePeakLevel(buffer);
   loudnessStats_.loudnessTruePeak =
-      std::max(loudnessStats_.loudnessTruePeak, calculateTruePeakLevel(buffer));
+      std::max(loudnessStats_.loudnessTruePeak, blockTruePeak_);
 
   // Update the max digital peak level.
   loudnessStats_.loudnessDigitalPeak = std::max(
-      loudnessStats_.loudnessDigitalPeak, calculateDigitalPeak(buffer));
+      loudnessStats_.loudnessDigitalPeak, digitalPeakTodB(bufferPeak));
 
   // Update the LUF based loudness stats
-  loudnessMeter_.processBlock(buffer);
+  loudnessMeter_.process(buffer);
   loudnessStats_.loudnessMomentary = loudnessMeter_.getMomentaryLoudness();
   loudnessStats_.loudnessShortTerm = loudnessMeter_.getShortTermLoudness();
   loudnessStats_.loudnessIntegrated = loudnessMeter_.getIntegratedLoudness();
@@ -61,8 +69,7 @@ void MeasureEBU128::reset(const juce::AudioChannelSet& currPlaybackLayout,
                           const juce::AudioBuffer<float>& buffer) {
   playbackLayout_ = currPlaybackLayout;
   upsampleRatio_ = 192e3 / kSampleRate_;  // ITU 1770-5 Annex 2.
-  loudnessMeter_.prepareToPlay(kSampleRate_, playbackLayout_.size(),
-                               buffer.getNumSamples(), 1);
+  loudnessMeter_.prepare(kSampleRate_, playbackLayout_);
 
   int numChannels = playbackLayout_.size();
   perChannelResamplers_.clear();
@@ -83,6 +90,7 @@ void MeasureEBU128::reset(const juce::AudioChannelSet& currPlaybackLayout,
   lpf_.filter.prepare(spec);
   lpf_.filter.reset();
 
+  blockTruePeak_ = -std::numeric_limits<float>::infinity();
   loudnessStats_ = {-std::numeric_limits<float>::infinity(),
                     -std::numeric_limits<float>::infinity(),
                     -std::numeric_limits<float>::infinity(),
@@ -139,7 +147,11 @@ float MeasureEBU128::calculateDigitalPeak(
       digitalPeak = std::max(digitalPeak, std::abs(channelData[j]));
     }
   }
-  float digitalPeakdB = 20.f * std::log10(digitalPeak);
+  return digitalPeakTodB(digitalPeak);
+}
+
+float MeasureEBU128::digitalPeakTodB(const float peak) {
+  float digitalPeakdB = 20.f * std::log10(peak);
   // boiler plate check for unreasonable values
   if (digitalPeakdB > 15.f) {
     return std::numeric_limits<float>::quiet_NaN();
@@ -19,7 +19,7 @@
 #include <juce_dsp/juce_dsp.h>
 #include <logger/logger.h>
 
-#include "EBU128LoudnessMeter.h"
+#include "KWeightedLoudnessMeter.h"
 
 class MeasureEBU128 {
  public:
@@ -31,11 +31,8 @@ class MeasureEBU128 {
 
   /**
    * @brief Create a loudness measurement object for a given sample rate and
-   * rendering layout.
-   * NOTE:
-   * Filter coefficients are hard-coded from ITU 1770 for a sample rate of
-   * 48kHz, so calculations at other sample rates are currently expected to be
-   * inaccurate.
+   * rendering layout. K-weighting filter coefficients are derived for the
+   * given sample rate.
    * @param sampleRate
    * @param chData Playback layout for which to measure loudness.
    */
@@ -47,6 +44,15 @@ class MeasureEBU128 {
   LoudnessStats measureLoudness(const juce::AudioChannelSet& currPlaybackLayout,
                                 const juce::AudioBuffer<float>& buffer);
 
+  /**
+   * @brief Calculate EBU128 loudness statistics, reusing a linear sample peak
+   * already measured for this buffer (e.g. by a ChannelMeter) instead of
+   * sweeping the buffer again for the digital peak.
+   */
+  LoudnessStats measureLoudness(const juce::AudioChannelSet& currPlaybackLayout,
+                                const juce::AudioBuffer<float>& buffer,
+                                const float bufferPeak);
+
   /**
    * @brief Reset internal measurements.
    *
@@ -65,6 +71,13 @@ class MeasureEBU128 {
 
   float calculateDigitalPeak(const juce::AudioBuffer<float>& buffer);
 
+  // Convert a linear sample peak to a sanitised digital peak level in dB.
+  static float digitalPeakTodB(const float peak);
+
+  // True peak level of the most recently measured buffer alone, as opposed
+  // to the session maximum reported in LoudnessStats.
+  float getBlockTruePeak() const { return blockTruePeak_; }
+
   struct LPF {
     juce::dsp::AudioBlock<float> block;
     juce::dsp::ProcessorDuplicator<juce::dsp::FIR::Filter<float>,
@@ -75,14 +88,15 @@ class MeasureEBU128 {
   const double kSampleRate_;
   juce::AudioChannelSet playbackLayout_;
 
-  // Library for calculating loudness and range values
-  Ebu128LoudnessMeter loudnessMeter_;
+  // Calculates loudness and range values
+  KWeightedLoudnessMeter loudnessMeter_;
 
   // Resamplers for true peak calculation.
   int upsampleRatio_ = 4;  // Upsampling ratio for true peak calculation.
   juce::AudioBuffer<float> upsampledBuffer_;  // Larger buffer to upsample into.
   std::vector<juce::Interpolators::Lagrange> perChannelResamplers_;
   LPF lpf_;
+  float blockTruePeak_ = -std::numeric_limits<float>::infinity();
 
   // Internal copy of calculated loudness statistics to return when
   // loudnesses' are queried between measurement periods.
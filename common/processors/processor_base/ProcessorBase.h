@@ -85,6 +85,27 @@ class ProcessorBase : public juce::AudioProcessor {
     }
   }
 
+  // JUCE keeps the channel pointers of buffers with fewer channels than this
+  // inline, and allocates them on the heap for wider ones.
+  static constexpr int kMaxInlineChannels = 32;
+
+  // Point view at numChannels channels of buffer starting at firstChannel,
+  // without copying any audio. Writes through the view land in buffer.
+  // Returns false, leaving view as it was, for kMaxInlineChannels channels or
+  // more, as setting those up would allocate on the audio thread.
+  static bool referToChannels(juce::AudioBuffer<float>& view,
+                              juce::AudioBuffer<float>& buffer,
+                              const int firstChannel, const int numChannels) {
+    jassert(firstChannel >= 0 &&
+            firstChannel + numChannels <= buffer.getNumChannels());
+    if (numChannels >= kMaxInlineChannels) {
+      return false;
+    }
+    view.setDataToReferTo(buffer.getArrayOfWritePointers() + firstChannel,
+                          numChannels, buffer.getNumSamples());
+    return true;
+  }
+
   void prepareToPlay(double sampleRate, int samplesPerBlock) override {
     juce::ignoreUnused(sampleRate, samplesPerBlock);
   }
@@ -15,26 +15,37 @@
 #include "processors.h"
 
 #include "audioelementplugin_publisher/AudioElementPluginDataPublisher.cpp"
-#include "audioelementplugin_publisher/MessagingThread.cpp"
 #include "channel_monitor/ChannelMonitorProcessor.cpp"
+#include "file_output/AsyncWavFileWriter.cpp"
+#include "file_output/ExportStats.cpp"
+#include "file_output/FileExportJobQueue.cpp"
 #include "file_output/FileOutputProcessor.cpp"
 #include "file_output/FileOutputProcessor_PremierePro.cpp"
 #include "file_output/WavFileOutputProcessor.cpp"
+#include "file_output/adm_export_utils/ADMFileWriter.cpp"
+#include "file_output/adm_export_utils/BW64Writer.cpp"
+#include "file_output/iamf_export_utils/IAMFByteSource.cpp"
 #include "file_output/iamf_export_utils/IAMFExportUtil.cpp"
 #include "file_output/iamf_export_utils/IAMFFileReader.cpp"
 #include "file_output/iamf_export_utils/IAMFFileWriter.cpp"
+#include "file_output/iamf_export_utils/IAMFMp4Writer.cpp"
+#include "file_output/iamf_export_utils/IAMFSplicer.cpp"
 #include "gain/GainEditor.cpp"
 #include "gain/GainProcessor.cpp"
 #include "gain/MSProcessor.cpp"
 #include "loudness_export/LoudnessExportProcessor.cpp"
 #include "loudness_export/LoudnessExportProcessor_PremierePro.cpp"
 #include "loudness_export/MixPresentationLoudnessExportContainer.cpp"
+#include "metering/ChannelMeter.cpp"
+#include "metering/MeteringProcessor.cpp"
 #include "mix_monitoring/MixMonitorProcessor.cpp"
 #include "mix_monitoring/TrackMonitorProcessor.cpp"
+#include "mix_monitoring/loudness_standards/KWeightedLoudnessMeter.cpp"
 #include "mix_monitoring/loudness_standards/MeasureEBU128.cpp"
 #include "panner/Panner3DProcessor.cpp"
 #include "remapping/RemappingProcessor.cpp"
 #include "render/RenderProcessor.cpp"
+#include "routing/ChannelRoutingPlan.cpp"
 #include "routing/RoutingProcessor.cpp"
 #include "soundfield/SoundFieldProcessor.cpp"
 #include "soundfield/SoundFieldReconstructor.cpp"
\ No newline at end of file
@@ -33,8 +33,8 @@ END_JUCE_MODULE_DECLARATION
 #endif
 
 #include "audioelementplugin_publisher/AudioElementPluginDataPublisher.h"
-#include "audioelementplugin_publisher/MessagingThread.h"
 #include "channel_monitor/ChannelMonitorProcessor.h"
+#include "file_output/FileExportJobQueue.h"
 #include "file_output/FileOutputProcessor.h"
 #include "file_output/FileOutputProcessor_PremierePro.h"
 #include "file_output/WavFileOutputProcessor.h"
@@ -44,11 +44,14 @@ END_JUCE_MODULE_DECLARATION
 #include "loudness_export/LoudnessExportProcessor.h"
 #include "loudness_export/LoudnessExportProcessor_PremierePro.h"
 #include "loudness_export/MixPresentationLoudnessExportContainer.h"
+#include "metering/ChannelMeter.h"
+#include "metering/MeteringProcessor.h"
 #include "mix_monitoring/MixMonitorProcessor.h"
 #include "mix_monitoring/TrackMonitorProcessor.h"
 #include "panner/Panner3DProcessor.h"
 #include "processor_base/ProcessorBase.h"
 #include "remapping/RemappingProcessor.h"
 #include "render/RenderProcessor.h"
+#include "routing/ChannelRoutingPlan.h"
 #include "routing/RoutingProcessor.h"
 #include "soundfield/SoundFieldProcessor.h"
\ No newline at end of file
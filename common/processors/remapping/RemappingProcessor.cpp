@@ -55,36 +55,18 @@ void RemappingProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
   } else {
     remapTable_ = constructRemapTable(busChannels, expectedChannels);
   }
-}
-
-void RemappingProcessor::processBlock(juce::AudioBuffer<float>& buffer,
-                                      juce::MidiBuffer&) {
-  if (!remapTable_.empty()) {
-    remapBuffer(buffer);
-  }
-}
 
-const juce::AudioBuffer<float> RemappingProcessor::createBufferCopy(
-    const juce::AudioBuffer<float>& buffer) const {
-  // Create a copy of the input buffer
-  juce::AudioBuffer<float> copy(buffer.getNumChannels(),
-                                buffer.getNumSamples());
-  for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
-    copy.copyFrom(channel, 0, buffer, channel, 0, buffer.getNumSamples());
+  plan_.prepare(channelSet.size(), samplesPerBlock);
+  for (const auto& remap : remapTable_) {
+    plan_.setSource(remap.targetChannel, remap.sourceChannel);
   }
-  return copy;
+  plan_.compile();
 }
 
-// converts from protools to the standard layout
-void RemappingProcessor::remapBuffer(juce::AudioBuffer<float>& buffer) {
-  // Create a copy of the input buffer
-  juce::AudioBuffer<float> originalBuffer = createBufferCopy(buffer);
-
-  // iterate through the remap table
-  for (const auto& remap : remapTable_) {
-    buffer.copyFrom(remap.targetChannel, 0, originalBuffer, remap.sourceChannel,
-                    0, originalBuffer.getNumSamples());
-  }
+void RemappingProcessor::processBlock(juce::AudioBuffer<float>& buffer,
+                                      juce::MidiBuffer&) {
+  // converts from protools to the standard layout
+  plan_.process(buffer);
 }
 
 PassthroughRemapTable RemappingProcessor::constructRemapTable(
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "../processor_base/ProcessorBase.h"
+#include "../routing/ChannelRoutingPlan.h"
 
 // this struct strictly serves the purpose of improving readability
 // the source channel is the channel that is being remapped
@@ -63,15 +64,12 @@ class RemappingProcessor final : public ProcessorBase,
   const PassthroughRemapTable getRemapTable() const { return remapTable_; }
 
  private:
-  void remapBuffer(juce::AudioBuffer<float>& buffer);
-
-  const juce::AudioBuffer<float> createBufferCopy(
-      const juce::AudioBuffer<float>& buffer) const;
-
   PassthroughRemapTable constructRemapTable(
       const juce::Array<juce::AudioChannelSet::ChannelType>& sourceChannels,
       const juce::Array<juce::AudioChannelSet::ChannelType>& targetChannels);
   PassthroughRemapTable remapTable_;
+  // remapTable_ compiled into in place channel moves
+  ChannelRoutingPlan plan_;
   ProcessorBase* hostProcessor_;
   const bool kHandleOutputBus_;
 };
\ No newline at end of file
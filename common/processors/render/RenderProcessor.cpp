@@ -60,7 +60,8 @@ RenderProcessor::RenderProcessor(ProcessorBase* hostProc,
       activeMixPresData_(activeMixdata),
       monitorData_(data),
       currentSamplesPerBlock_(1),
-      speakersOut_(1) {
+      speakersOut_(1),
+      binauralMeter_(Speakers::kBinaural.getNumChannels()) {
   currentPlaybackLayout_ =
       roomSetupData->get().getSpeakerLayout().getRoomSpeakerLayout();
 
@@ -207,32 +208,54 @@ void RenderProcessor::processBlock(juce::AudioBuffer<float>& buffer,
   // UI thread while processing.
   const juce::SpinLock::ScopedLockType lock(renderersLock_);
 
+  // Besides binaural playback, the binaural mix only feeds the binaural
+  // meters, so skip rendering it while none are shown.
+  const bool renderBinaural = currentPlaybackLayout_ == Speakers::kBinaural ||
+                              monitorData_.consumers.isWatched();
+
   // Fetch each audio element currently being played back, render it to this
   // room setup
   for (auto& aeRdr : audioElementRenderers_) {
     // Clear the buffers (may not have to clear output, unsure)
-    aeRdr->inputData.clear();
     aeRdr->outputData.clear();
     aeRdr->outputDataBinaural.clear();
 
-    // Copy Audio Element substream data from the process block buffer to the
-    // AudioElementRenderer's input buffer.
-    for (int ch = 0; ch < aeRdr->inputData.getNumChannels(); ++ch) {
-      aeRdr->inputData.copyFrom(ch, 0, buffer, aeRdr->firstChannel + ch, 0,
-                                buffer.getNumSamples());
+    // Renderers read the audio element's channels straight from the process
+    // block buffer. Blocks shorter than the renderers were prepared for,
+    // elements reaching past the end of the buffer, and elements too wide to
+    // refer to without allocating are staged in the AudioElementRenderer's
+    // input buffer instead.
+    const int numInputChannels = aeRdr->inputData.getNumChannels();
+    const bool inPlace =
+        buffer.getNumSamples() == aeRdr->inputData.getNumSamples() &&
+        aeRdr->firstChannel + numInputChannels <= buffer.getNumChannels() &&
+        referToChannels(aeRdr->inputView, buffer, aeRdr->firstChannel,
+                        numInputChannels);
+    if (!inPlace) {
+      aeRdr->inputData.clear();
+      const int numCopied = juce::jmin(
+          numInputChannels, buffer.getNumChannels() - aeRdr->firstChannel);
+      for (int ch = 0; ch < numCopied; ++ch) {
+        aeRdr->inputData.copyFrom(
+            ch, 0, buffer, aeRdr->firstChannel + ch, 0,
+            juce::jmin(buffer.getNumSamples(),
+                       aeRdr->inputData.getNumSamples()));
+      }
     }
+    const juce::AudioBuffer<float>& input =
+        inPlace ? aeRdr->inputView : aeRdr->inputData;
 
-    // Always attempt to render binaural audio.
     // This renderer is never null, it is either a BinauralRdr, a BedToBedRdr or
     // a PassthroughRdr.
     if (aeRdr->rendererBinaural != nullptr) {
-      aeRdr->rendererBinaural->render(aeRdr->inputData,
-                                      aeRdr->outputDataBinaural);
-
-      // Mix rendered binaural audio to the internal binaural mix buffer.
-      for (int i = 0; i < Speakers::kBinaural.getNumChannels(); ++i) {
-        binauralMixBuffer_.addFrom(i, 0, aeRdr->outputDataBinaural, i, 0,
-                                   binauralMixBuffer_.getNumSamples());
+      if (renderBinaural) {
+        aeRdr->rendererBinaural->render(input, aeRdr->outputDataBinaural);
+
+        // Mix rendered binaural audio to the internal binaural mix buffer.
+        for (int i = 0; i < Speakers::kBinaural.getNumChannels(); ++i) {
+          binauralMixBuffer_.addFrom(i, 0, aeRdr->outputDataBinaural, i, 0,
+                                     binauralMixBuffer_.getNumSamples());
+        }
       }
 
       // Render beds audio if playback is not binaural,
@@ -240,7 +263,7 @@ void RenderProcessor::processBlock(juce::AudioBuffer<float>& buffer,
       // renderer is not null.
       if (currentPlaybackLayout_ != Speakers::kBinaural &&
           aeRdr->renderer != nullptr) {
-        aeRdr->renderer->render(aeRdr->inputData, aeRdr->outputData);
+        aeRdr->renderer->render(input, aeRdr->outputData);
       }
 
       // Mix the rendered audio to the internal mix buffer.
@@ -254,7 +277,9 @@ void RenderProcessor::processBlock(juce::AudioBuffer<float>& buffer,
 
   // Update the binaural loudness from the rendered and mixed binaural
   // buffer.
-  updateBinauralLoudness(binauralMixBuffer_);
+  if (renderBinaural) {
+    updateBinauralLoudness(binauralMixBuffer_);
+  }
 
   buffer.clear();
 
@@ -282,9 +307,9 @@ void RenderProcessor::updateBinauralLoudness(
     loudnesses[0] = -300.f;
     loudnesses[1] = -300.f;
   } else {
+    binauralMeter_.process(rdrdAudio, 2);
     for (int i = 0; i < 2; ++i) {
-      loudnesses[i] = 20.0f * std::log10(rdrdAudio.getRMSLevel(
-                                  i, 0, rdrdAudio.getNumSamples()));
+      loudnesses[i] = binauralMeter_.getRMSdB(i);
     }
   }
 
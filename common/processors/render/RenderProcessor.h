@@ -29,6 +29,7 @@
 
 #include <vector>
 
+#include "../metering/ChannelMeter.h"
 #include "../processor_base/ProcessorBase.h"
 #include "data_repository/implementation/AudioElementRepository.h"
 #include "data_repository/implementation/RoomSetupRepository.h"
@@ -41,8 +42,11 @@
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
 
 struct AudioElementRenderer {
-  // Pre-allocated buffer to be used to write the audio elements data to
+  // Pre-allocated buffer to be used to write the audio elements data to when
+  // it cannot be read in place.
   juce::AudioBuffer<float> inputData;
+  // View of the audio element's channels in the processed buffer.
+  juce::AudioBuffer<float> inputView;
   juce::AudioBuffer<float> outputData;
   juce::AudioBuffer<float> outputDataBinaural;
 
@@ -171,6 +175,7 @@ class RenderProcessor final : public ProcessorBase, juce::ValueTree::Listener {
   std::vector<AudioElementRenderer*> audioElementRenderers_;
   juce::AudioBuffer<float> mixBuffer_;
   juce::AudioBuffer<float> binauralMixBuffer_;
+  ChannelMeter binauralMeter_;
   Speakers::AudioElementSpeakerLayout currentPlaybackLayout_;
   int currentSamplesPerBlock_;
   int currentSampleRate_ = 48000;
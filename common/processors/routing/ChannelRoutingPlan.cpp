@@ -0,0 +1,125 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ChannelRoutingPlan.h"
+
+void ChannelRoutingPlan::prepare(const int maxChannels,
+                                 const int maxSamplesPerBlock) {
+  sources_.resize(maxChannels);
+  pendingReaders_.resize(maxChannels);
+  pending_.resize(maxChannels);
+  // Every channel written once, plus at most one save per cycle of two or
+  // more channels
+  ops_.reserve(maxChannels + maxChannels / 2);
+  scratch_.setSize(1, juce::jmax(1, maxSamplesPerBlock));
+  setIdentity(maxChannels);
+  compile();
+}
+
+void ChannelRoutingPlan::setIdentity(const int numChannels) {
+  jassert(numChannels <= getMaxChannels());
+  numChannels_ = juce::jmin(numChannels, getMaxChannels());
+  for (int channel = 0; channel < numChannels_; ++channel) {
+    sources_[channel] = channel;
+  }
+}
+
+void ChannelRoutingPlan::setSource(const int dest, const int source) {
+  jassert(dest >= 0 && dest < numChannels_);
+  jassert(source >= kClear && source < numChannels_);
+  sources_[dest] = source;
+}
+
+void ChannelRoutingPlan::compile() {
+  ops_.clear();
+  int remaining = 0;
+  for (int channel = 0; channel < numChannels_; ++channel) {
+    pendingReaders_[channel] = 0;
+  }
+  for (int channel = 0; channel < numChannels_; ++channel) {
+    pending_[channel] = sources_[channel] != channel;
+    if (pending_[channel]) {
+      ++remaining;
+      if (sources_[channel] >= 0) {
+        ++pendingReaders_[sources_[channel]];
+      }
+    }
+  }
+
+  // Channel currently saved in the scratch channel
+  int saved = kClear;
+  while (remaining > 0) {
+    // Write every channel whose audio is no longer needed
+    bool progress = false;
+    for (int channel = 0; channel < numChannels_; ++channel) {
+      if (!pending_[channel] || pendingReaders_[channel] > 0) {
+        continue;
+      }
+      const int source = sources_[channel];
+      ops_.push_back(
+          {channel, source >= 0 && source == saved ? kScratch : source});
+      pending_[channel] = false;
+      --remaining;
+      if (source >= 0) {
+        --pendingReaders_[source];
+      }
+      progress = true;
+    }
+
+    // Only cycles are left. Save one channel of a cycle to open it up.
+    if (!progress) {
+      for (int channel = 0; channel < numChannels_; ++channel) {
+        if (pending_[channel]) {
+          ops_.push_back({kScratch, channel});
+          saved = channel;
+          pendingReaders_[channel] = 0;
+          break;
+        }
+      }
+    }
+  }
+}
+
+void ChannelRoutingPlan::process(juce::AudioBuffer<float>& buffer) {
+  if (ops_.empty()) {
+    return;
+  }
+  jassert(buffer.getNumChannels() >= numChannels_);
+  if (buffer.getNumChannels() < numChannels_) {
+    return;
+  }
+
+  // Blocks longer than the scratch channel are processed in several passes
+  const int numSamples = buffer.getNumSamples();
+  const int passLength = scratch_.getNumSamples();
+  for (int start = 0; start < numSamples; start += passLength) {
+    processRange(buffer, start, juce::jmin(passLength, numSamples - start));
+  }
+}
+
+void ChannelRoutingPlan::processRange(juce::AudioBuffer<float>& buffer,
+                                      const int start, const int numSamples) {
+  for (const Op& op : ops_) {
+    if (op.source == kClear) {
+      buffer.clear(op.dest, start, numSamples);
+      continue;
+    }
+    float* dest = op.dest == kScratch ? scratch_.getWritePointer(0)
+                                      : buffer.getWritePointer(op.dest, start);
+    const float* source = op.source == kScratch
+                              ? scratch_.getReadPointer(0)
+                              : buffer.getReadPointer(op.source, start);
+    juce::FloatVectorOperations::copy(dest, source, numSamples);
+  }
+}
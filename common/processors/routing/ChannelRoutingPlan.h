@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <vector>
+
+/**
+ * @brief Moves the channels of a buffer around in place.
+ *
+ * Describe where each channel's audio comes from with setSource(), then
+ * compile() the map into a sequence of channel copies and clears. Copies are
+ * ordered so that no channel is overwritten before every channel reading it
+ * has been written. Channels that form a cycle are rotated through a single
+ * scratch channel.
+ *
+ * Only compile() changes the plan, and only prepare() allocates, so a plan
+ * can be rebuilt and run on the audio thread.
+ */
+class ChannelRoutingPlan {
+ public:
+  // Source of a channel that is silenced.
+  static constexpr int kClear = -1;
+
+  // Allocate for up to maxChannels channels and blocks of maxSamplesPerBlock,
+  // and reset to the identity. Larger blocks are processed in several passes.
+  void prepare(const int maxChannels, const int maxSamplesPerBlock);
+
+  // Route every one of the first numChannels channels to itself.
+  void setIdentity(const int numChannels);
+
+  // Channel dest receives what channel source held, or silence for kClear.
+  void setSource(const int dest, const int source);
+
+  // Turn the routing into the sequence of copies applied by process().
+  void compile();
+
+  void process(juce::AudioBuffer<float>& buffer);
+
+  int getNumChannels() const { return numChannels_; }
+  int getMaxChannels() const { return (int)sources_.size(); }
+  bool isIdentity() const { return ops_.empty(); }
+
+ private:
+  // Index of the scratch channel in an Op.
+  static constexpr int kScratch = -2;
+
+  struct Op {
+    int dest;
+    int source;
+  };
+
+  void processRange(juce::AudioBuffer<float>& buffer, const int start,
+                    const int numSamples);
+
+  int numChannels_ = 0;
+  std::vector<int> sources_;
+  std::vector<Op> ops_;
+  // Working state for compile(), sized by prepare().
+  std::vector<int> pendingReaders_;
+  std::vector<char> pending_;
+  juce::AudioBuffer<float> scratch_;
+};
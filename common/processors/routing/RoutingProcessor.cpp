@@ -44,7 +44,9 @@ RoutingProcessor::~RoutingProcessor() {
 
 void RoutingProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
   juce::ignoreUnused(sampleRate);
-  copyBuffer_.setSize(totalChannelCount_, samplesPerBlock);
+  plan_.prepare(totalChannelCount_, samplesPerBlock);
+  plannedFirstChannel_ = -1;
+  plannedTotalChannels_ = -1;
 }
 
 void RoutingProcessor::initializeRouting() {
@@ -62,19 +64,27 @@ void RoutingProcessor::initializeRouting() {
 
 void RoutingProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                     juce::MidiBuffer& midiMessages) {
-  copyBuffer_.clear();
+  const int firstChannel = firstChannel_;
+  const int totalChannels = totalChannels_;
+  const int numChannels =
+      juce::jmin(buffer.getNumChannels(), plan_.getMaxChannels());
 
-  // Copy data from the input channels to copy buffer, shifting the
-  // audio forward by the first channel
-  for (int channel = 0; channel < totalChannels_; ++channel) {
-    if (channel + firstChannel_ <= buffer.getNumChannels()) {
-      copyBuffer_.copyFrom(channel + firstChannel_, 0, buffer, channel, 0,
-                           buffer.getNumSamples());
+  // Shift the element's channels forward by the first channel and silence
+  // every other channel
+  if (firstChannel != plannedFirstChannel_ ||
+      totalChannels != plannedTotalChannels_ ||
+      numChannels != plan_.getNumChannels()) {
+    plan_.setIdentity(numChannels);
+    for (int channel = 0; channel < numChannels; ++channel) {
+      const int source = channel - firstChannel;
+      plan_.setSource(channel, source >= 0 && source < totalChannels
+                                   ? source
+                                   : ChannelRoutingPlan::kClear);
     }
+    plan_.compile();
+    plannedFirstChannel_ = firstChannel;
+    plannedTotalChannels_ = totalChannels;
   }
 
-  // Now copy the data back to the original buffer
-  // We can't copy in place because JUCE doesn't let you copy between the same
-  // buffer
-  buffer.makeCopyOf(copyBuffer_);
+  plan_.process(buffer);
 }
\ No newline at end of file
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "../processor_base/ProcessorBase.h"
+#include "ChannelRoutingPlan.h"
 #include "data_repository/implementation/AudioElementRepository.h"
 #include "data_repository/implementation/AudioElementSpatialLayoutRepository.h"
 #include "data_structures/src/AudioElementPluginSyncClient.h"
@@ -84,7 +85,11 @@ class RoutingProcessor final : public ProcessorBase,
   std::atomic_int firstChannel_;
   std::atomic_int totalChannels_;
   const int totalChannelCount_;
-  juce::AudioBuffer<float> copyBuffer_;
+  // Shift compiled for the routing below, rebuilt on the audio thread when
+  // the element's channels change
+  ChannelRoutingPlan plan_;
+  int plannedFirstChannel_ = -1;
+  int plannedTotalChannels_ = -1;
 
   //==============================================================================
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RoutingProcessor)
@@ -37,18 +37,18 @@ SoundFieldProcessor::~SoundFieldProcessor() {
 
 void SoundFieldProcessor::prepareToPlay(double sampleRate,
                                         int samplesPerBlock) {
-  // if the decoder sample rate is different from the current sample rate,
-  // reinit
-  if (soundField_ &&
-      static_cast<int>(sampleRate) != soundField_->getDecoderSampleRate()) {
-    soundField_->reinitDecoder(static_cast<int>(sampleRate));
+  // if the analysis was configured for a different sample rate, reinit
+  if (soundField_ && sampleRate != soundField_->getHostSampleRate()) {
+    soundField_->prepare(sampleRate);
   }
 }
 
 void SoundFieldProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                        juce::MidiBuffer& midiMessages) {
-  if (soundField_) {
-    soundField_->processDecoder(buffer);
+  // The analysis only feeds the visualizers, so skip it while none are shown.
+  if (soundField_ && ambisonicsData_->consumers.isWatched()) {
+    // Analysis runs on the sound field's own thread.
+    soundField_->pushBlock(buffer);
   }
 }
 
@@ -61,7 +61,9 @@ void SoundFieldProcessor::valueTreePropertyChanged(
     // If the layout is an ambisonics layout, instantiate the soundfield
     // measurement implementation.
     if (pbLayout_.isAmbisonics()) {
-      soundField_ = std::make_unique<SoundField>(pbLayout_, *ambisonicsData_);
+      const double sampleRate = getSampleRate() > 0 ? getSampleRate() : 48e3;
+      soundField_ = std::make_unique<SoundField>(pbLayout_, *ambisonicsData_,
+                                                 sampleRate);
     } else {
       soundField_.reset();
     }
@@ -17,8 +17,9 @@
 #include "ambi_dec.h"
 
 SoundField::SoundField(const Speakers::AudioElementSpeakerLayout layout,
-                       AmbisonicsData& ambisonicsData)
-    : ambisonicsData_(ambisonicsData),
+                       AmbisonicsData& ambisonicsData, const double sampleRate)
+    : juce::Thread("SoundField analysis"),
+      ambisonicsData_(ambisonicsData),
       layout_(layout),
       inputData_(allocate2DArray(layout.getNumChannels())) {
   createDecoder();
@@ -41,9 +42,15 @@ SoundField::SoundField(const Speakers::AudioElementSpeakerLayout layout,
   ambisonicsData_.speakerLoudnesses.update(speakerLoudnesses);
   ambisonicsData_.speakerAzimuths = speakerAzimuths;
   ambisonicsData_.speakerElevations = speakerElevations;
+
+  speakerEnergies_.resize(numLoudSpeakers_, 0.0);
+  speakerLoudnesses_ = speakerLoudnesses;
+  prepare(sampleRate);
+  startThread();
 }
 
 SoundField::~SoundField() {
+  stopThread(1000);
   destroyDecoder();
   deallocate2DArray(inputData_, layout_.getNumChannels());
   deallocate2DArray(outputData_, numLoudSpeakers_);
@@ -78,42 +85,159 @@ void SoundField::reinitDecoder(const int& sampleRate) {
   ambi_dec_initCodec(phAmbi_);  // updates codec parameters
 }
 
-void SoundField::processDecoder(juce::AudioBuffer<float>& buffer) {
-  const float* const* readPointers = buffer.getArrayOfReadPointers();
+void SoundField::prepare(const double sampleRate) {
+  const std::lock_guard<std::mutex> lock(analysisLock_);
   const int numChannels = layout_.getNumChannels();
-  const int downSampleFactor = buffer.getNumSamples() / samplesPerBuffer_;
+  hostSampleRate_ = sampleRate;
+
+  // Decode at a reduced rate; the sound field display only needs the
+  // directional energy, not the full audio bandwidth.
+  decimationFactor_ = std::max(
+      1, (int)std::round(sampleRate / kTargetAnalysisSampleRate));
+  const double analysisSampleRate = sampleRate / decimationFactor_;
+  reinitDecoder((int)analysisSampleRate);
+
+  // Band-limit below the analysis Nyquist frequency so decimation does not
+  // alias high-frequency content into the decoded levels.
+  const auto coefficients =
+      juce::dsp::FilterDesign<float>::designFIRLowpassWindowMethod(
+          0.45 * analysisSampleRate, sampleRate, 16 * decimationFactor_,
+          juce::dsp::WindowingFunction<float>::hann);
+  const float* taps = coefficients->getRawCoefficients();
+  decimatorTaps_.assign(taps, taps + coefficients->getFilterOrder() + 1);
+  decimatorHistory_.setSize(numChannels, 2 * (int)decimatorTaps_.size());
+  decimatorHistory_.clear();
+  historyIndex_ = 0;
+  decimationPhase_ = 0;
+
+  frameFill_ = 0;
+  numDecodedFrames_ = 0;
+  std::fill(speakerEnergies_.begin(), speakerEnergies_.end(), 0.0);
+
+  // Hold up to half a second of audio between updates.
+  const int fifoSize = (int)(sampleRate / 2) + 1;
+  fifoBuffer_.setSize(numChannels, fifoSize);
+  fifo_.setTotalSize(fifoSize);
+  droppedBlocks_ = 0;
+}
+
+void SoundField::pushBlock(const juce::AudioBuffer<float>& buffer) {
+  const int numChannels = layout_.getNumChannels();
+  const int numSamples = buffer.getNumSamples();
   if (buffer.getNumChannels() < numChannels) {
     return;
   }
+  if (fifo_.getFreeSpace() < numSamples) {
+    droppedBlocks_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  int start1, size1, start2, size2;
+  fifo_.prepareToWrite(numSamples, start1, size1, start2, size2);
+  for (int i = 0; i < numChannels; ++i) {
+    fifoBuffer_.copyFrom(i, start1, buffer, i, 0, size1);
+    if (size2 > 0) {
+      fifoBuffer_.copyFrom(i, start2, buffer, i, size1, size2);
+    }
+  }
+  fifo_.finishedWrite(size1 + size2);
+}
+
+void SoundField::run() {
+  while (!threadShouldExit()) {
+    const float updateRateHz = std::max(0.1f, updateRateHz_.load());
+    wait((int)std::ceil(1000.f / updateRateHz));
+    if (threadShouldExit()) {
+      return;
+    }
+    analysePending();
+  }
+}
+
+void SoundField::analysePending() {
+  const std::lock_guard<std::mutex> lock(analysisLock_);
+
+  int start1, size1, start2, size2;
+  fifo_.prepareToRead(fifo_.getNumReady(), start1, size1, start2, size2);
+  decimateAndDecode(fifoBuffer_, start1, size1);
+  decimateAndDecode(fifoBuffer_, start2, size2);
+  fifo_.finishedRead(size1 + size2);
+
+  if (numDecodedFrames_ == 0) {
+    return;
+  }
+
+  // Mean level of each loudspeaker over every frame decoded since the last
+  // update, in dB.
+  const double numDecodedSamples =
+      (double)numDecodedFrames_ * samplesPerBuffer_;
+  for (int i = 0; i < numLoudSpeakers_; ++i) {
+    speakerLoudnesses_[i] =
+        10.f * std::log10(speakerEnergies_[i] / numDecodedSamples);
+    speakerEnergies_[i] = 0.0;
+  }
+  numDecodedFrames_ = 0;
+
+  // update real-time data struct
+  ambisonicsData_.speakerLoudnesses.update(speakerLoudnesses_);
+}
+
+void SoundField::decimateAndDecode(const juce::AudioBuffer<float>& buffer,
+                                   const int startSample,
+                                   const int numSamples) {
+  const int numChannels = layout_.getNumChannels();
+  const int numTaps = (int)decimatorTaps_.size();
+  const float* taps = decimatorTaps_.data();
+  const float* const* input = buffer.getArrayOfReadPointers();
+  float* const* history = decimatorHistory_.getArrayOfWritePointers();
+
+  for (int n = startSample; n < startSample + numSamples; ++n) {
+    for (int i = 0; i < numChannels; ++i) {
+      history[i][historyIndex_] = input[i][n];
+      history[i][historyIndex_ + numTaps] = input[i][n];
+    }
+    // The filter window is now history[historyIndex_, historyIndex_ + numTaps).
+    historyIndex_ = (historyIndex_ + 1) % numTaps;
 
-  for (int i = 0; i < numChannels; i++) {  // for each channel, take 128
-                                           // samples
-    // Attempt to get 128 samples from each channel for the STFT in
-    // ambi_dec_process.
-    for (int j = 0, k = 0; j < samplesPerBuffer_; ++j, k += downSampleFactor) {
-      // Downsample the input buffer to 128 samples.
-      inputData_[i][j] = readPointers[i][k];
+    if (++decimationPhase_ < decimationFactor_) {
+      continue;
+    }
+    decimationPhase_ = 0;
+
+    // Linear-phase taps are symmetric, so the window need not be reversed.
+    for (int i = 0; i < numChannels; ++i) {
+      const float* window = history[i] + historyIndex_;
+      float sample = 0.f;
+      for (int t = 0; t < numTaps; ++t) {
+        sample += taps[t] * window[t];
+      }
+      inputData_[i][frameFill_] = sample;
+    }
+
+    if (++frameFill_ == samplesPerBuffer_) {
+      decodeFrame();
+      frameFill_ = 0;
     }
   }
+}
+
+void SoundField::decodeFrame() {
   // decode the signal of k channels
   // writes the decoded signal to outputData_ which represents the virtual loud
   // speakers
-  ambi_dec_process(phAmbi_, inputData_, outputData_, numChannels,
+  ambi_dec_process(phAmbi_, inputData_, outputData_, layout_.getNumChannels(),
                    numLoudSpeakers_, samplesPerBuffer_);
-  std::vector<float> rmsValues(numLoudSpeakers_);
-  // calculate RMS for each loudspeaker
+
+  // accumulate the energy of each loudspeaker
   for (int i = 0; i < numLoudSpeakers_; i++) {
-    float sum = 0;
+    double sum = 0.0;
     for (int j = 0; j < samplesPerBuffer_; j++) {
       sum += outputData_[i][j] * outputData_[i][j];
     }
-    float rms = sqrt(sum / samplesPerBuffer_);
-    rmsValues[i] = 20.f * std::log10(rms);  // calulate in dB
+    speakerEnergies_[i] += sum;
   }
-
-  // update real-time data struct
-  ambisonicsData_.speakerLoudnesses.update(rmsValues);
-};
+  ++numDecodedFrames_;
+}
 
 float** SoundField::allocate2DArray(const int& rows) {
   float** array = new float*[rows];
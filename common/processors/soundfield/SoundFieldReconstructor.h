@@ -18,8 +18,12 @@
 
 #include <ambi_dec.h>  // SAF library
 #include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
 
 #include <Eigen/Dense>
+#include <atomic>
+#include <mutex>
 
 #include "data_structures/src/AmbisonicsData.h"
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
@@ -57,20 +61,52 @@ PROC_STATUS ambi_dec_getProcStatus(void* const hAmbi);
 }
 
 // The instance of this class is managed by the SoundFieldProcessor
-class SoundField {
+/**
+ * @brief Estimates the energy arriving from a sphere of virtual loudspeakers
+ * for an ambisonic sound field.
+ *
+ * The audio thread only copies HOA blocks into a lock-free FIFO with
+ * pushBlock(). A background thread drains the FIFO at the update rate,
+ * low-pass filters and decimates the signal to the analysis sample rate,
+ * decodes it with SAF's ambi_dec and publishes the per-speaker level to
+ * AmbisonicsData.
+ */
+class SoundField : private juce::Thread {
  public:
+  // Rate the HOA signal is decimated to before decoding.
+  static constexpr double kTargetAnalysisSampleRate = 12e3;
+  static constexpr float kDefaultUpdateRateHz = 30.f;
+
   SoundField(const Speakers::AudioElementSpeakerLayout layout,
-             AmbisonicsData& ambisonicsData);
+             AmbisonicsData& ambisonicsData, const double sampleRate = 48e3);
   ~SoundField();
 
+  /**
+   * @brief Configure for a host sample rate. Sizes the FIFO, redesigns the
+   * decimation filter and reinitialises the decoder at the analysis rate.
+   * Must not be called concurrently with pushBlock().
+   */
+  void prepare(const double sampleRate);
+
+  /**
+   * @brief Queue a block of HOA audio for analysis. Realtime safe; if the
+   * analysis thread falls behind the block is dropped.
+   */
+  void pushBlock(const juce::AudioBuffer<float>& buffer);
+
+  // How often speaker levels are recomputed and published.
+  void setUpdateRate(const float updateRateHz) { updateRateHz_ = updateRateHz; }
+
+  double getHostSampleRate() const { return hostSampleRate_; }
+
+  int getNumDroppedBlocks() const { return droppedBlocks_.load(); }
+
   void createDecoder();
 
   void reinitDecoder(const int& sampleRate = 48e3);
 
   void destroyDecoder() { ambi_dec_destroy(&phAmbi_); }
 
-  void processDecoder(juce::AudioBuffer<float>& buffer);
-
   int getDecoderSampleRate() const {
     return ambi_dec_getDAWsamplerate(phAmbi_);
   }
@@ -115,10 +151,49 @@ class SoundField {
   const int samplesPerBuffer_ = 128;  // STFT in decoder requires 128 samples
 
  private:
+  void run() override;
+
+  // Drain the FIFO, decimate and decode everything queued since the last
+  // update and publish the resulting speaker levels.
+  void analysePending();
+
+  // Decimate numSamples samples starting at startSample of the buffer into the
+  // decoder input frame, decoding every completed frame.
+  void decimateAndDecode(const juce::AudioBuffer<float>& buffer,
+                         const int startSample, const int numSamples);
+
+  void decodeFrame();
+
   const Speakers::AudioElementSpeakerLayout layout_;
   AmbisonicsData& ambisonicsData_;
   int numLoudSpeakers_;
   void* phAmbi_;        // decoder handle
   float** inputData_;   // input data
   float** outputData_;  // output data
+
+  // Guards the decoder and analysis state against reconfiguration while the
+  // analysis thread is running.
+  std::mutex analysisLock_;
+  double hostSampleRate_ = 0.0;
+  std::atomic<float> updateRateHz_{kDefaultUpdateRateHz};
+
+  // Single producer, single consumer FIFO from the audio thread.
+  juce::AbstractFifo fifo_{1};
+  juce::AudioBuffer<float> fifoBuffer_;
+  std::atomic<int> droppedBlocks_{0};
+
+  // Decimating low-pass FIR, evaluated only at the retained samples. History
+  // is stored twice so the filter window is always contiguous.
+  int decimationFactor_ = 1;
+  int decimationPhase_ = 0;
+  std::vector<float> decimatorTaps_;
+  juce::AudioBuffer<float> decimatorHistory_;
+  int historyIndex_ = 0;
+
+  // Decoder frame being filled and the speaker energy accumulated since the
+  // last update.
+  int frameFill_ = 0;
+  int numDecodedFrames_ = 0;
+  std::vector<double> speakerEnergies_;
+  std::vector<float> speakerLoudnesses_;
 };
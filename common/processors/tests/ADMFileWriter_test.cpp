@@ -0,0 +1,138 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+#include "FileOutputTestFixture.h"
+#include "substream_rdr/substream_rdr_utils/Speakers.h"
+
+namespace {
+uint32_t readLE32(const char* data) {
+  uint32_t value = 0;
+  for (int i = 3; i >= 0; --i) {
+    value = (value << 8) | (uint8_t)data[i];
+  }
+  return value;
+}
+
+// Read every top level chunk of a RIFF file, keyed by chunk ID. The data
+// chunk is recorded by size only.
+std::map<std::string, std::string> readChunks(const std::filesystem::path& path,
+                                              uint32_t& dataSize) {
+  std::ifstream file(path, std::ios::binary);
+  char header[12];
+  file.read(header, 12);
+  EXPECT_EQ(std::string(header, 4), "RIFF");
+  EXPECT_EQ(readLE32(header + 4), std::filesystem::file_size(path) - 8);
+  EXPECT_EQ(std::string(header + 8, 4), "WAVE");
+
+  std::map<std::string, std::string> chunks;
+  char chunkHeader[8];
+  while (file.read(chunkHeader, 8)) {
+    const std::string kId(chunkHeader, 4);
+    const uint32_t kSize = readLE32(chunkHeader + 4);
+    if (kId == "data") {
+      dataSize = kSize;
+      file.seekg(kSize + kSize % 2, std::ios::cur);
+      continue;
+    }
+    std::string data(kSize, '\0');
+    file.read(data.data(), kSize);
+    file.seekg(kSize % 2, std::ios::cur);
+    chunks[kId] = data;
+  }
+  return chunks;
+}
+}  // namespace
+
+TEST_F(FileOutputTests, adm_bwf_bed_and_hoa) {
+  const juce::Uuid kBed = addAudioElement(Speakers::k5Point1, "Bed");
+  const juce::Uuid kHoa = addAudioElement(Speakers::kHOA1, "Ambience",
+                                          Speakers::k5Point1.getNumChannels());
+  const juce::Uuid kMP = addMixPresentation("Main");
+  addAudioElementsToMix(kMP, {kBed, kHoa});
+
+  const std::filesystem::path kAdmPath =
+      std::filesystem::current_path() / "test_adm.wav";
+  FileExport config = fileExportRepository.get();
+  config.setAudioFileFormat(AudioFileFormat::ADM);
+  config.setExportFile(kAdmPath.string());
+  config.setBitDepth(24);
+  fileExportRepository.update(config);
+
+  bounceAudio(fio_proc, audioElementRepository, kSampleRate, kSamplesPerFrame);
+  ASSERT_TRUE(std::filesystem::exists(kAdmPath));
+
+  uint32_t dataSize = 0;
+  const auto kChunks = readChunks(kAdmPath, dataSize);
+  const int kNumChannels = 10;
+  // bounceAudio renders 8 blocks
+  EXPECT_EQ(dataSize, 8 * kSamplesPerFrame * kNumChannels * 3);
+
+  ASSERT_EQ(kChunks.count("fmt "), 1);
+  const std::string& fmt = kChunks.at("fmt ");
+  EXPECT_EQ((uint8_t)fmt[2], kNumChannels);
+  EXPECT_EQ((uint8_t)fmt[14], 24);
+
+  // One chna entry per track, referencing the pack of its audio element
+  ASSERT_EQ(kChunks.count("chna"), 1);
+  const std::string& chna = kChunks.at("chna");
+  ASSERT_EQ(chna.size(), 4 + 40 * kNumChannels);
+  EXPECT_EQ((uint8_t)chna[0], kNumChannels);
+  EXPECT_EQ(chna.substr(4 + 2, 12), "ATU_00000001");
+  EXPECT_EQ(chna.substr(4 + 28, 11), "AP_00011001");
+  EXPECT_EQ(chna.substr(4 + 40 * 6 + 28, 11), "AP_00041002");
+
+  ASSERT_EQ(kChunks.count("axml"), 1);
+  auto axml = juce::parseXML(kChunks.at("axml"));
+  ASSERT_NE(axml, nullptr);
+  auto* adm = axml->getChildByName("coreMetadata")
+                  ->getChildByName("format")
+                  ->getChildByName("audioFormatExtended");
+  ASSERT_NE(adm, nullptr);
+
+  std::map<juce::String, int> counts;
+  for (auto* element : adm->getChildIterator()) {
+    ++counts[element->getTagName()];
+  }
+  EXPECT_EQ(counts["audioProgramme"], 1);
+  EXPECT_EQ(counts["audioContent"], 2);
+  EXPECT_EQ(counts["audioObject"], 2);
+  EXPECT_EQ(counts["audioPackFormat"], 2);
+  EXPECT_EQ(counts["audioChannelFormat"], kNumChannels);
+  EXPECT_EQ(counts["audioTrackUID"], kNumChannels);
+
+  // Programmes come first and reference both audio elements
+  auto* programme = adm->getFirstChildElement();
+  EXPECT_EQ(programme->getTagName(), "audioProgramme");
+  EXPECT_EQ(programme->getStringAttribute("audioProgrammeName"), "Main");
+  EXPECT_EQ(programme->getNumChildElements(), 2);
+
+  // Bed channels carry positions, HOA channels their order and degree
+  for (auto* channel : adm->getChildWithTagNameIterator("audioChannelFormat")) {
+    auto* block = channel->getChildByName("audioBlockFormat");
+    if (channel->getStringAttribute("typeDefinition") == "HOA") {
+      EXPECT_NE(block->getChildByName("order"), nullptr);
+      EXPECT_NE(block->getChildByName("degree"), nullptr);
+    } else {
+      EXPECT_NE(block->getChildByName("speakerLabel"), nullptr);
+      EXPECT_NE(block->getChildByName("position"), nullptr);
+    }
+  }
+}
@@ -0,0 +1,95 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../file_output/AsyncWavFileWriter.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+// Read the samples of the data chunk of a 32-bit float WAV file.
+std::vector<float> readFloatData(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  file.seekg(12);
+  char chunkHeader[8];
+  while (file.read(chunkHeader, 8)) {
+    uint32_t size;
+    std::memcpy(&size, chunkHeader + 4, 4);
+    if (std::string(chunkHeader, 4) == "data") {
+      std::vector<float> samples(size / sizeof(float));
+      file.read((char*)samples.data(), size);
+      return samples;
+    }
+    file.seekg(size + size % 2, std::ios::cur);
+  }
+  return {};
+}
+}  // namespace
+
+TEST(test_async_wav_writer, writes_every_block) {
+  const std::filesystem::path kPath =
+      std::filesystem::current_path() / "async_wav_writer_test.wav";
+  // Several times the queue, so writes wrap around it and wait for room
+  const int kChannels = 3, kSampleRate = 8000, kBlockSize = 500;
+  const int kNumBlocks =
+      4 * AsyncWavFileWriter::kQueueSeconds * kSampleRate / kBlockSize;
+
+  AsyncWavFileWriter writer(kChannels, kSampleRate, 32);
+  ASSERT_TRUE(writer.open(kPath.string()));
+  juce::AudioBuffer<float> block(kChannels, kBlockSize);
+  for (int b = 0; b < kNumBlocks; ++b) {
+    for (int ch = 0; ch < kChannels; ++ch) {
+      for (int i = 0; i < kBlockSize; ++i) {
+        block.setSample(ch, i, (float)(ch * 1000000 + b * kBlockSize + i));
+      }
+    }
+    ASSERT_TRUE(writer.write(block, true));
+  }
+  ASSERT_TRUE(writer.close());
+  EXPECT_EQ(writer.getDroppedSamples(), 0);
+
+  const std::vector<float> kSamples = readFloatData(kPath);
+  ASSERT_EQ(kSamples.size(), (size_t)kChannels * kBlockSize * kNumBlocks);
+  for (size_t frame = 0; frame < kSamples.size() / kChannels; ++frame) {
+    for (int ch = 0; ch < kChannels; ++ch) {
+      ASSERT_EQ(kSamples[frame * kChannels + ch],
+                (float)(ch * 1000000 + frame))
+          << "channel " << ch << " frame " << frame;
+    }
+  }
+  std::filesystem::remove(kPath);
+}
+
+TEST(test_async_wav_writer, counts_dropped_blocks) {
+  const std::filesystem::path kPath =
+      std::filesystem::current_path() / "async_wav_writer_drop_test.wav";
+  const int kSampleRate = 100;
+  AsyncWavFileWriter writer(1, kSampleRate, 16);
+  ASSERT_TRUE(writer.open(kPath.string()));
+
+  // Larger than the whole queue, so it can never be written
+  juce::AudioBuffer<float> block(
+      1, AsyncWavFileWriter::kQueueSeconds * kSampleRate + 1);
+  block.clear();
+  EXPECT_FALSE(writer.write(block, false));
+  EXPECT_FALSE(writer.write(block, true));
+  EXPECT_EQ(writer.getDroppedSamples(), 2 * block.getNumSamples());
+
+  EXPECT_TRUE(writer.close());
+  std::filesystem::remove(kPath);
+}
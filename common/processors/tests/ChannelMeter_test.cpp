@@ -0,0 +1,92 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../metering/ChannelMeter.h"
+
+#include <gtest/gtest.h>
+
+#include "../metering/MeteringProcessor.h"
+
+TEST(test_channel_meter, matches_buffer_levels) {
+  // Use an odd sample count to exercise the non-vectorised tail.
+  const int kNumChannels = 6;
+  const int kNumSamples = 131;
+  juce::AudioBuffer<float> buffer(kNumChannels, kNumSamples);
+  juce::Random rng(1234);
+  for (int ch = 0; ch < kNumChannels; ++ch) {
+    for (int i = 0; i < kNumSamples; ++i) {
+      buffer.setSample(ch, i, (rng.nextFloat() * 2.f - 1.f) / (ch + 1));
+    }
+  }
+
+  ChannelMeter meter;
+  meter.process(buffer);
+
+  ASSERT_EQ(meter.getNumChannels(), kNumChannels);
+  ASSERT_EQ(meter.getNumSamples(), kNumSamples);
+  for (int ch = 0; ch < kNumChannels; ++ch) {
+    EXPECT_NEAR(meter.getPeak(ch), buffer.getMagnitude(ch, 0, kNumSamples),
+                1e-6f);
+    EXPECT_NEAR(meter.getRMS(ch), buffer.getRMSLevel(ch, 0, kNumSamples),
+                1e-5f);
+    EXPECT_NEAR(
+        meter.getRMSdB(ch),
+        20.f * std::log10(buffer.getRMSLevel(ch, 0, kNumSamples)), 1e-3f);
+  }
+  EXPECT_NEAR(meter.getMaxPeak(), buffer.getMagnitude(0, kNumSamples), 1e-6f);
+}
+
+TEST(test_channel_meter, limits_channels_and_refreshes_cache) {
+  juce::AudioBuffer<float> buffer(4, 64);
+  buffer.clear();
+  for (int i = 0; i < 64; ++i) {
+    buffer.setSample(0, i, 0.5f);
+    buffer.setSample(3, i, 1.f);
+  }
+
+  ChannelMeter meter(4);
+  meter.process(buffer, 2);
+  ASSERT_EQ(meter.getNumChannels(), 2);
+  EXPECT_NEAR(meter.getRMSdB(0), -6.02f, 0.01f);
+  EXPECT_EQ(meter.getRMSdB(1), -std::numeric_limits<float>::infinity());
+  // Channels beyond the metered range read as silence.
+  EXPECT_EQ(meter.getPeak(3), 0.f);
+  EXPECT_EQ(meter.getMaxPeak(), 0.5f);
+
+  // A new block must invalidate previously converted dB values.
+  buffer.applyGain(0.5f);
+  meter.process(buffer, 2);
+  EXPECT_NEAR(meter.getRMSdB(0), -12.04f, 0.01f);
+}
+
+TEST(test_channel_meter, processor_publishes_shared_levels) {
+  ChannelMeter sharedMeter;
+  MeteringProcessor metering(sharedMeter, 1);
+  ChannelMeterSource consumer(&sharedMeter);
+
+  juce::AudioBuffer<float> buffer(2, 32);
+  for (int i = 0; i < 32; ++i) {
+    buffer.setSample(0, i, 0.25f);
+    buffer.setSample(1, i, 1.f);
+  }
+  juce::MidiBuffer midi;
+  metering.prepareToPlay(48e3, 32);
+  metering.processBlock(buffer, midi);
+
+  // The consumer reads the published levels rather than re-metering.
+  const ChannelMeter& levels = consumer.measure(buffer);
+  EXPECT_EQ(&levels, &sharedMeter);
+  EXPECT_EQ(levels.getNumChannels(), 1);
+  EXPECT_FLOAT_EQ(levels.getPeak(0), 0.25f);
+}
@@ -0,0 +1,83 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../routing/ChannelRoutingPlan.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+// Fill each channel with its own index plus one, so silence is distinct.
+void fillWithChannelNumbers(juce::AudioBuffer<float>& buffer) {
+  for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+    for (int i = 0; i < buffer.getNumSamples(); ++i) {
+      buffer.setSample(ch, i, (float)(ch + 1));
+    }
+  }
+}
+
+// Apply sources with the plan and compare against copying out of a
+// separate buffer.
+void expectRouted(const std::vector<int>& sources, const int numSamples,
+                  const int maxSamplesPerBlock) {
+  const int numChannels = (int)sources.size();
+  ChannelRoutingPlan plan;
+  plan.prepare(numChannels, maxSamplesPerBlock);
+  for (int ch = 0; ch < numChannels; ++ch) {
+    plan.setSource(ch, sources[ch]);
+  }
+  plan.compile();
+
+  juce::AudioBuffer<float> buffer(numChannels, numSamples);
+  fillWithChannelNumbers(buffer);
+  plan.process(buffer);
+
+  for (int ch = 0; ch < numChannels; ++ch) {
+    const float expected =
+        sources[ch] == ChannelRoutingPlan::kClear ? 0.f : sources[ch] + 1.f;
+    for (int i = 0; i < numSamples; ++i) {
+      ASSERT_EQ(buffer.getSample(ch, i), expected)
+          << "channel " << ch << " sample " << i;
+    }
+  }
+}
+}  // namespace
+
+TEST(test_channel_routing_plan, identity_is_free) {
+  ChannelRoutingPlan plan;
+  plan.prepare(12, 64);
+  plan.compile();
+  EXPECT_TRUE(plan.isIdentity());
+  expectRouted({0, 1, 2, 3}, 64, 64);
+}
+
+TEST(test_channel_routing_plan, shift_clears_vacated_channels) {
+  // An element on channels 0-1 routed to channels 2-3 of six
+  const int k = ChannelRoutingPlan::kClear;
+  expectRouted({k, k, 0, 1, k, k}, 32, 32);
+  // And back down
+  expectRouted({2, 3, k, k, k, k}, 32, 32);
+}
+
+TEST(test_channel_routing_plan, rotates_cycles) {
+  // The 7.1.4 Pro Tools to ITU remap, two three-channel cycles
+  expectRouted({0, 1, 2, 3, 4, 5, 10, 11, 6, 7, 8, 9}, 16, 16);
+  // A swap next to a chain
+  expectRouted({1, 0, 2, 2, 3}, 16, 16);
+}
+
+TEST(test_channel_routing_plan, long_blocks_use_several_passes) {
+  expectRouted({3, 0, 1, 2}, 100, 32);
+}
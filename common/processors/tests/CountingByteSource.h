@@ -0,0 +1,40 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "processors/file_output/iamf_export_utils/IAMFByteSource.h"
+
+// Counts the bytes read out of an in-memory source. The count is atomic as
+// prefetching sources read from a background thread.
+class CountingByteSource : public MemoryByteSource {
+ public:
+  CountingByteSource(std::vector<uint8_t> bytes,
+                     std::atomic<uint64_t>& bytesRead)
+      : MemoryByteSource(std::move(bytes)), bytesRead_(bytesRead) {}
+
+  std::span<const uint8_t> read(const size_t maxBytes) override {
+    const std::span<const uint8_t> kBytes = MemoryByteSource::read(maxBytes);
+    bytesRead_ += kBytes.size();
+    return kBytes;
+  }
+
+ private:
+  std::atomic<uint64_t>& bytesRead_;
+};
@@ -0,0 +1,86 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../file_output/ExportStats.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+
+#include "data_repository/implementation/FileExportRepository.h"
+
+using namespace std::chrono_literals;
+
+TEST(test_export_stats, shared_by_repository) {
+  FileExportRepository repository(juce::ValueTree("file_export"));
+  FileExportRepository otherRepository(juce::ValueTree("file_export"));
+  const auto kStats = ExportStats::forExport(repository);
+  EXPECT_EQ(ExportStats::forExport(repository), kStats);
+  EXPECT_NE(ExportStats::forExport(otherRepository), kStats);
+
+  // Loading a project replaces the repository's state tree
+  repository.setStateTree(juce::ValueTree("file_export"));
+  EXPECT_EQ(ExportStats::forExport(repository), kStats);
+}
+
+TEST(test_export_stats, throughput_by_stage) {
+  ExportStats stats;
+  stats.beginRender(1000);
+  stats.addRenderedFrames(2000);
+  stats.record(ExportStats::kEncode, 100ms, 2000, 500);
+  stats.record(ExportStats::kLoudness, 40ms, 1000, 0);
+  stats.record(ExportStats::kLoudness, 60ms, 1000, 0);
+  stats.recordQueueDepth(3);
+  stats.recordQueueDepth(1);
+  stats.endRender();
+
+  const juce::var kStats = stats.toVar();
+  EXPECT_EQ((int)kStats["max_queue_depth"], 3);
+  EXPECT_DOUBLE_EQ((double)kStats["audio_seconds"], 2.0);
+  const juce::var& kEncode = kStats["stages"]["encode"];
+  EXPECT_EQ((int)kEncode["frames"], 2000);
+  EXPECT_EQ((int)kEncode["bytes"], 500);
+  EXPECT_NEAR((double)kEncode["realtime_factor"], 20.0, 1e-6);
+  EXPECT_NEAR((double)kEncode["bytes_per_second"], 5000.0, 1e-6);
+  const juce::var& kLoudness = kStats["stages"]["loudness"];
+  EXPECT_EQ((int)kLoudness["calls"], 2);
+  EXPECT_NEAR((double)kLoudness["frames_per_second"], 20000.0, 1e-6);
+
+  EXPECT_TRUE(stats.getSummary().contains("encode 20x"));
+  EXPECT_TRUE(stats.getSummary().contains("loudness 20x"));
+}
+
+TEST(test_export_stats, begin_render_clears_stats) {
+  ExportStats stats;
+  stats.beginRender(1000);
+  stats.record(ExportStats::kMux, 1s, 0, 100);
+  stats.beginRender(1000);
+  const juce::var kStats = stats.toVar();
+  EXPECT_EQ((int)kStats["stages"]["mux"]["calls"], 0);
+  EXPECT_EQ((int)kStats["stages"]["mux"]["bytes"], 0);
+}
+
+TEST(test_export_stats, report_next_to_export) {
+  const std::filesystem::path kExportPath =
+      std::filesystem::current_path() / "export_stats_test.iamf";
+  const juce::File kReport =
+      ExportStats::getReportFile(juce::String(kExportPath.string()));
+  ExportStats stats;
+  stats.beginRender(48000);
+  stats.endRender();
+  ASSERT_TRUE(stats.writeReport(kReport));
+  EXPECT_TRUE(kReport.existsAsFile());
+  std::filesystem::remove(kReport.getFullPathName().toStdString());
+}
@@ -0,0 +1,104 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../file_output/FileExportJobQueue.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+namespace {
+// Job that waits for release or cancellation, so tests control when it ends.
+FileExportJobQueue::Job blockingJob(std::atomic_bool& started,
+                                    std::atomic_bool& release) {
+  return [&](const std::atomic_bool& cancelled) {
+    started = true;
+    while (!release && !cancelled) {
+      std::this_thread::yield();
+    }
+    return !cancelled.load();
+  };
+}
+}  // namespace
+
+TEST(test_file_export_job_queue, runs_jobs_in_order) {
+  FileExportJobQueue queue;
+  const juce::ValueTree kOwner("export");
+  std::vector<int> order;
+  std::vector<bool> results;
+  for (int i = 0; i < 3; ++i) {
+    queue.enqueue(
+        kOwner,
+        [&order, i](const std::atomic_bool&) {
+          order.push_back(i);
+          return i != 1;
+        },
+        [&results](bool succeeded, bool cancelled) {
+          EXPECT_FALSE(cancelled);
+          results.push_back(succeeded);
+        });
+  }
+  queue.waitUntilIdle();
+
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+  EXPECT_EQ(results, (std::vector<bool>{true, false, true}));
+  EXPECT_FALSE(queue.hasJobs(kOwner));
+}
+
+TEST(test_file_export_job_queue, cancel_stops_only_the_owners_jobs) {
+  FileExportJobQueue queue;
+  const juce::ValueTree kOwner("export");
+  const juce::ValueTree kOther("export");
+  std::atomic_bool started = false, release = false;
+  std::atomic_int cancelledJobs = 0, completedJobs = 0;
+  auto count = [&](bool, bool cancelled) {
+    ++(cancelled ? cancelledJobs : completedJobs);
+  };
+
+  queue.enqueue(kOwner, blockingJob(started, release), count);
+  queue.enqueue(
+      kOwner, [](const std::atomic_bool&) { return true; }, count);
+  queue.enqueue(
+      kOther, [](const std::atomic_bool&) { return true; }, count);
+  while (!started) {
+    std::this_thread::yield();
+  }
+  EXPECT_TRUE(queue.hasJobs(kOwner));
+
+  // Returns only once the running job has given up
+  queue.cancel(kOwner);
+  EXPECT_FALSE(release);
+  queue.waitUntilIdle();
+
+  EXPECT_EQ(cancelledJobs, 2);
+  EXPECT_EQ(completedJobs, 1);
+}
+
+TEST(test_file_export_job_queue, destruction_cancels_pending_jobs) {
+  std::atomic_bool started = false, release = false;
+  std::atomic_int cancelledJobs = 0;
+  {
+    FileExportJobQueue queue;
+    const juce::ValueTree kOwner("export");
+    auto count = [&](bool, bool cancelled) { cancelledJobs += cancelled; };
+    queue.enqueue(kOwner, blockingJob(started, release), count);
+    queue.enqueue(
+        kOwner, [](const std::atomic_bool&) { return true; }, count);
+    while (!started) {
+      std::this_thread::yield();
+    }
+  }
+  EXPECT_EQ(cancelledJobs, 2);
+}
@@ -15,7 +15,9 @@
 #include <gtest/gtest.h>
 
 #include <filesystem>
+#include <memory>
 
+#include "../file_output/iamf_export_utils/IAMFFileReader.h"
 #include "FileOutputTestFixture.h"
 #include "juce_cryptography/juce_cryptography.h"
 #include "processors/tests/FileOutputTestUtils.h"
@@ -364,6 +366,142 @@ TEST_F(FileOutputTests, iamf_flac_custom_param) {
   }
 }
 
+TEST_F(FileOutputTests, iamf_audio_element_files) {
+  const juce::Uuid kAE1 = addAudioElement(Speakers::kStereo);
+  const juce::Uuid kAE2 = addAudioElement(Speakers::k5Point1, "AE2", 2);
+  const juce::Uuid kMP = addMixPresentation();
+  addAudioElementsToMix(kMP, {kAE1, kAE2});
+
+  const auto stemPath = [&](const int index, const std::string& extension) {
+    return std::filesystem::path(iamfOutPath.string() + "_audio_element_ " +
+                                 std::to_string(index) + extension);
+  };
+
+  // Not written unless asked for
+  setTestExportOpts({.codec = AudioCodec::LPCM});
+  bounceAudio(fio_proc, audioElementRepository);
+  ASSERT_TRUE(std::filesystem::exists(iamfOutPath));
+  EXPECT_FALSE(std::filesystem::exists(stemPath(0, ".wav")));
+  EXPECT_FALSE(std::filesystem::exists(stemPath(1, ".wav")));
+  std::filesystem::remove(iamfOutPath);
+
+  // Written in full through the background writer
+  ex.setExportAudioElements(true);
+  fileExportRepository.update(ex);
+  bounceAudio(fio_proc, audioElementRepository);
+  for (const int index : {0, 1}) {
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatReader> reader(format.createReaderFor(
+        new juce::FileInputStream(juce::File(stemPath(index, ".wav").string())),
+        true));
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->numChannels, index == 0 ? 2 : 6);
+    EXPECT_GT(reader->lengthInSamples, 0);
+  }
+  std::filesystem::remove(iamfOutPath);
+
+  // Following the FLAC codec
+  setTestExportOpts({.codec = AudioCodec::FLAC});
+  bounceAudio(fio_proc, audioElementRepository);
+  EXPECT_TRUE(std::filesystem::exists(stemPath(0, ".flac")));
+  EXPECT_TRUE(std::filesystem::exists(stemPath(1, ".flac")));
+}
+
+TEST_F(FileOutputTests, iamf_export_stats_report) {
+  const juce::Uuid kAE = addAudioElement(Speakers::kStereo);
+  const juce::Uuid kMP = addMixPresentation();
+  addAudioElementsToMix(kMP, {kAE});
+  setTestExportOpts({.codec = AudioCodec::LPCM});
+
+  bounceAudio(fio_proc, audioElementRepository, 48e3, 128);
+
+  const juce::File kReport =
+      ExportStats::getReportFile(juce::String(iamfOutPath.string()));
+  ASSERT_TRUE(kReport.existsAsFile());
+  const juce::var kStats = juce::JSON::parse(kReport);
+  EXPECT_EQ((int)kStats["sample_rate"], 48000);
+  EXPECT_EQ((int)kStats["render"]["frames"], 8 * 128);
+  EXPECT_EQ((int)kStats["stages"]["encode"]["frames"], 8 * 128);
+  EXPECT_GT((int)kStats["stages"]["encode"]["bytes"], 0);
+  EXPECT_GT((double)kStats["render"]["realtime_factor"], 0.0);
+  EXPECT_TRUE(
+      fileExportRepository.get().getExportSummary().contains("realtime"));
+}
+
+// Loading a project replaces the export's state tree after the processors
+// are built. The encoder must still record into the stats that are reported.
+TEST_F(FileOutputTests, iamf_export_stats_after_state_load) {
+  const juce::Uuid kAE = addAudioElement(Speakers::kStereo);
+  const juce::Uuid kMP = addMixPresentation();
+  addAudioElementsToMix(kMP, {kAE});
+  setTestExportOpts({.codec = AudioCodec::LPCM});
+  fileExportRepository.setStateTree(
+      fileExportRepository.getTree().createCopy());
+
+  bounceAudio(fio_proc, audioElementRepository, 48e3, 128);
+
+  const juce::File kReport =
+      ExportStats::getReportFile(juce::String(iamfOutPath.string()));
+  ASSERT_TRUE(kReport.existsAsFile());
+  const juce::var kStats = juce::JSON::parse(kReport);
+  EXPECT_EQ((int)kStats["stages"]["encode"]["frames"], 8 * 128);
+  EXPECT_GT((int)kStats["stages"]["encode"]["bytes"], 0);
+}
+
+TEST_F(FileOutputTests, iamf_incremental_export) {
+  const juce::Uuid kAE = addAudioElement(Speakers::kStereo);
+  const juce::Uuid kMP = addMixPresentation();
+  addAudioElementsToMix(kMP, {kAE});
+
+  // Three seconds of a constant level, each second 125 frames
+  const auto render = [&](const float level) {
+    fio_proc.prepareToPlay(kSampleRate, kSamplesPerFrame);
+    fio_proc.setNonRealtime(true);
+    juce::AudioBuffer<float> buffer(2, kSamplesPerFrame);
+    juce::MidiBuffer midi;
+    for (int block = 0; block < 3 * kSampleRate / kSamplesPerFrame; ++block) {
+      for (int ch = 0; ch < 2; ++ch) {
+        juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), level,
+                                          kSamplesPerFrame);
+      }
+      fio_proc.processBlock(buffer, midi);
+    }
+    fio_proc.setNonRealtime(false);
+    FileExportJobQueue::getInstance().waitUntilIdle();
+  };
+
+  // Both codecs whose frames decode independently can be spliced
+  for (const AudioCodec codec : {AudioCodec::LPCM, AudioCodec::FLAC}) {
+    SCOPED_TRACE(static_cast<int>(codec));
+    ex.setIncrementalExport(false);
+    setTestExportOpts({.codec = codec});
+    std::filesystem::remove(iamfOutPath);
+    render(0.25f);
+
+    // Only the frames overlapping 1.5s to 1.75s, 187 through 218, are encoded
+    // again
+    ex.setIncrementalExport(true);
+    ex.setDirtyStartTime(1.5);
+    ex.setDirtyEndTime(1.75);
+    fileExportRepository.update(ex);
+    render(0.5f);
+    EXPECT_TRUE(fileExportRepository.get().getExportCompleted());
+    EXPECT_FALSE(
+        std::filesystem::exists(iamfOutPath.string() + ".patch.iamf"));
+
+    auto reader = IAMFFileReader::createIamfReader(iamfOutPath);
+    ASSERT_NE(reader, nullptr);
+    const IAMFFileReader::StreamData kData = reader->getStreamData();
+    ASSERT_EQ(kData.numFrames, 375u);
+    juce::AudioBuffer<float> frame(kData.numChannels, kData.frameSize);
+    for (int i = 0; i < 375; ++i) {
+      ASSERT_GT(reader->readFrame(frame), 0u);
+      const float kExpected = i >= 187 && i <= 218 ? 0.5f : 0.25f;
+      ASSERT_NEAR(frame.getSample(0, 0), kExpected, 1e-3f) << "frame " << i;
+    }
+  }
+}
+
 TEST_F(FileOutputTests, validate_file_checksum) {
   const juce::Uuid kAE = addAudioElement(Speakers::kStereo);
   const juce::Uuid kMP = addMixPresentation();
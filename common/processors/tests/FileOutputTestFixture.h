@@ -146,6 +146,7 @@ class FileOutputTests : public ::testing::Test {
 
     // Clean up
     fio_proc.setNonRealtime(false);
+    FileExportJobQueue::getInstance().waitUntilIdle();
   }
 
   void createIAMFFile30SecStereo(const std::filesystem::path& path) {
@@ -197,6 +198,7 @@ class FileOutputTests : public ::testing::Test {
 
     // Clean up
     fio_proc.setNonRealtime(false);
+    FileExportJobQueue::getInstance().waitUntilIdle();
   }
 
  protected:
@@ -225,10 +227,12 @@ class FileOutputTests : public ::testing::Test {
   }
 
   ~FileOutputTests() override {
-    // Clean up produced .wav, .iamf, .mp4, and log files
+    // Clean up produced .wav, .flac, .iamf, .mp4, stats and log files
     for (const auto& entry :
          std::filesystem::directory_iterator(std::filesystem::current_path())) {
       if (entry.path().extension() == ".wav" ||
+          entry.path().extension() == ".flac" ||
+          entry.path().extension() == ".json" ||
           entry.path().extension() == ".mp4") {
         std::filesystem::remove(entry.path());
       }
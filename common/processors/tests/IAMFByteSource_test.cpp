@@ -0,0 +1,107 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../file_output/iamf_export_utils/IAMFByteSource.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace {
+const std::filesystem::path kSourceFile =
+    std::filesystem::current_path() / "test_byte_source.bin";
+
+std::vector<uint8_t> makeBytes(const size_t count) {
+  std::vector<uint8_t> bytes(count);
+  for (size_t i = 0; i < count; ++i) {
+    bytes[i] = (uint8_t)(i * 7 + 3);
+  }
+  return bytes;
+}
+
+void writeFile(const std::vector<uint8_t>& bytes) {
+  std::ofstream file(kSourceFile, std::ios::binary | std::ios::trunc);
+  file.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+}
+
+// Read the whole source in chunks, check the bytes, then seek back into the
+// middle and read to the end again.
+void expectReadsBack(IAMFByteSource& source,
+                     const std::vector<uint8_t>& expected) {
+  ASSERT_EQ(source.getSize(), expected.size());
+  std::vector<uint8_t> read;
+  for (std::span<const uint8_t> chunk = source.read(1000); !chunk.empty();
+       chunk = source.read(1000)) {
+    EXPECT_LE(chunk.size(), 1000u);
+    read.insert(read.end(), chunk.begin(), chunk.end());
+  }
+  EXPECT_EQ(read, expected);
+  EXPECT_EQ(source.getPosition(), expected.size());
+
+  const uint64_t kMiddle = expected.size() / 2;
+  ASSERT_TRUE(source.seek(kMiddle));
+  source.willReadSequentially();
+  const std::span<const uint8_t> kRest = source.read(expected.size());
+  ASSERT_EQ(kRest.size(), expected.size() - kMiddle);
+  EXPECT_TRUE(std::equal(kRest.begin(), kRest.end(),
+                         expected.begin() + kMiddle));
+  EXPECT_TRUE(source.read(1).empty());
+  EXPECT_FALSE(source.seek(expected.size() + 1));
+}
+}  // namespace
+
+TEST(test_iamf_byte_source, memory) {
+  const std::vector<uint8_t> kBytes = makeBytes(10000);
+  MemoryByteSource source(kBytes);
+  expectReadsBack(source, kBytes);
+}
+
+TEST(test_iamf_byte_source, mapped_file) {
+  const std::vector<uint8_t> kBytes = makeBytes(100000);
+  writeFile(kBytes);
+  {
+    auto source = MappedFileByteSource::open(kSourceFile);
+    ASSERT_NE(source, nullptr);
+    expectReadsBack(*source, kBytes);
+  }
+  std::filesystem::remove(kSourceFile);
+}
+
+TEST(test_iamf_byte_source, stream) {
+  const std::vector<uint8_t> kBytes = makeBytes(10000);
+  writeFile(kBytes);
+  {
+    StreamByteSource source(kSourceFile);
+    ASSERT_TRUE(source.isOpen());
+    expectReadsBack(source, kBytes);
+  }
+  std::filesystem::remove(kSourceFile);
+}
+
+TEST(test_iamf_byte_source, open_falls_back_for_empty_files) {
+  writeFile({});
+  EXPECT_EQ(MappedFileByteSource::open(kSourceFile), nullptr);
+  auto source = IAMFByteSource::open(kSourceFile);
+  ASSERT_NE(source, nullptr);
+  EXPECT_EQ(source->getSize(), 0u);
+  EXPECT_TRUE(source->read(16).empty());
+  source.reset();
+  std::filesystem::remove(kSourceFile);
+
+  EXPECT_EQ(IAMFByteSource::open(kSourceFile), nullptr);
+}
@@ -18,9 +18,15 @@
 #include <juce_audio_formats/juce_audio_formats.h>
 
 #include <atomic>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <span>
+#include <vector>
 
+#include "CountingByteSource.h"
 #include "FileOutputTestFixture.h"
 #include "iamf_tools_api_types.h"
 #include "processors/tests/FileOutputTestUtils.h"
@@ -337,3 +343,70 @@ TEST_F(IAMFFileReaderTest, abort_indexing) {
 
   ASSERT_EQ(reader, nullptr);
 }
+
+// A reader over the file's bytes in memory decodes the same audio as one over
+// the file itself
+TEST_F(IAMFFileReaderTest, read_from_memory) {
+  createBasicIAMFFile(kReferenceFilePath);
+  std::ifstream file(kReferenceFilePath, std::ios::binary);
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+  std::atomic_bool abort(false);
+  auto memoryReader = IAMFFileReader::createIamfReader(
+      std::make_unique<MemoryByteSource>(std::move(bytes)),
+      IAMFFileReader::kDefaultReaderSettings, abort);
+  auto fileReader = IAMFFileReader::createIamfReader(kReferenceFilePath);
+  ASSERT_NE(memoryReader, nullptr);
+  ASSERT_NE(fileReader, nullptr);
+
+  const IAMFFileReader::StreamData kSData = fileReader->getStreamData();
+  EXPECT_EQ(memoryReader->getStreamData().numFrames, kSData.numFrames);
+  juce::AudioBuffer<float> fromMemory(kSData.numChannels, kSData.frameSize);
+  juce::AudioBuffer<float> fromFile(kSData.numChannels, kSData.frameSize);
+  for (size_t frame = 0; frame < kSData.numFrames; ++frame) {
+    ASSERT_EQ(memoryReader->readFrame(fromMemory),
+              fileReader->readFrame(fromFile));
+    for (int ch = 0; ch < kSData.numChannels; ++ch) {
+      for (int i = 0; i < (int)kSData.frameSize; ++i) {
+        ASSERT_EQ(fromMemory.getSample(ch, i), fromFile.getSample(ch, i));
+      }
+    }
+  }
+}
+
+// Seeking back jumps to the temporal unit rather than decoding from the start
+TEST_F(IAMFFileReaderTest, seek_backwards_by_offset) {
+  createIAMFFile2AE2MP(kReferenceFilePath);
+  std::ifstream file(kReferenceFilePath, std::ios::binary);
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+  const uint64_t kFileSize = bytes.size();
+  std::atomic<uint64_t> bytesRead = 0;
+  std::atomic_bool abort(false);
+  auto reader = IAMFFileReader::createIamfReader(
+      std::make_unique<CountingByteSource>(std::move(bytes), bytesRead),
+      IAMFFileReader::kDefaultReaderSettings, abort);
+  ASSERT_NE(reader, nullptr);
+  const IAMFFileReader::StreamData kSData = reader->getStreamData();
+  ASSERT_GT(kSData.numFrames, 20u);
+  // Indexing finds the temporal units in the one pass that counts the frames,
+  // then only rereads the descriptors
+  EXPECT_LE(bytesRead, kFileSize + 2 * 4096);
+
+  const size_t kSeekFrame = kSData.numFrames / 2;
+  ASSERT_TRUE(reader->seekFrame(kSData.numFrames - 1));
+  bytesRead = 0;
+  ASSERT_TRUE(reader->seekFrame(kSeekFrame));
+  juce::AudioBuffer<float> buffer(kSData.numChannels, kSData.frameSize);
+  ASSERT_EQ(reader->readFrame(buffer), (size_t)kSData.frameSize);
+  EXPECT_LT(bytesRead, kFileSize / 4);
+
+  for (int i = 0; i < kSData.numChannels; ++i) {
+    for (int j = 0; j < (int)kSData.frameSize; ++j) {
+      ASSERT_NEAR(buffer.getSample(i, j),
+                  sampleSine(440.f, kSeekFrame * kSData.frameSize + j,
+                             kSData.sampleRate),
+                  .0001f);
+    }
+  }
+}
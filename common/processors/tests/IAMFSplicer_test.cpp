@@ -0,0 +1,231 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../file_output/iamf_export_utils/IAMFSplicer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../file_output/iamf_export_utils/IAMFObu.h"
+
+namespace {
+using Bytes = std::vector<uint8_t>;
+
+Bytes makeObu(const int type, const Bytes& payload) {
+  Bytes obu = {(uint8_t)(type << 3), (uint8_t)payload.size()};
+  obu.insert(obu.end(), payload.begin(), payload.end());
+  return obu;
+}
+
+void append(Bytes& bytes, const Bytes& more) {
+  bytes.insert(bytes.end(), more.begin(), more.end());
+}
+
+// Descriptors of one audio element with two substreams, coded with codecId,
+// and a mix presentation with a stereo and a 7.1.4 loudness.
+Bytes makeDescriptors(const std::string& codecId,
+                      const uint8_t numSubstreams = 2) {
+  Bytes obus = makeObu(31, {'i', 'a', 'm', 'f', 1, 1});
+  Bytes codecConfig = {0};
+  codecConfig.insert(codecConfig.end(), codecId.begin(), codecId.end());
+  append(codecConfig, {0x80, 0x01, 0, 0});
+  append(obus, makeObu(0, codecConfig));
+  append(obus, makeObu(1, {1, 0, 0, numSubstreams, 0, 1}));
+
+  const Bytes kMixGain = {5, 0x80, 0xf7, 0x02, 0x80, 0, 0};
+  Bytes mix = {7, 1, 'e', 'n', 0, 'M', 'i', 'x', 0, 1, 1, 1, 'E', 0, 0, 0};
+  append(mix, kMixGain);
+  append(mix, kMixGain);
+  // Stereo with a true peak, then 7.1.4 without
+  append(mix, {2, 0x80, 1, 0xe8, 0, 0xff, 0, 0xfe, 0});
+  append(mix, {0x80 | 9 << 2, 0, 0xe9, 0, 0xfd, 0});
+  append(obus, makeObu(2, mix));
+  return obus;
+}
+
+// Temporal units of two substreams whose payloads tell them apart, with a
+// parameter block leading every other one.
+Bytes makeTemporalUnits(const int count, const uint8_t source) {
+  Bytes obus;
+  for (int i = 0; i < count; ++i) {
+    if (i % 2 == 0) {
+      append(obus, makeObu(3, {9, source, (uint8_t)i}));
+    }
+    append(obus, makeObu(6, {source, (uint8_t)i, 0}));
+    append(obus, makeObu(7, {source, (uint8_t)i, 1}));
+  }
+  return obus;
+}
+
+std::stringstream toStream(const Bytes& bytes) {
+  return std::stringstream(std::string(bytes.begin(), bytes.end()));
+}
+
+Bytes spliceBytes(const Bytes& base, const Bytes& patch, const size_t first,
+                  bool& spliced) {
+  std::stringstream baseStream = toStream(base), patchStream = toStream(patch);
+  std::stringstream out;
+  spliced = IAMFSplicer::splice(baseStream, patchStream, first, out);
+  const std::string kOut = out.str();
+  return Bytes(kOut.begin(), kOut.end());
+}
+}  // namespace
+
+TEST(test_iamf_splicer, parses_temporal_units) {
+  const Bytes kDescriptors = makeDescriptors("ipcm");
+  Bytes file = kDescriptors;
+  append(file, makeTemporalUnits(5, 0));
+
+  std::stringstream in = toStream(file);
+  IAMFSplicer::Sequence sequence;
+  ASSERT_TRUE(IAMFSplicer::parse(in, sequence));
+  EXPECT_EQ(sequence.descriptorObus, kDescriptors);
+  EXPECT_EQ(sequence.endOffset, file.size());
+  ASSERT_EQ(sequence.getNumTemporalUnits(), 5u);
+  // Parameter blocks belong to the temporal unit they lead
+  EXPECT_EQ(sequence.temporalUnitOffsets[0], kDescriptors.size());
+  EXPECT_EQ(sequence.temporalUnitOffsets[1], kDescriptors.size() + 15);
+  EXPECT_EQ(sequence.temporalUnitOffsets[2], kDescriptors.size() + 25);
+  ASSERT_EQ(sequence.codecIds.size(), 1u);
+  EXPECT_EQ(sequence.codecIds[0], 0x6970636du);
+
+  // A truncated file is not parsed
+  file.pop_back();
+  std::stringstream truncated = toStream(file);
+  EXPECT_FALSE(IAMFSplicer::parse(truncated, sequence));
+}
+
+// Readers index a file from the chunks they decode
+TEST(test_iamf_splicer, indexes_appended_bytes) {
+  Bytes file = makeDescriptors("ipcm");
+  append(file, makeTemporalUnits(5, 0));
+  std::stringstream in = toStream(file);
+  IAMFSplicer::Sequence sequence;
+  ASSERT_TRUE(IAMFSplicer::parse(in, sequence));
+
+  for (const size_t kChunk : {(size_t)1, (size_t)3, file.size()}) {
+    IAMFObu::TemporalUnitIndex index;
+    for (size_t i = 0; i < file.size(); i += kChunk) {
+      ASSERT_TRUE(
+          index.append(file.data() + i, std::min(kChunk, file.size() - i)));
+    }
+    EXPECT_TRUE(index.isComplete());
+    EXPECT_EQ(index.getEndOffset(), file.size());
+    EXPECT_EQ(index.getTemporalUnitOffsets(), sequence.temporalUnitOffsets);
+  }
+
+  // A truncated file leaves an OBU incomplete
+  IAMFObu::TemporalUnitIndex index;
+  ASSERT_TRUE(index.append(file.data(), file.size() - 1));
+  EXPECT_FALSE(index.isComplete());
+}
+
+TEST(test_iamf_splicer, temporal_delimiters_start_units) {
+  // With a single substream counted as two, only the delimiters split
+  Bytes file = makeDescriptors("fLaC", 2);
+  for (int i = 0; i < 3; ++i) {
+    append(file, makeObu(4, {}));
+    append(file, makeObu(6, {0, (uint8_t)i}));
+  }
+
+  std::stringstream in = toStream(file);
+  IAMFSplicer::Sequence sequence;
+  ASSERT_TRUE(IAMFSplicer::parse(in, sequence));
+  EXPECT_EQ(sequence.getNumTemporalUnits(), 3u);
+}
+
+TEST(test_iamf_splicer, splices_temporal_units) {
+  Bytes base = makeDescriptors("ipcm");
+  append(base, makeTemporalUnits(10, 0));
+  // The patch's descriptors differ only by their loudness
+  Bytes patchDescriptors = makeDescriptors("ipcm");
+  patchDescriptors[patchDescriptors.size() - 3] = 0xf0;
+  Bytes patch = patchDescriptors;
+  const Bytes kPatchUnits = makeTemporalUnits(4, 1);
+  append(patch, kPatchUnits);
+
+  // Temporal units of the base that are kept
+  std::stringstream in = toStream(base);
+  IAMFSplicer::Sequence sequence;
+  ASSERT_TRUE(IAMFSplicer::parse(in, sequence));
+  const auto kUnitBytes = [&](const size_t begin, const size_t end) {
+    const uint64_t kEnd = end < sequence.getNumTemporalUnits()
+                              ? sequence.temporalUnitOffsets[end]
+                              : sequence.endOffset;
+    return Bytes(base.begin() + sequence.temporalUnitOffsets[begin],
+                 base.begin() + kEnd);
+  };
+
+  Bytes expected = patchDescriptors;
+  append(expected, kUnitBytes(0, 3));
+  append(expected, kPatchUnits);
+  append(expected, kUnitBytes(7, 10));
+  bool spliced = false;
+  EXPECT_EQ(spliceBytes(base, patch, 3, spliced), expected);
+  EXPECT_TRUE(spliced);
+
+  // The last temporal units may be replaced too
+  expected = patchDescriptors;
+  append(expected, kUnitBytes(0, 6));
+  append(expected, kPatchUnits);
+  EXPECT_EQ(spliceBytes(base, patch, 6, spliced), expected);
+  EXPECT_TRUE(spliced);
+}
+
+TEST(test_iamf_splicer, rejects_patches_that_do_not_fit) {
+  Bytes base = makeDescriptors("ipcm");
+  append(base, makeTemporalUnits(10, 0));
+  Bytes patch = makeDescriptors("ipcm");
+  append(patch, makeTemporalUnits(4, 1));
+  bool spliced = true;
+
+  // Past the end of the file
+  spliceBytes(base, patch, 7, spliced);
+  EXPECT_FALSE(spliced);
+
+  // Encoded from a different audio element
+  Bytes otherElement = makeDescriptors("ipcm", 3);
+  append(otherElement, makeTemporalUnits(4, 1));
+  spliceBytes(base, otherElement, 0, spliced);
+  EXPECT_FALSE(spliced);
+
+  // Opus frames depend on the frames before them
+  Bytes opusBase = makeDescriptors("Opus");
+  append(opusBase, makeTemporalUnits(10, 0));
+  Bytes opusPatch = makeDescriptors("Opus");
+  append(opusPatch, makeTemporalUnits(4, 1));
+  spliceBytes(opusBase, opusPatch, 0, spliced);
+  EXPECT_FALSE(spliced);
+}
+
+TEST(test_iamf_splicer, finds_loudness_fields) {
+  const Bytes kDescriptors = makeDescriptors("ipcm");
+  const auto kFields = IAMFSplicer::findLoudnessFields(kDescriptors);
+  ASSERT_EQ(kFields.size(), 2u);
+
+  EXPECT_EQ(kFields[0].mixPresentationId, 7u);
+  EXPECT_EQ(kFields[0].soundSystem, 0);
+  EXPECT_EQ(kDescriptors[kFields[0].integratedLoudness], 0xe8);
+  EXPECT_EQ(kDescriptors[kFields[0].digitalPeak], 0xff);
+  EXPECT_EQ(kDescriptors[kFields[0].truePeak], 0xfe);
+
+  EXPECT_EQ(kFields[1].soundSystem, 9);
+  EXPECT_EQ(kDescriptors[kFields[1].integratedLoudness], 0xe9);
+  EXPECT_EQ(kDescriptors[kFields[1].digitalPeak], 0xfd);
+  EXPECT_EQ(kFields[1].truePeak, 0u);
+}
@@ -0,0 +1,105 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "processors/mix_monitoring/loudness_standards/KWeightedLoudnessMeter.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+// Measure a sine tone on a single channel of the given layout, fed in blocks.
+KWeightedLoudnessMeter measureTone(const double sampleRate,
+                                   const juce::AudioChannelSet& layout,
+                                   const int toneChannel, const float amplitude,
+                                   const double seconds) {
+  KWeightedLoudnessMeter meter;
+  meter.prepare(sampleRate, layout);
+
+  const int kBlockSize = 480;
+  juce::AudioBuffer<float> block(layout.size(), kBlockSize);
+  const int numBlocks = (int)(seconds * sampleRate) / kBlockSize;
+  long sample = 0;
+  for (int b = 0; b < numBlocks; ++b) {
+    block.clear();
+    for (int i = 0; i < kBlockSize; ++i, ++sample) {
+      block.setSample(toneChannel, i,
+                      amplitude * std::sin(2.0 * M_PI * 997.0 * sample /
+                                           sampleRate));
+    }
+    meter.process(block);
+  }
+  return meter;
+}
+}  // namespace
+
+TEST(test_kweighted_loudness, coefficients_match_itu_48k) {
+  // Reference coefficients from ITU-R BS.1770-4 Tables 1 and 2.
+  const auto pre = KWeightedLoudnessMeter::designPreFilter(48e3);
+  EXPECT_NEAR(pre.b0, 1.53512485958697, 1e-9);
+  EXPECT_NEAR(pre.b1, -2.69169618940638, 1e-9);
+  EXPECT_NEAR(pre.b2, 1.19839281085285, 1e-9);
+  EXPECT_NEAR(pre.a1, -1.69065929318241, 1e-9);
+  EXPECT_NEAR(pre.a2, 0.73248077421585, 1e-9);
+
+  const auto rlb = KWeightedLoudnessMeter::designRLBFilter(48e3);
+  EXPECT_NEAR(rlb.a1, -1.99004745483398, 1e-9);
+  EXPECT_NEAR(rlb.a2, 0.99007225036621, 1e-9);
+}
+
+TEST(test_kweighted_loudness, full_scale_tone_any_sample_rate) {
+  // A 0 dBFS 997 Hz sine on one front channel measures -3.01 LUFS.
+  for (const double sr : {44.1e3, 48e3, 96e3}) {
+    KWeightedLoudnessMeter meter = measureTone(
+        sr, juce::AudioChannelSet::stereo(), 0, 1.f, 5.0);
+    EXPECT_NEAR(meter.getIntegratedLoudness(), -3.01f, 0.05f) << sr;
+    EXPECT_NEAR(meter.getMomentaryLoudness(), -3.01f, 0.05f) << sr;
+    EXPECT_NEAR(meter.getShortTermLoudness(), -3.01f, 0.05f) << sr;
+    EXPECT_NEAR(meter.getLoudnessRange(), 0.f, 0.2f) << sr;
+  }
+}
+
+TEST(test_kweighted_loudness, channel_packing_and_weights) {
+  const juce::AudioChannelSet layout =
+      juce::AudioChannelSet::create7point1point4();
+
+  // Every non-LFE, non-surround channel measures the same regardless of which
+  // SIMD group and lane it is packed into.
+  for (int ch = 0; ch < layout.size(); ++ch) {
+    const auto type = layout.getTypeOfChannel(ch);
+    KWeightedLoudnessMeter meter = measureTone(48e3, layout, ch, 0.5f, 1.0);
+    const float weight = KWeightedLoudnessMeter::getChannelWeight(type);
+    if (weight == 0.f) {
+      EXPECT_EQ(meter.getIntegratedLoudness(),
+                KWeightedLoudnessMeter::kMinimalLoudness);
+    } else {
+      EXPECT_NEAR(meter.getIntegratedLoudness(),
+                  -9.03f + 10.f * std::log10(weight), 0.05f)
+          << layout.getChannelTypeName(type);
+    }
+  }
+}
+
+TEST(test_kweighted_loudness, silence_and_reset) {
+  KWeightedLoudnessMeter meter = measureTone(
+      48e3, juce::AudioChannelSet::mono(), 0, 0.f, 1.0);
+  EXPECT_EQ(meter.getIntegratedLoudness(),
+            KWeightedLoudnessMeter::kMinimalLoudness);
+  EXPECT_EQ(meter.getMomentaryLoudness(),
+            KWeightedLoudnessMeter::kMinimalLoudness);
+
+  meter = measureTone(48e3, juce::AudioChannelSet::mono(), 0, 1.f, 1.0);
+  ASSERT_GT(meter.getIntegratedLoudness(), -10.f);
+  meter.reset();
+  EXPECT_EQ(meter.getIntegratedLoudness(),
+            KWeightedLoudnessMeter::kMinimalLoudness);
+}
@@ -0,0 +1,160 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "BinauralLoudnessEstimator.h"
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "substream_rdr/rdr_factory/RendererFactory.h"
+
+std::shared_ptr<const BinauralLoudnessEstimator>
+BinauralLoudnessEstimator::getShared(
+    const Speakers::AudioElementSpeakerLayout layout, const int sampleRate) {
+  // Calibration renders up to two seconds of audio, so only do it once per layout
+  static std::mutex cacheMutex;
+  static std::map<std::pair<int, int>,
+                  std::shared_ptr<const BinauralLoudnessEstimator>>
+      cache;
+
+  const std::lock_guard<std::mutex> lock(cacheMutex);
+  const std::pair<int, int> key = {(int)layout, sampleRate};
+  auto found = cache.find(key);
+  if (found != cache.end()) {
+    return found->second;
+  }
+
+  auto estimator =
+      std::make_shared<const BinauralLoudnessEstimator>(layout, sampleRate);
+  if (!estimator->isValid()) {
+    estimator.reset();
+  }
+  cache[key] = estimator;
+  return estimator;
+}
+
+BinauralLoudnessEstimator::BinauralLoudnessEstimator(
+    const Speakers::AudioElementSpeakerLayout layout, const int sampleRate)
+    : coherent_(layout.isAmbisonics()) {
+  calibrate(layout, sampleRate);
+}
+
+void BinauralLoudnessEstimator::calibrate(
+    const Speakers::AudioElementSpeakerLayout layout, const int sampleRate) {
+  std::unique_ptr<Renderer> renderer = createRenderer(
+      layout, Speakers::kBinaural, kCalibrationBlockSize, sampleRate);
+  if (renderer == nullptr) {
+    return;
+  }
+
+  const int numChannels = layout.getNumChannels();
+  const int numEars = Speakers::kBinaural.getNumChannels();
+  juce::AudioBuffer<float> input(numChannels, kCalibrationBlockSize);
+  juce::AudioBuffer<float> output(numEars, kCalibrationBlockSize);
+
+  // Ear responses of every channel, by channel then ear.
+  std::vector<float> responses((size_t)numChannels * numEars * kResponseLength);
+  auto getResponse = [&](const int channel, const int ear) {
+    return responses.data() +
+           ((size_t)channel * numEars + ear) * kResponseLength;
+  };
+
+  // Impulses are far enough apart for each response to have died out before
+  // the next channel's impulse.
+  for (int ch = 0; ch < numChannels; ++ch) {
+    for (int start = 0; start < kResponseLength;
+         start += kCalibrationBlockSize) {
+      input.clear();
+      if (start == 0) {
+        input.setSample(ch, 0, 1.f);
+      }
+      output.clear();
+      renderer->render(input, output);
+
+      const int length =
+          juce::jmin(kCalibrationBlockSize, kResponseLength - start);
+      for (int ear = 0; ear < numEars; ++ear) {
+        juce::FloatVectorOperations::copy(getResponse(ch, ear) + start,
+                                          output.getReadPointer(ear), length);
+      }
+    }
+  }
+
+  numChannels_ = numChannels;
+  energies_.assign((size_t)numEars * numChannels * numChannels, 0.f);
+  for (int ear = 0; ear < numEars; ++ear) {
+    float* energies = energies_.data() + ear * numChannels * numChannels;
+    for (int c = 0; c < numChannels; ++c) {
+      for (int d = c; d < numChannels; ++d) {
+        // Loudspeaker layouts only ever use the diagonal
+        if (!coherent_ && c != d) {
+          continue;
+        }
+        const float* a = getResponse(c, ear);
+        const float* b = getResponse(d, ear);
+        double energy = 0.0;
+        for (int i = 0; i < kResponseLength; ++i) {
+          energy += (double)a[i] * b[i];
+        }
+        energies[c * numChannels + d] = (float)energy;
+        energies[d * numChannels + c] = (float)energy;
+      }
+    }
+  }
+}
+
+std::array<float, 2> BinauralLoudnessEstimator::estimate(
+    const juce::AudioBuffer<float>& input) const {
+  const int numChannels = juce::jmin(numChannels_, input.getNumChannels());
+  const int numSamples = input.getNumSamples();
+  std::array<float, 2> meanSquares = {0.f, 0.f};
+  if (numSamples == 0) {
+    return meanSquares;
+  }
+
+  for (int c = 0; c < numChannels; ++c) {
+    const float* a = input.getReadPointer(c);
+    // Covariance is symmetric, so visit each pair once and count the
+    // off-diagonal pairs twice.
+    const int lastPartner = coherent_ ? numChannels : c + 1;
+    for (int d = c; d < lastPartner; ++d) {
+      const float* b = input.getReadPointer(d);
+      float covariance = 0.f;
+      for (int i = 0; i < numSamples; ++i) {
+        covariance += a[i] * b[i];
+      }
+      covariance /= numSamples;
+      if (d != c) {
+        covariance *= 2.f;
+      }
+      for (int ear = 0; ear < 2; ++ear) {
+        meanSquares[ear] += covariance * getEnergies(ear)[c * numChannels_ + d];
+      }
+    }
+  }
+  return meanSquares;
+}
+
+std::array<float, 2> BinauralLoudnessEstimator::estimateFromMeanSquares(
+    const float* meanSquares) const {
+  std::array<float, 2> ears = {0.f, 0.f};
+  for (int ear = 0; ear < 2; ++ear) {
+    const float* energies = getEnergies(ear);
+    for (int c = 0; c < numChannels_; ++c) {
+      ears[ear] += meanSquares[c] * energies[c * numChannels_ + c];
+    }
+  }
+  return ears;
+}
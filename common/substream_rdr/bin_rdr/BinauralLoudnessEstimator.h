@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "substream_rdr/substream_rdr_utils/Speakers.h"
+
+/**
+ * @brief Estimates the level at each ear of a binaural render without
+ * rendering.
+ *
+ * On construction an impulse is rendered through a BinauralRdr on each input
+ * channel in turn, and the energy of every pair of ear responses is kept. The
+ * mean square at an ear is then estimated from the input as
+ *
+ *   sum over channels c, d of  R(c, d) * G(c, d)
+ *
+ * where R is the zero-lag covariance of the input channels over the block
+ * and G the energy shared by the ear responses of channels c and d.
+ *
+ * Error bounds, against the mean square of a full render:
+ * - The estimate is exact in expectation for spectrally white inputs. Other
+ *   spectra read high or low by how far the HRTFs' magnitude in the occupied
+ *   band deviates from their broadband mean.
+ * - Each block is treated on its own, so filter tails carried over from the
+ *   previous block are ignored. This only matters for transients.
+ * - Loudspeaker channels are assumed to be uncorrelated and only the
+ *   diagonal of G is used, which costs one multiply-add per channel and ear.
+ *   Content shared coherently by k channels can then read up to
+ *   10 * log10(k) dB low, or high where the ear responses cancel.
+ * - Ambisonic channels are coherent by construction, so the full covariance
+ *   is used for them and this last bound does not apply.
+ */
+class BinauralLoudnessEstimator {
+ public:
+  /**
+   * @brief Estimator for the given input layout and sample rate, shared by
+   * every caller in the process.
+   *
+   * @return nullptr if no binaural renderer exists for the layout.
+   */
+  static std::shared_ptr<const BinauralLoudnessEstimator> getShared(
+      const Speakers::AudioElementSpeakerLayout layout, const int sampleRate);
+
+  BinauralLoudnessEstimator(const Speakers::AudioElementSpeakerLayout layout,
+                            const int sampleRate);
+
+  bool isValid() const { return numChannels_ > 0; }
+  int getNumChannels() const { return numChannels_; }
+
+  // Whether estimate() needs the covariance of the input channels, rather
+  // than only their mean squares.
+  bool isCoherent() const { return coherent_; }
+
+  // Mean square at the left and right ear for one block of input.
+  std::array<float, 2> estimate(const juce::AudioBuffer<float>& input) const;
+
+  // Mean square at each ear from the mean square of each input channel. The
+  // channels are treated as uncorrelated whatever the layout.
+  std::array<float, 2> estimateFromMeanSquares(const float* meanSquares) const;
+
+ private:
+  // Samples of each impulse response kept. OBR's filters are far shorter.
+  static constexpr int kResponseLength = 4096;
+  static constexpr int kCalibrationBlockSize = 512;
+
+  void calibrate(const Speakers::AudioElementSpeakerLayout layout,
+                 const int sampleRate);
+
+  const float* getEnergies(const int ear) const {
+    return energies_.data() + ear * numChannels_ * numChannels_;
+  }
+
+  int numChannels_ = 0;
+  bool coherent_ = false;
+  // Shared energy of the responses of channel pairs, per ear, row major.
+  std::vector<float> energies_;
+};
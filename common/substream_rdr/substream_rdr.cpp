@@ -15,6 +15,7 @@
 #include "substream_rdr.h"
 
 #include "bed2bed_rdr/BedToBedRdr.cpp"
+#include "bin_rdr/BinauralLoudnessEstimator.cpp"
 #include "bin_rdr/BinauralRdr.cpp"
 #include "hoa2bed_rdr/HOAToBedRdr.cpp"
 #include "passthrough_rdr/PassthroughRdr.cpp"
@@ -22,4 +23,5 @@
 #include "substream_rdr_utils/Speakers.cpp"
 #include "surround_panner/AmbisonicPanner.cpp"
 #include "surround_panner/BinauralPanner.cpp"
-#include "surround_panner/MonoToSpeakerPanner.cpp"
\ No newline at end of file
+#include "surround_panner/MonoToSpeakerPanner.cpp"
+#include "surround_panner/SpeakerGainTable.cpp"
\ No newline at end of file
@@ -33,6 +33,7 @@ END_JUCE_MODULE_DECLARATION
 #endif
 
 #include "bed2bed_rdr/BedToBedRdr.h"
+#include "bin_rdr/BinauralLoudnessEstimator.h"
 #include "bin_rdr/BinauralRdr.h"
 #include "hoa2bed_rdr/HOAToBedRdr.h"
 #include "passthrough_rdr/PassthroughRdr.h"
@@ -42,3 +43,4 @@ END_JUCE_MODULE_DECLARATION
 #include "surround_panner/AudioPanner.h"
 #include "surround_panner/BinauralPanner.h"
 #include "surround_panner/MonoToSpeakerPanner.h"
+#include "surround_panner/SpeakerGainTable.h"
@@ -14,6 +14,31 @@
 
 #include "MonoToSpeakerPanner.h"
 
+// ITU 9_10_3 has 24 channels
+// See: https://www.itu.int/rec/R-REC-BS.2127-1-202311-I/en
+constexpr int kNum9Point10Point3Channels = 24;
+
+// Position of each of the 16 channels of 9.1.6 in 9.10.3, which contains 8
+// additional channels
+constexpr int k9Point1Point6In9Point10Point3[] = {
+    0,   // FL
+    1,   // FR
+    2,   // FC
+    3,   // LFE
+    4,   // BL
+    5,   // BR
+    6,   // FLc
+    7,   // FRc
+    10,  // SiL
+    11,  // SiR
+    12,  // TpFL
+    13,  // TpFR
+    16,  // TpBL
+    17,  // TpBR
+    18,  // TpSiL
+    19,  // TpSir
+};
+
 inline admrender::OutputLayout AdmTypeFromPannedLayout(
     Speakers::AudioElementSpeakerLayout pannedLayout) {
   switch (pannedLayout) {
@@ -58,20 +83,26 @@ inline admrender::OutputLayout AdmTypeFromPannedLayout(
 
 MonoToSpeakerPanner::MonoToSpeakerPanner(
     const Speakers::AudioElementSpeakerLayout pannedLayout,
-    const int samplesPerBlock, const int sampleRate)
-    : AudioPanner(pannedLayout, samplesPerBlock, sampleRate) {
+    const int samplesPerBlock, const int sampleRate, const Mode mode)
+    : AudioPanner(pannedLayout, samplesPerBlock, sampleRate), mode_(mode) {
+  if (mode_ == Mode::kGainTable) {
+    if (initialiseGainTable()) {
+      positionUpdated();
+      return;
+    }
+    mode_ = Mode::kRenderer;
+  }
+
   // Prepare a buffer to write the output audio to
   // For expanded layouts, we need to render to all channels and then copy out
   // the ones we need
   if (!pannedLayout.isExpandedLayout()) {
     outputAudioBufferPointers_ = new float*[kPannedLayout_.getNumChannels()];
   } else {
-    // ITU 9_10_3 has 24 channels
-    // See: https://www.itu.int/rec/R-REC-BS.2127-1-202311-I/en
     // For simplicity, create the widest buffer we could possibly need
-    outputAudioBufferPointers_ = new float*[24];
+    outputAudioBufferPointers_ = new float*[kNum9Point10Point3Channels];
 
-    for (int i = 0; i < 24; i++) {
+    for (int i = 0; i < kNum9Point10Point3Channels; i++) {
       outputAudioBufferPointers_[i] = new float[samplesPerBlock];
     }
 
@@ -82,22 +113,9 @@ MonoToSpeakerPanner::MonoToSpeakerPanner(
         admrender::OutputLayout::ITU_9_10_3) {
       // Configure a mapping from the 16 channels of 9.1.6 to the 24 channels
       // of 9.10.3
-      explChannelPointers_.push_back(outputAudioBufferPointers_[0]);   // FL
-      explChannelPointers_.push_back(outputAudioBufferPointers_[1]);   // FR
-      explChannelPointers_.push_back(outputAudioBufferPointers_[2]);   // FC
-      explChannelPointers_.push_back(outputAudioBufferPointers_[3]);   // LFE
-      explChannelPointers_.push_back(outputAudioBufferPointers_[4]);   // BL
-      explChannelPointers_.push_back(outputAudioBufferPointers_[5]);   // BR
-      explChannelPointers_.push_back(outputAudioBufferPointers_[6]);   // FLc
-      explChannelPointers_.push_back(outputAudioBufferPointers_[7]);   // FRc
-      explChannelPointers_.push_back(outputAudioBufferPointers_[10]);  // SiL
-      explChannelPointers_.push_back(outputAudioBufferPointers_[11]);  // SiR
-      explChannelPointers_.push_back(outputAudioBufferPointers_[12]);  // TpFL
-      explChannelPointers_.push_back(outputAudioBufferPointers_[13]);  // TpFR
-      explChannelPointers_.push_back(outputAudioBufferPointers_[16]);  // TpBL
-      explChannelPointers_.push_back(outputAudioBufferPointers_[17]);  // TpBR
-      explChannelPointers_.push_back(outputAudioBufferPointers_[18]);  // TpSiL
-      explChannelPointers_.push_back(outputAudioBufferPointers_[19]);  // TpSir
+      for (const int channel : k9Point1Point6In9Point10Point3) {
+        explChannelPointers_.push_back(outputAudioBufferPointers_[channel]);
+      }
     } else {
       // The mappings are identical, so just add all the channels from the
       // panned layout
@@ -127,15 +145,63 @@ MonoToSpeakerPanner::MonoToSpeakerPanner(
 }
 
 MonoToSpeakerPanner::~MonoToSpeakerPanner() {
+  if (outputAudioBufferPointers_ == nullptr) {
+    return;
+  }
   if (kPannedLayout_.isExpandedLayout()) {
-    for (int i = 0; i < kPannedLayout_.getNumChannels(); i++) {
+    for (int i = 0; i < kNum9Point10Point3Channels; i++) {
       delete[] outputAudioBufferPointers_[i];
     }
   }
-  delete outputAudioBufferPointers_;
+  delete[] outputAudioBufferPointers_;
+}
+
+bool MonoToSpeakerPanner::initialiseGainTable() {
+  // Expanded layouts take their channels from the base layout's table
+  std::string ituLayout;
+  if (!kPannedLayout_.isExpandedLayout()) {
+    ituLayout = kPannedLayout_.getItuString();
+    for (int i = 0; i < kPannedLayout_.getNumChannels(); i++) {
+      tableChannels_.push_back(i);
+    }
+  } else {
+    const Speakers::AudioElementSpeakerLayout baseLayout =
+        kPannedLayout_.getExplBaseLayout();
+    const std::vector<int> validChannels =
+        kPannedLayout_.getExplValidChannels().value();
+    if (baseLayout == Speakers::kExpl9Point1Point6) {
+      ituLayout = Speakers::k22p2.getItuString();
+      for (const int channel : validChannels) {
+        tableChannels_.push_back(k9Point1Point6In9Point10Point3[channel]);
+      }
+    } else {
+      ituLayout = baseLayout.getItuString();
+      tableChannels_ = validChannels;
+    }
+  }
+
+  // Layouts outside BS.2051, such as 3.1.2, are left to the renderer
+  gainTable_ = SpeakerGainTable::getShared(ituLayout);
+  if (gainTable_ == nullptr) {
+    tableChannels_.clear();
+    return false;
+  }
+  tableGains_.resize(gainTable_->getNumChannels());
+  currentGains_.resize(tableChannels_.size());
+  targetGains_.resize(tableChannels_.size());
+  return true;
 }
 
 void MonoToSpeakerPanner::positionUpdated() {
+  if (mode_ == Mode::kGainTable) {
+    gainTable_->getGains((float)currPos_.azimuth, (float)currPos_.elevation,
+                         tableGains_.data());
+    for (size_t i = 0; i < tableChannels_.size(); i++) {
+      targetGains_[i] = tableGains_[tableChannels_[i]];
+    }
+    return;
+  }
+
   objectMetadata_.position.polarPosition().azimuth = currPos_.azimuth;
   objectMetadata_.position.polarPosition().elevation = currPos_.elevation;
   objectMetadata_.position.polarPosition().distance = currPos_.distance;
@@ -143,6 +209,11 @@ void MonoToSpeakerPanner::positionUpdated() {
 
 void MonoToSpeakerPanner::process(juce::AudioBuffer<float>& inputBuffer,
                                   juce::AudioBuffer<float>& outputBuffer) {
+  if (mode_ == Mode::kGainTable) {
+    processWithGainTable(inputBuffer, outputBuffer);
+    return;
+  }
+
   // Add the object to the stream
   // Note that GetRendereredAudio basically resets the renderer, so objects must
   // be added every time
@@ -173,4 +244,35 @@ void MonoToSpeakerPanner::process(juce::AudioBuffer<float>& inputBuffer,
                             kSamplesPerBlock_);
     }
   }
+}
+
+void MonoToSpeakerPanner::processWithGainTable(
+    juce::AudioBuffer<float>& inputBuffer,
+    juce::AudioBuffer<float>& outputBuffer) {
+  const int numSamples =
+      std::min(inputBuffer.getNumSamples(), outputBuffer.getNumSamples());
+  const int numChannels =
+      std::min((int)targetGains_.size(), outputBuffer.getNumChannels());
+  const float* input = inputBuffer.getReadPointer(0);
+
+  // Start at the first position rather than fading in from silence
+  if (!rampFromCurrent_) {
+    std::copy(targetGains_.begin(), targetGains_.end(), currentGains_.begin());
+    rampFromCurrent_ = true;
+  }
+
+  // Ramp each channel linearly from the gains of the previous block, so that
+  // position changes are free of zipper noise
+  for (int ch = 0; ch < numChannels; ch++) {
+    outputBuffer.copyFromWithRamp(ch, 0, input, numSamples, currentGains_[ch],
+                                  targetGains_[ch]);
+    currentGains_[ch] = targetGains_[ch];
+    if (numSamples < outputBuffer.getNumSamples()) {
+      outputBuffer.clear(ch, numSamples,
+                         outputBuffer.getNumSamples() - numSamples);
+    }
+  }
+  for (int ch = numChannels; ch < outputBuffer.getNumChannels(); ch++) {
+    outputBuffer.clear(ch, 0, outputBuffer.getNumSamples());
+  }
 }
\ No newline at end of file
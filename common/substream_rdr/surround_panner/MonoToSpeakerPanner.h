@@ -18,13 +18,25 @@
 #include <ADMRenderer.h>
 #include <juce_audio_basics/juce_audio_basics.h>
 
+#include <memory>
+
 #include "AudioPanner.h"
+#include "SpeakerGainTable.h"
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
 
 class MonoToSpeakerPanner : public AudioPanner {
  public:
+  enum class Mode {
+    // Render every block with libspatialaudio's ADM renderer.
+    kRenderer,
+    // Apply gains looked up from a precomputed table, ramping between blocks.
+    // Falls back to kRenderer for layouts that are not in BS.2051.
+    kGainTable,
+  };
+
   MonoToSpeakerPanner(const Speakers::AudioElementSpeakerLayout pannedLayout,
-                      const int samplesPerBlock, const int sampleRate);
+                      const int samplesPerBlock, const int sampleRate,
+                      const Mode mode = Mode::kGainTable);
 
   ~MonoToSpeakerPanner();
 
@@ -41,11 +53,29 @@ class MonoToSpeakerPanner : public AudioPanner {
   void process(juce::AudioBuffer<float>& inputBuffer,
                juce::AudioBuffer<float>& outputBuffer) override;
 
+  Mode getMode() const { return mode_; }
+
  protected:
   void positionUpdated() override;
 
  private:
-  float** outputAudioBufferPointers_;
+  bool initialiseGainTable();
+  void processWithGainTable(juce::AudioBuffer<float>& inputBuffer,
+                            juce::AudioBuffer<float>& outputBuffer);
+
+  Mode mode_;
+
+  // Gain table mode
+  std::shared_ptr<const SpeakerGainTable> gainTable_;
+  // Table channel feeding each output channel
+  std::vector<int> tableChannels_;
+  std::vector<float> tableGains_;
+  std::vector<float> currentGains_;
+  std::vector<float> targetGains_;
+  bool rampFromCurrent_ = false;
+
+  // Renderer mode
+  float** outputAudioBufferPointers_ = nullptr;
   admrender::ObjectMetadata objectMetadata_;
   admrender::StreamInformation streamInfo_;
   admrender::CAdmRenderer renderer_;
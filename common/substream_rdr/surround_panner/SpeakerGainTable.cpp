@@ -0,0 +1,98 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SpeakerGainTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+#include "ear/ear.hpp"
+
+std::shared_ptr<const SpeakerGainTable> SpeakerGainTable::getShared(
+    const std::string& ituLayout) {
+  // Tables are small but slow to build, so keep every one ever requested
+  static std::mutex cacheMutex;
+  static std::map<std::string, std::shared_ptr<const SpeakerGainTable>> cache;
+
+  const std::lock_guard<std::mutex> lock(cacheMutex);
+  auto found = cache.find(ituLayout);
+  if (found != cache.end()) {
+    return found->second;
+  }
+
+  std::shared_ptr<const SpeakerGainTable> table;
+  const std::vector<ear::Layout>& known = ear::loadLayouts();
+  if (std::any_of(known.begin(), known.end(), [&](const ear::Layout& layout) {
+        return layout.name() == ituLayout;
+      })) {
+    table = std::make_shared<const SpeakerGainTable>(ituLayout);
+  }
+  cache[ituLayout] = table;
+  return table;
+}
+
+SpeakerGainTable::SpeakerGainTable(const std::string& ituLayout) {
+  const ear::Layout layout = ear::getLayout(ituLayout);
+  ear::GainCalculatorObjects calculator(layout);
+  numChannels_ = (int)layout.channels().size();
+  gains_.resize((size_t)kNumAzimuths * kNumElevations * numChannels_);
+
+  ear::ObjectsTypeMetadata metadata;
+  std::vector<float> directGains(numChannels_);
+  std::vector<float> diffuseGains(numChannels_);
+  for (int e = 0; e < kNumElevations; ++e) {
+    for (int a = 0; a < kNumAzimuths; ++a) {
+      metadata.position = ear::PolarPosition(-180.0 + a * kStepDegrees,
+                                             -90.0 + e * kStepDegrees, 1.0);
+      calculator.calculate(metadata, directGains, diffuseGains);
+      std::copy(directGains.begin(), directGains.end(),
+                gains_.begin() + (e * kNumAzimuths + a) * numChannels_);
+    }
+  }
+}
+
+void SpeakerGainTable::getGains(const float azimuth, const float elevation,
+                                float* gains) const {
+  // Position within the grid, azimuth wrapped to [-180, 180)
+  const float wrapped = azimuth - 360.f * std::floor((azimuth + 180.f) / 360.f);
+  const float a = (wrapped + 180.f) / kStepDegrees;
+  const float e =
+      (std::clamp(elevation, -90.f, 90.f) + 90.f) / (float)kStepDegrees;
+  const int a0 = std::min((int)a, kNumAzimuths - 2);
+  const int e0 = std::min((int)e, kNumElevations - 2);
+  const float fa = a - a0;
+  const float fe = e - e0;
+
+  const float* g00 = getGridGains(a0, e0);
+  const float* g10 = getGridGains(a0 + 1, e0);
+  const float* g01 = getGridGains(a0, e0 + 1);
+  const float* g11 = getGridGains(a0 + 1, e0 + 1);
+  float power = 0.f;
+  for (int ch = 0; ch < numChannels_; ++ch) {
+    const float low = g00[ch] + fa * (g10[ch] - g00[ch]);
+    const float high = g01[ch] + fa * (g11[ch] - g01[ch]);
+    gains[ch] = low + fe * (high - low);
+    power += gains[ch] * gains[ch];
+  }
+
+  // Blending neighbouring speaker pairs loses a little power between them
+  if (power > 0.f) {
+    const float norm = 1.f / std::sqrt(power);
+    for (int ch = 0; ch < numChannels_; ++ch) {
+      gains[ch] *= norm;
+    }
+  }
+}
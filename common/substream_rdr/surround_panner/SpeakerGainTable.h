@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Point source panning gains for a BS.2051 layout, sampled on a
+ * regular azimuth/elevation grid.
+ *
+ * Gains at each grid point are computed once with libear's BS.2127 object
+ * gain calculator. Gains for any other direction are interpolated between the
+ * four surrounding grid points and renormalised to unit power.
+ */
+class SpeakerGainTable {
+ public:
+  static constexpr int kStepDegrees = 5;
+
+  /**
+   * @brief Table for the given BS.2051 layout (e.g. "4+7+0"), shared by every
+   * caller in the process.
+   *
+   * @return nullptr if libear does not know the layout.
+   */
+  static std::shared_ptr<const SpeakerGainTable> getShared(
+      const std::string& ituLayout);
+
+  explicit SpeakerGainTable(const std::string& ituLayout);
+
+  int getNumChannels() const { return numChannels_; }
+
+  // Write the gains of every channel for a direction in degrees, following
+  // the ITU-R BS.2051 conventions.
+  void getGains(const float azimuth, const float elevation,
+                float* gains) const;
+
+ private:
+  const float* getGridGains(const int azimuthIndex,
+                            const int elevationIndex) const {
+    return gains_.data() +
+           (elevationIndex * kNumAzimuths + azimuthIndex) * numChannels_;
+  }
+
+  // Azimuth -180 to 180 and elevation -90 to 90, both ends included.
+  static constexpr int kNumAzimuths = 360 / kStepDegrees + 1;
+  static constexpr int kNumElevations = 180 / kStepDegrees + 1;
+
+  int numChannels_;
+  // Channel gains of every grid point, by elevation then azimuth.
+  std::vector<float> gains_;
+};
@@ -15,6 +15,8 @@
 #include <gtest/gtest.h>
 #include <juce_audio_formats/juce_audio_formats.h>
 
+#include <array>
+
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
 #include "substream_rdr/surround_panner/AmbisonicPanner.h"
 #include "substream_rdr/surround_panner/BinauralPanner.h"
@@ -112,8 +114,9 @@ TEST(test_surround_panner, pan_to_bed) {
     }
 
     // Construct a panner for the given layout.
-    MonoToSpeakerPanner monoToSpeakerPanner(outputLayout.layout, kNumSamples,
-                                            48000);
+    MonoToSpeakerPanner monoToSpeakerPanner(
+        outputLayout.layout, kNumSamples, 48000,
+        MonoToSpeakerPanner::Mode::kRenderer);
 
     // Set source position all the way to the right
     monoToSpeakerPanner.setPosition(0.5, 0.5, 0.5);
@@ -131,8 +134,9 @@ TEST(test_surround_panner, pan_to_bed) {
       }
     }
 
-    MonoToSpeakerPanner monoToSpeakerPanner2(outputLayout.layout, kNumSamples,
-                                             48000);
+    MonoToSpeakerPanner monoToSpeakerPanner2(
+        outputLayout.layout, kNumSamples, 48000,
+        MonoToSpeakerPanner::Mode::kRenderer);
 
     // Move the source position all the way to the right
     monoToSpeakerPanner2.setPosition(45.0f, 0.0f, 0.0f);
@@ -149,6 +153,79 @@ TEST(test_surround_panner, pan_to_bed) {
   }
 }
 
+// Validate the gain table panner against the ADM renderer
+TEST(test_surround_panner, gain_table_matches_renderer) {
+  const float kInput = 0.5f;
+  const std::vector<std::array<float, 3>> kPositions = {
+      {10.f, 20.f, 5.f}, {-30.f, 5.f, 10.f}, {0.f, -40.f, -5.f}};
+
+  juce::AudioBuffer<float> inputBuffer(1, kNumSamples);
+  for (int i = 0; i < kNumSamples; ++i) {
+    inputBuffer.setSample(0, i, kInput);
+  }
+
+  for (const auto& outputLayout : kBedTestLayouts) {
+    const int numChannels = outputLayout.layout.getNumChannels();
+    juce::AudioBuffer<float> rendered(numChannels, kNumSamples);
+    juce::AudioBuffer<float> tabled(numChannels, kNumSamples);
+
+    for (const auto& position : kPositions) {
+      MonoToSpeakerPanner renderer(outputLayout.layout, kNumSamples, 48000,
+                                   MonoToSpeakerPanner::Mode::kRenderer);
+      MonoToSpeakerPanner table(outputLayout.layout, kNumSamples, 48000,
+                                MonoToSpeakerPanner::Mode::kGainTable);
+      if (table.getMode() != MonoToSpeakerPanner::Mode::kGainTable) {
+        // Not a BS.2051 layout, so both use the renderer
+        continue;
+      }
+
+      renderer.setPosition(position[0], position[1], position[2]);
+      table.setPosition(position[0], position[1], position[2]);
+      // Let the renderer settle on the position
+      for (int block = 0; block < 4; ++block) {
+        renderer.process(inputBuffer, rendered);
+      }
+      table.process(inputBuffer, tabled);
+
+      const int last = kNumSamples - 1;
+      for (int ch = 0; ch < numChannels; ++ch) {
+        EXPECT_NEAR(tabled.getSample(ch, last), rendered.getSample(ch, last),
+                    kInput * 0.05f)
+            << "channel " << ch << " of " << outputLayout.layout.toString();
+      }
+    }
+  }
+}
+
+// Position changes ramp from the previous block's gains
+TEST(test_surround_panner, gain_table_ramps) {
+  juce::AudioBuffer<float> inputBuffer(1, kNumSamples);
+  juce::AudioBuffer<float> outputBuffer(Speakers::kStereo.getNumChannels(),
+                                        kNumSamples);
+  for (int i = 0; i < kNumSamples; ++i) {
+    inputBuffer.setSample(0, i, 1.f);
+  }
+
+  MonoToSpeakerPanner panner(Speakers::kStereo, kNumSamples, 48000);
+  ASSERT_EQ(panner.getMode(), MonoToSpeakerPanner::Mode::kGainTable);
+
+  // Hard left, at full gain from the first sample
+  panner.setPosition(-45.f, 0.f, 0.f);
+  panner.process(inputBuffer, outputBuffer);
+  EXPECT_NEAR(outputBuffer.getSample(0, 0), 1.f, 1e-3f);
+  EXPECT_NEAR(outputBuffer.getSample(1, 0), 0.f, 1e-3f);
+
+  // Move hard right over the next block
+  panner.setPosition(45.f, 0.f, 0.f);
+  panner.process(inputBuffer, outputBuffer);
+  EXPECT_NEAR(outputBuffer.getSample(0, 0), 1.f, 1e-3f);
+  EXPECT_NEAR(outputBuffer.getSample(0, kNumSamples - 1), 0.f, 1e-2f);
+  EXPECT_NEAR(outputBuffer.getSample(1, kNumSamples - 1), 1.f, 1e-2f);
+  for (int i = 1; i < kNumSamples; ++i) {
+    EXPECT_LE(outputBuffer.getSample(0, i), outputBuffer.getSample(0, i - 1));
+  }
+}
+
 // Test panning to binaural
 TEST(test_surround_panner, pan_to_binaural) {
   // Construct juce I/O buffers.
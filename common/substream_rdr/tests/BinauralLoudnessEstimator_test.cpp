@@ -0,0 +1,92 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "substream_rdr/bin_rdr/BinauralLoudnessEstimator.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "substream_rdr/rdr_factory/RendererFactory.h"
+
+namespace {
+constexpr int kSampleRate = 48000;
+constexpr int kBlockSize = 1024;
+constexpr int kNumBlocks = 64;
+
+// Render gains * white noise per channel through the full binaural renderer
+// and the estimator, and return the level difference at each ear in dB. The
+// noise is shared by every channel when coherent, independent otherwise.
+std::array<float, 2> estimateError(
+    const Speakers::AudioElementSpeakerLayout layout,
+    const std::vector<float>& gains, const bool coherent) {
+  auto estimator = BinauralLoudnessEstimator::getShared(layout, kSampleRate);
+  auto renderer =
+      createRenderer(layout, Speakers::kBinaural, kBlockSize, kSampleRate);
+  EXPECT_NE(estimator, nullptr);
+  EXPECT_NE(renderer, nullptr);
+
+  juce::Random random(42);
+  juce::AudioBuffer<float> input(layout.getNumChannels(), kBlockSize);
+  juce::AudioBuffer<float> output(2, kBlockSize);
+  std::array<double, 2> rendered = {0.0, 0.0};
+  std::array<double, 2> estimated = {0.0, 0.0};
+  for (int block = 0; block < kNumBlocks; ++block) {
+    input.clear();
+    for (int i = 0; i < kBlockSize; ++i) {
+      const float shared = random.nextFloat() * 2.f - 1.f;
+      for (int ch = 0; ch < (int)gains.size(); ++ch) {
+        const float noise =
+            coherent ? shared : random.nextFloat() * 2.f - 1.f;
+        input.setSample(ch, i, gains[ch] * noise);
+      }
+    }
+    output.clear();
+    renderer->render(input, output);
+
+    const std::array<float, 2> meanSquares = estimator->estimate(input);
+    for (int ear = 0; ear < 2; ++ear) {
+      const float rms = output.getRMSLevel(ear, 0, kBlockSize);
+      rendered[ear] += rms * rms;
+      estimated[ear] += meanSquares[ear];
+    }
+  }
+
+  return {(float)(10.0 * std::log10(estimated[0] / rendered[0])),
+          (float)(10.0 * std::log10(estimated[1] / rendered[1]))};
+}
+}  // namespace
+
+TEST(test_binaural_loudness_estimator, uncorrelated_speakers) {
+  const std::vector<float> gains(Speakers::k7Point1Point4.getNumChannels(),
+                                 0.25f);
+  const std::array<float, 2> error =
+      estimateError(Speakers::k7Point1Point4, gains, false);
+  EXPECT_NEAR(error[0], 0.f, 0.5f);
+  EXPECT_NEAR(error[1], 0.f, 0.5f);
+}
+
+TEST(test_binaural_loudness_estimator, coherent_ambisonics) {
+  // A plane wave from the left, ACN/SN3D: W and Y only.
+  const std::array<float, 2> error =
+      estimateError(Speakers::kHOA1, {0.5f, 0.5f, 0.f, 0.f}, true);
+  EXPECT_NEAR(error[0], 0.f, 0.5f);
+  EXPECT_NEAR(error[1], 0.f, 0.5f);
+}
+
+TEST(test_binaural_loudness_estimator, unsupported_layout) {
+  EXPECT_EQ(BinauralLoudnessEstimator::getShared(Speakers::kUnknown,
+                                                 kSampleRate),
+            nullptr);
+}
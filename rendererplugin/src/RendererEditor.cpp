@@ -64,9 +64,11 @@ RendererEditor::RendererEditor(RendererProcessor& p)
     : MainEditor(p),
       dawWarningBanner_(&p.getRoomSetupRepository()),
       monitorScreen_(p.getRepositories(), p.getSpeakerMonitorData(),
-                     p.getChannelMonitorData(), *this,
+                     p.getLoudnessTimeline(), p.getChannelMonitorData(), *this,
                      p.getMainBusNumInputChannels()),
-      currentScreen_(&monitorScreen_) {
+      currentScreen_(&monitorScreen_),
+      speakerMonitorConsumer_(p.getSpeakerMonitorData().consumers),
+      channelMonitorConsumer_(p.getChannelMonitorData().consumers) {
   setResizable(true, true);
 
   // Get screen dimensions and calculate appropriate size
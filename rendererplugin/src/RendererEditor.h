@@ -52,6 +52,9 @@ class RendererEditor final : public MainEditor {
   DAWWarningBanner dawWarningBanner_;
   MonitorScreen monitorScreen_;
   juce::Component* currentScreen_;
+  // Keep the monitoring processors measuring while the editor is open.
+  MeteringConsumers::Registration speakerMonitorConsumer_;
+  MeteringConsumers::Registration channelMonitorConsumer_;
 
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RendererEditor)
 };
@@ -17,23 +17,28 @@
 #pragma once
 
 #include <algorithm>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 
 #include "data_repository/implementation/AudioElementRepository.h"
 #include "data_repository/implementation/AudioElementSpatialLayoutRepository.h"
 #include "data_repository/repository_base/RepositoryBase.h"
+#include "data_structures/src/AudioElementPluginHub.h"
 #include "data_structures/src/AudioElementSpatialLayout.h"
 #include "data_structures/src/RepositoryItem.h"
+#include "data_structures/src/RepositorySync.h"
 #include "substream_rdr/substream_rdr_utils/Speakers.h"
 
 class AudioElementPluginConnection;
 
 class SyncServer {
  public:
-  virtual void repositoryUpdated(
-      AudioElementPluginConnection* updatedAudioElementPlugin) = 0;
+  virtual void repositoryUpdated(AudioElementSpatialLayout& updatedPlugin) = 0;
+  virtual void pluginRemoved(AudioElementSpatialLayout& removedPlugin) = 0;
   virtual void connectionLost(AudioElementPluginConnection* connection) = 0;
+  virtual void snapshotRequested(AudioElementPluginConnection* connection) = 0;
 };
 
 class AudioElementPluginUpdateListener {
@@ -47,68 +52,125 @@ class AudioElementPluginUpdateListener {
 /* ================
 AudioElementPlugin Connection class for maintaining information about
 connections to Audio Element Plugins
+
+Each connection comes from the AudioElementPluginHub of one plugin process
+and carries the repositories of all Audio Element Plugins in that process,
+one channel each
 ==================*/
 class AudioElementPluginConnection : public juce::InterprocessConnection {
  private:
-  AudioElementSpatialLayoutRepository sharedRepository_;
+  // The repository of one Audio Element Plugin
+  struct Channel {
+    AudioElementSpatialLayoutRepository sharedRepository;
+    RepositorySync::Receiver receiver;
+    bool initialized = false;
+
+    AudioElementSpatialLayout getInfo() const {
+      const AudioElementSpatialLayout layout = sharedRepository.get();
+      return AudioElementSpatialLayout(layout.getId(), layout.getName(),
+                                       layout.getAudioElementId(), 0,
+                                       Speakers::kMono);
+    }
+  };
+
+  std::map<uint32_t, std::unique_ptr<Channel>> channels_;
   juce::CriticalSection repositoryLock_;  // Use lock to prevent read/write
-                                          // conflicts on the repository
+                                          // conflicts on the repositories
   SyncServer* managingServer_;
-  bool initialized_;
+  // Patches are only sent once the plugins have been given a snapshot to
+  // apply them to.
+  bool snapshotSent_;
 
  public:
   AudioElementPluginConnection(SyncServer* managingServerInstance)
-      : sharedRepository_(),
-        managingServer_(managingServerInstance),
-        initialized_(false) {}
+      : managingServer_(managingServerInstance), snapshotSent_(false) {}
 
   ~AudioElementPluginConnection() override { disconnect(30000); }
 
-  juce::Uuid getId() const {
+  // Every Audio Element Plugin that has registered over this connection
+  std::vector<AudioElementSpatialLayout> getPlugins() const {
     const juce::ScopedLock lock(repositoryLock_);
-    if (initialized_) {
-      return sharedRepository_.get().getId();
-    } else {
-      return juce::Uuid("");
+    std::vector<AudioElementSpatialLayout> plugins;
+    for (const auto& [id, channel] : channels_) {
+      if (channel->initialized) {
+        plugins.push_back(channel->getInfo());
+      }
     }
+    return plugins;
   }
 
-  juce::Uuid getAudioElementId() const {
-    const juce::ScopedLock lock(repositoryLock_);
-    if (initialized_) {
-      return sharedRepository_.get().getAudioElementId();
-    } else {
-      return juce::Uuid("");
-    }
+  void sendSnapshot(const juce::MemoryBlock& snapshot) {
+    snapshotSent_ = true;
+    send(AudioElementPluginHub::kRendererChannel, snapshot);
   }
 
-  juce::String getName() const {
-    const juce::ScopedLock lock(repositoryLock_);
-
-    if (initialized_) {
-      return sharedRepository_.get().getName();
-    } else {
-      return "";
+  void sendPatch(const juce::MemoryBlock& patch) {
+    if (snapshotSent_) {
+      send(AudioElementPluginHub::kRendererChannel, patch);
     }
   }
 
-  void sendRepository(juce::MemoryBlock& block) { sendMessage(block); }
-
-  void connectionMade() override {}
+  void connectionMade() override { managingServer_->snapshotRequested(this); }
 
   void connectionLost() override { managingServer_->connectionLost(this); }
 
   void messageReceived(const juce::MemoryBlock& message) override {
-    juce::MemoryInputStream stream(message, false);
-    juce::ValueTree repository = juce::ValueTree::readFromStream(stream);
+    RepositorySync::readBundle(
+        message, [this](const uint32_t id, const juce::MemoryBlock& part) {
+          channelMessageReceived(id, part);
+        });
+  }
+
+ private:
+  void send(const uint32_t id, const juce::MemoryBlock& message) {
+    RepositorySync::Bundle bundle;
+    bundle.add(id, message);
+    sendMessage(bundle.getData());
+  }
+
+  void channelMessageReceived(const uint32_t id,
+                              const juce::MemoryBlock& message) {
+    if (id == AudioElementPluginHub::kRendererChannel) {
+      if (RepositorySync::isResyncRequest(message)) {
+        managingServer_->snapshotRequested(this);
+      }
+      return;
+    }
 
     // Lock before we write to ensure no conflicts
     const juce::ScopedLock lock(repositoryLock_);
-    sharedRepository_.setStateTree(repository);
-    initialized_ = true;
+    if (RepositorySync::isChannelClosed(message)) {
+      auto found = channels_.find(id);
+      if (found != channels_.end()) {
+        std::unique_ptr<Channel> closed = std::move(found->second);
+        channels_.erase(found);
+        if (closed->initialized) {
+          AudioElementSpatialLayout info = closed->getInfo();
+          managingServer_->pluginRemoved(info);
+        }
+      }
+      return;
+    }
+
+    std::unique_ptr<Channel>& channel = channels_[id];
+    if (channel == nullptr) {
+      channel = std::make_unique<Channel>();
+    }
+    juce::ValueTree repository = channel->sharedRepository.getTree();
+    const RepositorySync::Receiver::Result result =
+        channel->receiver.apply(message, repository);
+    if (result == RepositorySync::Receiver::Result::kResyncRequired) {
+      send(id, RepositorySync::createResyncRequest());
+    }
+    if (result != RepositorySync::Receiver::Result::kApplied) {
+      return;
+    }
+    channel->sharedRepository.setStateTree(repository);
+    channel->initialized = true;
 
     // Finally, notify the managing server
-    managingServer_->repositoryUpdated(this);
+    AudioElementSpatialLayout info = channel->getInfo();
+    managingServer_->repositoryUpdated(info);
   }
 };
 
@@ -122,6 +184,7 @@ type error during compilation.
 ==================*/
 class RendererPluginSyncServer : public juce::InterprocessConnectionServer,
                                  juce::ValueTree::Listener,
+                                 juce::AsyncUpdater,
                                  SyncServer {
  private:
   AudioElementRepository*
@@ -132,6 +195,8 @@ class RendererPluginSyncServer : public juce::InterprocessConnectionServer,
       connections_;  // All currently registered AudioElementPlugins
   juce::CriticalSection
       repositoryLock_;  // Use lock to prevent writing from multiple threads
+  RepositorySync::Sender
+      sender_;  // Tracks what the Audio Element Plugins have been sent
   AudioElementPluginUpdateListener* listener_;
   int connectionPort;
 
@@ -174,6 +239,7 @@ class RendererPluginSyncServer : public juce::InterprocessConnectionServer,
   }
 
   ~RendererPluginSyncServer() override {
+    cancelPendingUpdate();
     for (auto connection : connections_) {
       connection->disconnect();
       delete connection;
@@ -198,29 +264,30 @@ class RendererPluginSyncServer : public juce::InterprocessConnectionServer,
   // This callback is called each time a connection is disconnected
   // and is used to remove the connection from the list of tracked connections
   void connectionLost(AudioElementPluginConnection* connection) override {
-    AudioElementSpatialLayout audioElementSpatialLayoutInfo =
-        AudioElementSpatialLayout(connection->getId(), connection->getName(),
-                                  connection->getAudioElementId(), 0,
-                                  Speakers::kMono);
-    listener_->removeAudioElementPlugin(audioElementSpatialLayoutInfo);
+    // Every plugin in the process on the other end has gone
+    for (AudioElementSpatialLayout& plugin : connection->getPlugins()) {
+      listener_->removeAudioElementPlugin(plugin);
+    }
     connections_.erase(
         std::remove(connections_.begin(), connections_.end(), connection),
         connections_.end());
     delete connection;
   }
 
+  // Changes are sent from the message thread once the current burst of edits
+  // has been made, so a burst costs a single patch
   void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged,
                                 const juce::Identifier& property) override {
     juce::ignoreUnused(treeWhosePropertyHasChanged);
     juce::ignoreUnused(property);
-    updateClients();
+    triggerAsyncUpdate();
   }
 
   void valueTreeChildAdded(juce::ValueTree& parentTree,
                            juce::ValueTree& childWhichHasBeenAdded) override {
     juce::ignoreUnused(parentTree);
     juce::ignoreUnused(childWhichHasBeenAdded);
-    updateClients();
+    triggerAsyncUpdate();
   }
 
   void valueTreeChildRemoved(juce::ValueTree& parentTree,
@@ -229,35 +296,48 @@ class RendererPluginSyncServer : public juce::InterprocessConnectionServer,
     juce::ignoreUnused(parentTree);
     juce::ignoreUnused(childWhichHasBeenRemoved);
     juce::ignoreUnused(indexFromWhichChildWasRemoved);
-    updateClients();
+    triggerAsyncUpdate();
   }
 
+  void handleAsyncUpdate() override { updateClients(); }
+
+  // Send everything that changed since the last update to all clients
   void updateClients() {
     // Prevent update clients from being called from
     // multiple threads simultaneuously
     juce::ScopedLock lock(repositoryLock_);
 
-    juce::MemoryBlock block;
-    juce::MemoryOutputStream stream(block, false);
-    outgoingRepository_->writeToStream(stream);
+    // Restoring state replaces the repository's tree, so make sure we are
+    // still listening to the current one
+    outgoingRepository_->registerListener(this);
+
+    juce::MemoryBlock patch;
+    if (!sender_.createPatch(outgoingRepository_->getValueTree(), patch)) {
+      return;
+    }
     for (auto connection : connections_) {
-      connection->sendRepository(block);
+      connection->sendPatch(patch);
     }
   }
 
-  void repositoryUpdated(AudioElementPluginConnection* updatedPanner) override {
-    juce::ignoreUnused(updatedPanner);
-    // First, update the clients (thread safe, since this is a callback
-    // thread)
+  // Called when a plugin connects, or has fallen out of step and needs the
+  // full repository again
+  void snapshotRequested(AudioElementPluginConnection* connection) override {
+    juce::ScopedLock lock(repositoryLock_);
+    // Bring everyone else up to date first so the snapshot is current
     updateClients();
+    connection->sendSnapshot(sender_.createSnapshot());
+  }
 
+  void repositoryUpdated(AudioElementSpatialLayout& updatedPlugin) override {
     // Need to callback here to something, probably the renderer plugin, to
     // indicate a repository has been updated
-    AudioElementSpatialLayout audioElementSpatialLayoutInfo =
-        AudioElementSpatialLayout(
-            updatedPanner->getId(), updatedPanner->getName(),
-            updatedPanner->getAudioElementId(), 0, Speakers::kMono);
-    listener_->updateAudioElementPluginInformation(
-        audioElementSpatialLayoutInfo);
+    listener_->updateAudioElementPluginInformation(updatedPlugin);
+  }
+
+  // An Audio Element Plugin has been removed while others in its process
+  // remain connected
+  void pluginRemoved(AudioElementSpatialLayout& removedPlugin) override {
+    listener_->removeAudioElementPlugin(removedPlugin);
   }
 };
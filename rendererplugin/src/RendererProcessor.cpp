@@ -90,7 +90,7 @@ RendererProcessor::RendererProcessor()
       fileExportRepository_, roomSetupRepository_));
   audioProcessors_.push_back(std::make_unique<MSProcessor>(getRepositories()));
   audioProcessors_.push_back(std::make_unique<MixMonitorProcessor>(
-      roomSetupRepository_, monitorData_));
+      roomSetupRepository_, monitorData_, loudnessTimeline_));
   audioProcessors_.push_back(std::make_unique<RemappingProcessor>(this, true));
   // Use host layout size for output channels configuration
   juce::AudioChannelSet outputChannels;
@@ -104,6 +104,7 @@ RendererProcessor::RendererProcessor()
 }
 
 RendererProcessor::~RendererProcessor() {
+  cancelPendingUpdate();
   audioProcessors_.clear();
   fileExportRepository_.deregisterListener(this);
   roomSetupRepository_.deregisterListener(this);
@@ -222,6 +223,20 @@ void RendererProcessor::processBlock(juce::AudioBuffer<float>& buffer,
   for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
     buffer.clear(i, 0, buffer.getNumSamples());
 
+  // When the host buffer has exactly the channels and samples of the
+  // processing buffer, and every channel is both an input and a writable
+  // output, process it in place.
+  const int numProcessingChannels = processingBuffer_.getNumChannels();
+  if (buffer.getNumChannels() == numProcessingChannels &&
+      buffer.getNumSamples() == processingBuffer_.getNumSamples() &&
+      totalNumInputChannels >= numProcessingChannels &&
+      totalNumOutputChannels >= numProcessingChannels) {
+    for (const auto& proc : audioProcessors_) {
+      proc->processBlock(buffer, midiMessages);
+    }
+    return;
+  }
+
   // Copy the input buffer into the processing buffer
   // We do this since we may want to modify audio element audio or render
   // to more channels than are available on output. ProTools makes channels
@@ -444,6 +459,11 @@ void RendererProcessor::valueTreePropertyChanged(
     const juce::Identifier& property) {
   if (property == FileExport::kManualExport) {
     checkManualOfflineStartStop();
+  } else if (property == FileExport::kExportCompleted &&
+             (bool)treeWhosePropertyHasChanged[property]) {
+    // Exports complete on the host's thread or, after muxing, on the message
+    // thread. The timeline may only be read on the message thread.
+    triggerAsyncUpdate();
   } else if (treeWhosePropertyHasChanged.getType() == RoomSetup::kTreeType &&
              property == RoomSetup::kSpeakerLayout) {
     configureOutputBus();
@@ -453,6 +473,19 @@ void RendererProcessor::valueTreePropertyChanged(
     LOG_ANALYTICS(instanceId_, mainBusInfo);
   }
 }
+void RendererProcessor::handleAsyncUpdate() {
+  // The loudness report goes next to the export stats report
+  const FileExport kConfig = fileExportRepository_.get();
+  if (!kConfig.getExportAudio() || kConfig.getExportFile().isEmpty()) {
+    return;
+  }
+  loudnessTimeline_.drain();
+  if (!loudnessTimeline_.writeReport(
+          FileExport::expandTildePath(kConfig.getExportFile()))) {
+    LOG_WARNING(instanceId_, "Failed to write the loudness report.");
+  }
+}
+
 void RendererProcessor::valueTreeChildAdded(
     juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenAdded) {
   checkManualOfflineStartStop();
@@ -29,13 +29,15 @@
 #include "data_repository/implementation/RoomSetupRepository.h"
 #include "data_structures/src/AudioElementCommunication.h"
 #include "data_structures/src/ChannelMonitorData.h"
+#include "data_structures/src/LoudnessTimeline.h"
 #include "data_structures/src/RepositoryCollection.h"
 #include "processors/processor_base/ProcessorBase.h"
 
 //==============================================================================
 class RendererProcessor final : public ProcessorBase,
                                 public AudioElementPluginUpdateListener,
-                                public juce::ValueTree::Listener {
+                                public juce::ValueTree::Listener,
+                                private juce::AsyncUpdater {
  public:
   //==============================================================================
   RendererProcessor();
@@ -97,6 +99,7 @@ class RendererProcessor final : public ProcessorBase,
 
   RoomSetupRepository& getRoomSetupRepository() { return roomSetupRepository_; }
   SpeakerMonitorData& getSpeakerMonitorData() { return monitorData_; }
+  LoudnessTimeline& getLoudnessTimeline() { return loudnessTimeline_; }
   ChannelMonitorData& getChannelMonitorData() { return channelMonitorData_; }
 
   void updateAudioElementPluginInformation(
@@ -118,6 +121,9 @@ class RendererProcessor final : public ProcessorBase,
 
   juce::ValueTree getTreeWithId(const juce::Identifier& id);
 
+  // Writes the loudness report of a completed export, on the message thread.
+  void handleAsyncUpdate() override;
+
   std::vector<std::unique_ptr<ProcessorBase>> audioProcessors_;
 
   juce::AudioBuffer<float> processingBuffer_;
@@ -169,6 +175,9 @@ class RendererProcessor final : public ProcessorBase,
   inline static const juce::Identifier kFilePlaybackKey{"file_playback"};
 
   SpeakerMonitorData monitorData_;
+  // Loudness history of the playback mix. Only the renderer keeps one, the
+  // element plugins have no use for it.
+  LoudnessTimeline loudnessTimeline_;
 
   ChannelMonitorData channelMonitorData_;
 
@@ -20,6 +20,7 @@
 #include "data_structures/src/FileExport.h"
 #include "data_structures/src/MixPresentation.h"
 #include "data_structures/src/TimeFormatConverter.h"
+#include "processors/file_output/FileExportJobQueue.h"
 
 FileExportScreen::FileExportScreen(MainEditor& editor,
                                    RepositoryCollection repos)
@@ -184,17 +185,16 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
                                      folderImage, 0.8f, juce::Colours::white);
 
   // Add the format options
+  // Options are in AudioFileFormat order
   formatSelector_.addOption("IAMF");
   formatSelector_.addOption("WAV");
-  formatSelector_.setOption(
-      config.getAudioFileFormat() == AudioFileFormat::IAMF ? "IAMF" : "WAV");
+  formatSelector_.addOption("ADM BWF");
+  formatSelector_.setSelectedIndex((int)config.getAudioFileFormat(),
+                                   juce::NotificationType::dontSendNotification);
   formatSelector_.onChange([this] {
     FileExport config = repository_->get();
-    if (formatSelector_.getSelectedIndex() == 0) {
-      config.setAudioFileFormat(AudioFileFormat::IAMF);
-    } else {
-      config.setAudioFileFormat(AudioFileFormat::WAV);
-    }
+    config.setAudioFileFormat(
+        (AudioFileFormat)formatSelector_.getSelectedIndex());
     repository_->update(config);
   });
 
@@ -531,6 +531,25 @@ FileExportScreen::FileExportScreen(MainEditor& editor,
   addAndMakeVisible(warningLabel_);
   warningLabel_.setColour(juce::Label::ColourIds::textColourId,
                           EclipsaColours::red);
+
+  exportSummaryLabel_.setFont(juce::Font("Roboto", 12.0f, juce::Font::plain));
+  exportSummaryLabel_.setColour(juce::Label::ColourIds::textColourId,
+                                EclipsaColours::tabTextGrey);
+  addAndMakeVisible(exportSummaryLabel_);
+
+  addChildComponent(muxProgressBar_);
+  cancelMuxButton_.setButtonText("Cancel");
+  cancelMuxButton_.onClick = [this] {
+    // Returns once the running job has stopped
+    FileExportJobQueue::getInstance().cancel(repository_->getTree());
+    FileExport config = repository_->get();
+    config.setExportCancelled(true);
+    config.setMuxProgress(1.f);
+    config.setExportSummary("Video mux cancelled");
+    config.setExportCompleted(true);
+    repository_->update(config);
+  };
+  addChildComponent(cancelMuxButton_);
   refreshFileExportComponents();
 }
 
@@ -759,6 +778,17 @@ void FileExportScreen::paint(juce::Graphics& g) {
 #endif
   }
 
+  // Throughput of the last export
+  rightSideBounds.removeFromTop(10);
+  exportSummaryLabel_.setBounds(rightSideBounds.removeFromTop(20));
+
+  // Progress of the video mux
+  rightSideBounds.removeFromTop(10);
+  row = rightSideBounds.removeFromTop(25);
+  muxProgressBar_.setBounds(row.removeFromLeft(componentWidth));
+  row.removeFromLeft(10);
+  cancelMuxButton_.setBounds(row.removeFromLeft(75));
+
   /* ==============================================
    *  Draw in the Export Validation content
    * ==============================================
@@ -964,6 +994,16 @@ void FileExportScreen::valueTreePropertyChanged(
     const juce::Identifier& property) {
   if (treeWhosePropertyHasChanged.getType() ==
       repository_->getTree().getType()) {
+    if (!juce::MessageManager::getInstance()->isThisTheMessageThread()) {
+      // Hosts start and end exports from their own threads
+      auto safeThis = juce::Component::SafePointer<FileExportScreen>(this);
+      juce::MessageManager::callAsync([safeThis]() {
+        if (safeThis != nullptr) {
+          safeThis->refreshFileExportComponents();
+        }
+      });
+      return;
+    }
     refreshFileExportComponents();
   } else {
     refreshComponents();
@@ -1023,10 +1063,40 @@ void FileExportScreen::refreshFileExportComponents() {
                             EclipsaColours::green);
   }
 
+  exportSummaryLabel_.setText(config.getExportSummary(),
+                              juce::NotificationType::dontSendNotification);
+
+  // The mux runs in the background after the bounce
+  const bool kMuxing =
+      !config.getExportCompleted() && config.getMuxProgress() < 1.f;
+  muxProgress_ = config.getMuxProgress();
+  muxProgressBar_.setVisible(kMuxing);
+  cancelMuxButton_.setVisible(kMuxing);
+
+  // Audio lost because the disk could not keep up with the last WAV export
+  if (config.getDroppedSamples() > 0 && config.getSampleRate() > 0) {
+    warningLabel_.setVisible(true);
+    warningLabel_.setText(
+        "Disk too slow: " +
+            juce::String((double)config.getDroppedSamples() /
+                             config.getSampleRate(),
+                         2) +
+            " s of audio was not exported",
+        juce::NotificationType::dontSendNotification);
+    droppedSamplesWarning_ = true;
+  } else if (droppedSamplesWarning_) {
+    // A later export kept up, so the warning no longer applies
+    warningLabel_.setVisible(false);
+    droppedSamplesWarning_ = false;
+  }
+
   repaint();
 }
 
 bool FileExportScreen::validFileExportConfig(const FileExport& config) {
+  // Validation errors replace any dropped samples warning
+  droppedSamplesWarning_ = false;
+
   // Check if the export file is valid
   if (config.getExportFile().isEmpty()) {
     warningLabel_.setVisible(true);
@@ -149,4 +149,13 @@ class FileExportScreen : public juce::Component,
   // Manual export button -- To be removed later
   juce::TextButton exportButton_;
   juce::Label warningLabel_;
+  // Whether warningLabel_ holds the dropped samples warning rather than a
+  // validation error
+  bool droppedSamplesWarning_ = false;
+  // Throughput of the last export
+  juce::Label exportSummaryLabel_;
+  // Progress of the post-bounce video mux, which the user may cancel
+  double muxProgress_ = 0.0;
+  juce::ProgressBar muxProgressBar_{muxProgress_};
+  juce::TextButton cancelMuxButton_;
 };
\ No newline at end of file
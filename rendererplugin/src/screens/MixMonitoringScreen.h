@@ -24,8 +24,9 @@
 
 class MixMonitoringScreen : public juce::Component, juce::ValueTree::Listener {
  public:
-  MixMonitoringScreen(RepositoryCollection repos, SpeakerMonitorData& data)
-      : repos_(repos), rtData_(data), stats_(data) {
+  MixMonitoringScreen(RepositoryCollection repos, SpeakerMonitorData& data,
+                      const LoudnessTimeline& timeline)
+      : repos_(repos), rtData_(data), stats_(data), history_(timeline) {
     // Configure component as a listener to the room repo for playback layout.
     repos_.roomSetupRepo_.registerListener(this);
     repos_.playbackMSRepo_.registerListener(this);
@@ -47,6 +48,7 @@ class MixMonitoringScreen : public juce::Component, juce::ValueTree::Listener {
     addAndMakeVisible(leftScale_);
     addAndMakeVisible(hmeter_);
     addAndMakeVisible(stats_);
+    addAndMakeVisible(history_);
   }
 
   ~MixMonitoringScreen() {
@@ -136,9 +138,13 @@ class MixMonitoringScreen : public juce::Component, juce::ValueTree::Listener {
     }
     rightScale_.setBounds(meterScaleBounds);
 
-    // Draw loudness stats.
+    // Draw loudness stats, with their history below.
     auto statsBounds = bounds;
+    auto historyBounds =
+        statsBounds.removeFromBottom(boundsRef.getHeight() * 0.25f);
+    historyBounds.removeFromTop(kMeterOffset);
     stats_.setBounds(statsBounds);
+    history_.setBounds(historyBounds);
   };
 
   // Update playback layout on change and repaint.
@@ -190,4 +196,5 @@ class MixMonitoringScreen : public juce::Component, juce::ValueTree::Listener {
   LoudnessScale leftScale_;
   HeadphonesLoudnessMeter hmeter_;
   LoudnessStats stats_;
+  LoudnessHistoryGraph history_;
 };
\ No newline at end of file
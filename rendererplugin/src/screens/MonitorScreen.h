@@ -31,13 +31,14 @@ class MonitorScreen : public juce::Component {
 
  public:
   MonitorScreen(RepositoryCollection repos, SpeakerMonitorData& data,
+                const LoudnessTimeline& loudnessTimeline,
                 ChannelMonitorData& channelMonitorData, MainEditor& editor,
                 int totalChannelCount)
       : repos_(repos),
         presentationMonitorScreen_(editor, repos_, channelMonitorData,
                                    totalChannelCount),
         roomMonitoringScreen_(repos_, data, editor),
-        mixMonitoringScreen_(repos_, data) {}
+        mixMonitoringScreen_(repos_, data, loudnessTimeline) {}
 
   void paint(juce::Graphics& g) {
     auto bounds = getLocalBounds();